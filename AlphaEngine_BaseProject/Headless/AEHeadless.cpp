@@ -0,0 +1,654 @@
+/**
+ * @file	AEHeadless.cpp
+ * @brief	AlphaEngine implementation for headless builds.
+ *
+ *			Implements every AE_API function so the game sources link without
+ *			Alpha_Engine.dll. Maths functions behave like the real engine,
+ *			graphics / audio functions only track the resources handed out and
+ *			input / timing are driven through the AEHeadless namespace.
+ */
+#include "AEHeadless.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace
+{
+	constexpr int KEY_COUNT = 256;
+
+	f64 frameTime = 1.0 / 120.0;
+	f64 elapsedTime = 0.0;
+	u32 frameCount = 0;
+
+	std::mt19937 rng{ 0 };
+
+	u8 keysNext[KEY_COUNT] = {};
+	u8 keysCurr[KEY_COUNT] = {};
+	u8 keysPrev[KEY_COUNT] = {};
+	s32 cursorX = 0, cursorY = 0;
+	s32 prevCursorX = 0, prevCursorY = 0;
+
+	s32 windowWidth = 1600;
+	s32 windowHeight = 900;
+	f32 camX = 0.f, camY = 0.f;
+
+	u32 meshVertexCount = 0;
+	u32 liveMeshes = 0;
+	u32 liveTextures = 0;
+	u32 drawCount = 0;
+	u32 meshCreateCount = 0;
+	s8 nextFontId = 0;
+
+	// Handles only need to be non-null and distinct from "invalid"
+	char audioHandle = 0;
+}
+
+// ===========================================================================
+// Headless controls
+// ===========================================================================
+
+namespace AEHeadless
+{
+	void SetFrameTime(f64 dt) { frameTime = dt; }
+	f64 GetFrameTime() { return frameTime; }
+	void SetRandomSeed(u32 seed) { rng.seed(seed); }
+
+	void SetKey(u8 key, bool isDown) { keysNext[key] = isDown ? 1 : 0; }
+	void ReleaseAllKeys() { std::memset(keysNext, 0, sizeof(keysNext)); }
+
+	void SetCursorPosition(s32 x, s32 y)
+	{
+		cursorX = x;
+		cursorY = y;
+	}
+
+	u32 GetFrameDrawCount() { return drawCount; }
+	u32 GetFrameMeshCreateCount() { return meshCreateCount; }
+	u32 GetLiveMeshCount() { return liveMeshes; }
+	u32 GetLiveTextureCount() { return liveTextures; }
+}
+
+// ===========================================================================
+// System
+// ===========================================================================
+
+s32 AESysInit(HINSTANCE, s32, s32 WinWidth, s32 WinHeight, s32, u32, bool, LRESULT(CALLBACK*)(HWND, UINT, WPARAM, LPARAM))
+{
+	windowWidth = WinWidth;
+	windowHeight = WinHeight;
+	AEInputInit();
+	AEAudioInit();
+	return 1;
+}
+
+void AESysSetWindowIcon(const char*, s32, s32) {}
+void AESysReset() { AEInputReset(); }
+void AESysExit() { AEAudioExit(); }
+
+void AESysFrameStart()
+{
+	AEFrameRateControllerStart();
+	AEInputUpdate();
+	drawCount = 0;
+	meshCreateCount = 0;
+}
+
+void AESysFrameEnd() { AEFrameRateControllerEnd(); }
+
+s32 AESysIsFullScreen() { return 0; }
+s32 AESysIsFocus() { return 1; }
+void AESysSetFullScreen(s32) {}
+HWND AESysGetWindowHandle() { return nullptr; }
+void AESysSetWindowTitle(const char*) {}
+s32 AESysDoesWindowExist() { return 1; }
+
+// ===========================================================================
+// Frame rate controller
+// ===========================================================================
+
+void AEFrameRateControllerInit(u32 FrameRateMax)
+{
+	if (FrameRateMax > 0)
+		frameTime = 1.0 / FrameRateMax;
+	AEFrameRateControllerReset();
+}
+
+void AEFrameRateControllerReset()
+{
+	elapsedTime = 0.0;
+	frameCount = 0;
+}
+
+void AEFrameRateControllerStart() {}
+
+void AEFrameRateControllerEnd()
+{
+	elapsedTime += frameTime;
+	++frameCount;
+}
+
+f64 AEFrameRateControllerGetFrameTime() { return frameTime; }
+u32 AEFrameRateControllerGetFrameCount() { return frameCount; }
+f64 AEFrameRateControllerGetFrameRate() { return frameTime > 0.0 ? 1.0 / frameTime : 0.0; }
+
+// ===========================================================================
+// Util
+// ===========================================================================
+
+f64 AEGetTime(f64* pTime)
+{
+	if (pTime)
+		*pTime = elapsedTime;
+	return elapsedTime;
+}
+
+f32 AERandFloat()
+{
+	return std::uniform_real_distribution<f32>(0.f, 1.f)(rng);
+}
+
+s32 AEIsF32Zero(f32 x) { return fabsf(x) < FLT_EPSILON; }
+s32 AEIsF32Equal(f32 a, f32 b) { return fabsf(a - b) < FLT_EPSILON; }
+
+// ===========================================================================
+// Input
+// ===========================================================================
+
+s32 AEInputInit()
+{
+	AEInputReset();
+	return 1;
+}
+
+void AEInputReset()
+{
+	std::memset(keysCurr, 0, sizeof(keysCurr));
+	std::memset(keysPrev, 0, sizeof(keysPrev));
+}
+
+void AEInputUpdate()
+{
+	std::memcpy(keysPrev, keysCurr, sizeof(keysCurr));
+	std::memcpy(keysCurr, keysNext, sizeof(keysNext));
+	prevCursorX = cursorX;
+	prevCursorY = cursorY;
+}
+
+void AEInputExit() {}
+
+u8 AEInputCheckCurr(u8 key) { return keysCurr[key]; }
+u8 AEInputCheckPrev(u8 key) { return keysPrev[key]; }
+u8 AEInputCheckTriggered(u8 key) { return keysCurr[key] && !keysPrev[key]; }
+u8 AEInputCheckReleased(u8 key) { return !keysCurr[key] && keysPrev[key]; }
+
+void AEInputGetCursorPosition(s32* pX, s32* pY)
+{
+	if (pX) *pX = cursorX;
+	if (pY) *pY = cursorY;
+}
+
+void AEInputGetCursorPositionDelta(s32* pDeltaX, s32* pDeltaY)
+{
+	if (pDeltaX) *pDeltaX = cursorX - prevCursorX;
+	if (pDeltaY) *pDeltaY = cursorY - prevCursorY;
+}
+
+void AEInputShowCursor(s32) {}
+
+void AEInputMouseWheelDelta(s32* pDelta)
+{
+	if (pDelta) *pDelta = 0;
+}
+
+// ===========================================================================
+// Graphics
+// ===========================================================================
+
+s32 AEGfxInit(s32 Width, s32 Height)
+{
+	windowWidth = Width;
+	windowHeight = Height;
+	return 1;
+}
+
+void AEGfxSetVSync(s32) {}
+void AEGfxReset() {}
+void AEGfxExit() {}
+void AEGfxStart() {}
+void AEGfxEnd() {}
+void AEGfxSetBackgroundColor(f32, f32, f32) {}
+void AEGfxSetRenderMode(AEGfxRenderMode) {}
+void AEGfxSetBlendMode(AEGfxBlendMode) {}
+
+s32 AEGfxGetWindowWidth() { return windowWidth; }
+s32 AEGfxGetWindowHeight() { return windowHeight; }
+f32 AEGfxGetWinMinX(void) { return camX - windowWidth * 0.5f; }
+f32 AEGfxGetWinMaxX(void) { return camX + windowWidth * 0.5f; }
+f32 AEGfxGetWinMinY(void) { return camY - windowHeight * 0.5f; }
+f32 AEGfxGetWinMaxY(void) { return camY + windowHeight * 0.5f; }
+
+void AEGfxSetCamPosition(f32 X, f32 Y)
+{
+	camX = X;
+	camY = Y;
+}
+
+void AEGfxGetCamPosition(f32* pX, f32* pY)
+{
+	if (pX) *pX = camX;
+	if (pY) *pY = camY;
+}
+
+void AEGfxSetTransform(f32[3][3]) {}
+void AEGfxSetTransform3D(f32[4][4]) {}
+void AEGfxSetTransparency(f32) {}
+void AEGfxSetBlendColor(f32, f32, f32, f32) {}
+void AEGfxSetColorToMultiply(float, float, float, float) {}
+void AEGfxSetColorToAdd(float, float, float, float) {}
+
+void AEGfxMeshStart() { meshVertexCount = 0; }
+
+void AEGfxTriAdd(f32, f32, u32, f32, f32,
+				 f32, f32, u32, f32, f32,
+				 f32, f32, u32, f32, f32)
+{
+	meshVertexCount += 3;
+}
+
+void AEGfxVertexAdd(f32, f32, u32, f32, f32) { ++meshVertexCount; }
+
+AEGfxVertexList* AEGfxMeshEnd()
+{
+	++liveMeshes;
+	++meshCreateCount;
+	return new AEGfxVertexList{ nullptr, meshVertexCount };
+}
+
+void AEGfxMeshDraw(AEGfxVertexList* pVertexList, AEGfxMeshDrawMode)
+{
+	if (pVertexList)
+		++drawCount;
+}
+
+void AEGfxMeshFree(AEGfxVertexList* pVertexList)
+{
+	if (!pVertexList)
+		return;
+	--liveMeshes;
+	delete pVertexList;
+}
+
+AEGfxTexture* AEGfxTextureLoad(const char* pFileName)
+{
+	AEGfxTexture* texture = new AEGfxTexture{};
+	if (pFileName)
+		std::strncpy(texture->mpName, pFileName, sizeof(texture->mpName) - 1);
+	++liveTextures;
+	return texture;
+}
+
+void AEGfxTextureSet(AEGfxTexture*, f32, f32) {}
+
+void AEGfxTextureUnload(AEGfxTexture* pTexture)
+{
+	if (!pTexture)
+		return;
+	--liveTextures;
+	delete pTexture;
+}
+
+AEGfxTexture* AEGfxTextureLoadFromMemory(u8*, u32, u32) { return AEGfxTextureLoad(nullptr); }
+void AEGfxSaveTextureToFile(AEGfxTexture*, s8*) {}
+void AEGfxSetTextureMode(AEGfxTextureMode) {}
+
+u32 AEGfxColInterp(u32 c0, u32 c1, f32 t)
+{
+	u32 result = 0;
+	for (int shift = 0; shift < 32; shift += 8)
+	{
+		f32 a = (f32)((c0 >> shift) & 0xFF);
+		f32 b = (f32)((c1 >> shift) & 0xFF);
+		result |= ((u32)(a + (b - a) * t) & 0xFF) << shift;
+	}
+	return result;
+}
+
+s8 AEGfxCreateFont(const char*, int) { return nextFontId++; }
+void AEGfxPrint(s8, const char*, f32, f32, f32, f32, f32, f32, f32) {}
+
+void AEGfxGetPrintSize(s8, const char* pStr, f32 scale, f32* width, f32* height)
+{
+	// Rough monospace estimate in normalized screen units
+	const f32 len = pStr ? (f32)std::strlen(pStr) : 0.f;
+	if (width) *width = len * 0.02f * scale;
+	if (height) *height = 0.05f * scale;
+}
+
+void AEGfxDestroyFont(s8) {}
+void AEGfxFontSystemStart() {}
+void AEGfxFontSystemEnd() {}
+
+// ===========================================================================
+// Audio
+// ===========================================================================
+
+s32 AEAudioInit(void) { return 0; }
+void AEAudioUpdate(void) {}
+void AEAudioExit(void) {}
+s32 AEAudioIsValidAudio(AEAudio audio) { return audio.fmod_sound != nullptr; }
+s32 AEAudioIsValidGroup(AEAudioGroup group) { return group.fmod_group != nullptr; }
+
+AEAudioGroup AEAudioCreateGroup(void)
+{
+	return AEAudioGroup{ reinterpret_cast<FMOD_CHANNELGROUP*>(&audioHandle) };
+}
+
+AEAudio AEAudioLoadSound(const char*)
+{
+	return AEAudio{ reinterpret_cast<FMOD_SOUND*>(&audioHandle) };
+}
+
+AEAudio AEAudioLoadMusic(const char* filepath) { return AEAudioLoadSound(filepath); }
+void AEAudioPlay(AEAudio, AEAudioGroup, float, float, s32) {}
+void AEAudioResumeGroup(AEAudioGroup) {}
+void AEAudioStopGroup(AEAudioGroup) {}
+void AEAudioPauseGroup(AEAudioGroup) {}
+void AEAudioSetGroupVolume(AEAudioGroup, float) {}
+void AEAudioSetGroupPitch(AEAudioGroup, float) {}
+void AEAudioUnloadAudio(AEAudio) {}
+void AEAudioUnloadAudioGroup(AEAudioGroup) {}
+
+// ===========================================================================
+// Math
+// ===========================================================================
+
+f32 AEDegToRad(f32 x) { return x * PI / 180.f; }
+f32 AERadToDeg(f32 x) { return x * 180.f / PI; }
+f32 AESin(f32 x) { return sinf(x); }
+f32 AECos(f32 x) { return cosf(x); }
+f32 AETan(f32 x) { return tanf(x); }
+f32 AEASin(f32 x) { return asinf(x); }
+f32 AEACos(f32 x) { return acosf(x); }
+f32 AEATan(f32 x) { return atanf(x); }
+
+u32 AEIsPowOf2(u32 x) { return x && !(x & (x - 1)); }
+
+u32 AENextPowOf2(u32 x)
+{
+	u32 result = 1;
+	while (result < x)
+		result <<= 1;
+	return result;
+}
+
+u32 AELogBase2(u32 x)
+{
+	u32 result = 0;
+	while (x >>= 1)
+		++result;
+	return result;
+}
+
+f32 AEClamp(f32 X, f32 Min, f32 Max) { return X < Min ? Min : (X > Max ? Max : X); }
+
+f32 AEWrap(f32 x, f32 x0, f32 x1)
+{
+	const f32 range = x1 - x0;
+	return range == 0.f ? x0 : x - range * floorf((x - x0) / range);
+}
+
+f32 AEMin(f32 x, f32 y) { return x < y ? x : y; }
+f32 AEMax(f32 x, f32 y) { return x > y ? x : y; }
+s32 AEInRange(f32 x, f32 x0, f32 x1) { return x >= x0 && x <= x1; }
+
+s32 AEBuildLineSegment2(AELineSegment2* pLS, AEVec2* pPt0, AEVec2* pPt1)
+{
+	AEVec2 dir{ pPt1->x - pPt0->x, pPt1->y - pPt0->y };
+	if (AEVec2Length(&dir) < EPSILON)
+		return 0;
+
+	pLS->mP0 = *pPt0;
+	pLS->mP1 = *pPt1;
+	AEVec2 normal{ dir.y, -dir.x };
+	AEVec2Normalize(&pLS->mN, &normal);
+	pLS->mNdotP0 = AEVec2DotProduct(&pLS->mN, pPt0);
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+// AEVec2
+// ---------------------------------------------------------------------------
+
+void AEVec2Zero(AEVec2* pResult) { pResult->x = pResult->y = 0.f; }
+
+void AEVec2Set(AEVec2* pResult, f32 x, f32 y)
+{
+	pResult->x = x;
+	pResult->y = y;
+}
+
+void AEVec2Neg(AEVec2* pResult, AEVec2* pVec0) { AEVec2Set(pResult, -pVec0->x, -pVec0->y); }
+void AEVec2Add(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1) { AEVec2Set(pResult, pVec0->x + pVec1->x, pVec0->y + pVec1->y); }
+void AEVec2Sub(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1) { AEVec2Set(pResult, pVec0->x - pVec1->x, pVec0->y - pVec1->y); }
+
+void AEVec2Normalize(AEVec2* pResult, AEVec2* pVec0)
+{
+	const f32 len = AEVec2Length(pVec0);
+	if (len > 0.f)
+		AEVec2Set(pResult, pVec0->x / len, pVec0->y / len);
+	else
+		AEVec2Zero(pResult);
+}
+
+void AEVec2Scale(AEVec2* pResult, AEVec2* pVec0, f32 s) { AEVec2Set(pResult, pVec0->x * s, pVec0->y * s); }
+void AEVec2ScaleAdd(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1, f32 s) { AEVec2Set(pResult, pVec0->x * s + pVec1->x, pVec0->y * s + pVec1->y); }
+void AEVec2ScaleSub(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1, f32 s) { AEVec2Set(pResult, pVec0->x * s - pVec1->x, pVec0->y * s - pVec1->y); }
+
+void AEVec2Project(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1)
+{
+	const f32 lenSq = AEVec2SquareLength(pVec1);
+	const f32 t = lenSq > 0.f ? AEVec2DotProduct(pVec0, pVec1) / lenSq : 0.f;
+	AEVec2Scale(pResult, pVec1, t);
+}
+
+void AEVec2ProjectPerp(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1)
+{
+	AEVec2 projected;
+	AEVec2Project(&projected, pVec0, pVec1);
+	AEVec2Sub(pResult, pVec0, &projected);
+}
+
+void AEVec2Lerp(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1, f32 t)
+{
+	AEVec2Set(pResult, pVec0->x + (pVec1->x - pVec0->x) * t, pVec0->y + (pVec1->y - pVec0->y) * t);
+}
+
+f32 AEVec2Length(AEVec2* pVec0) { return sqrtf(AEVec2SquareLength(pVec0)); }
+f32 AEVec2SquareLength(AEVec2* pVec0) { return pVec0->x * pVec0->x + pVec0->y * pVec0->y; }
+f32 AEVec2Distance(AEVec2* pVec0, AEVec2* pVec1) { return sqrtf(AEVec2SquareDistance(pVec0, pVec1)); }
+
+f32 AEVec2SquareDistance(AEVec2* pVec0, AEVec2* pVec1)
+{
+	const f32 dx = pVec0->x - pVec1->x;
+	const f32 dy = pVec0->y - pVec1->y;
+	return dx * dx + dy * dy;
+}
+
+f32 AEVec2DotProduct(AEVec2* pVec0, AEVec2* pVec1) { return pVec0->x * pVec1->x + pVec0->y * pVec1->y; }
+f32 AEVec2CrossProductMag(AEVec2* pVec0, AEVec2* pVec1) { return pVec0->x * pVec1->y - pVec0->y * pVec1->x; }
+void AEVec2FromAngle(AEVec2* pResult, f32 angle) { AEVec2Set(pResult, cosf(angle), sinf(angle)); }
+
+// ---------------------------------------------------------------------------
+// AEMtx33
+// ---------------------------------------------------------------------------
+
+void AEMtx33Identity(AEMtx33* pResult)
+{
+	std::memset(pResult->m, 0, sizeof(pResult->m));
+	pResult->m[0][0] = pResult->m[1][1] = pResult->m[2][2] = 1.f;
+}
+
+void AEMtx33Transpose(AEMtx33* pResult, const AEMtx33* pMtx)
+{
+	AEMtx33 tmp;
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 3; ++c)
+			tmp.m[r][c] = pMtx->m[c][r];
+	*pResult = tmp;
+}
+
+f32 AEMtx33Determinant(const AEMtx33* pMtx)
+{
+	const auto& m = pMtx->m;
+	return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+		 - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+		 + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
+
+f32 AEMtx33Inverse(AEMtx33* pResult, const AEMtx33* pMtx)
+{
+	const f32 det = AEMtx33Determinant(pMtx);
+	if (fabsf(det) < EPSILON)
+		return 0.f;
+
+	const auto& m = pMtx->m;
+	const f32 invDet = 1.f / det;
+	AEMtx33 tmp;
+	tmp.m[0][0] =  (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * invDet;
+	tmp.m[0][1] = -(m[0][1] * m[2][2] - m[0][2] * m[2][1]) * invDet;
+	tmp.m[0][2] =  (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+	tmp.m[1][0] = -(m[1][0] * m[2][2] - m[1][2] * m[2][0]) * invDet;
+	tmp.m[1][1] =  (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+	tmp.m[1][2] = -(m[0][0] * m[1][2] - m[0][2] * m[1][0]) * invDet;
+	tmp.m[2][0] =  (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * invDet;
+	tmp.m[2][1] = -(m[0][0] * m[2][1] - m[0][1] * m[2][0]) * invDet;
+	tmp.m[2][2] =  (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * invDet;
+	*pResult = tmp;
+	return det;
+}
+
+void AEMtx33InvTranspose(AEMtx33* pResult, const AEMtx33* pMtx)
+{
+	AEMtx33Inverse(pResult, pMtx);
+	AEMtx33Transpose(pResult, pResult);
+}
+
+void AEMtx33Concat(AEMtx33* pResult, const AEMtx33* pMtx0, const AEMtx33* pMtx1)
+{
+	AEMtx33 tmp;
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 3; ++c)
+			tmp.m[r][c] = pMtx0->m[r][0] * pMtx1->m[0][c]
+						+ pMtx0->m[r][1] * pMtx1->m[1][c]
+						+ pMtx0->m[r][2] * pMtx1->m[2][c];
+	*pResult = tmp;
+}
+
+void AEMtx33Orthogonalize(AEMtx33* pResult, const AEMtx33* pMtx)
+{
+	// Gram-Schmidt on the first two columns, translation is kept
+	AEVec2 col0, col1;
+	AEMtx33GetCol(&col0, pMtx, 0);
+	AEMtx33GetCol(&col1, pMtx, 1);
+	AEVec2Normalize(&col0, &col0);
+	AEVec2 proj;
+	AEVec2Project(&proj, &col1, &col0);
+	AEVec2Sub(&col1, &col1, &proj);
+	AEVec2Normalize(&col1, &col1);
+
+	AEMtx33 tmp = *pMtx;
+	AEMtx33SetCol(&tmp, 0, &col0);
+	AEMtx33SetCol(&tmp, 1, &col1);
+	*pResult = tmp;
+}
+
+void AEMtx33SetCol(AEMtx33* pResult, u32 col, const AEVec2* pVec)
+{
+	pResult->m[0][col] = pVec->x;
+	pResult->m[1][col] = pVec->y;
+}
+
+void AEMtx33SetRow(AEMtx33* pResult, u32 row, const AEVec2* pVec)
+{
+	pResult->m[row][0] = pVec->x;
+	pResult->m[row][1] = pVec->y;
+}
+
+void AEMtx33GetCol(AEVec2* pResult, const AEMtx33* pMtx, u32 col)
+{
+	pResult->x = pMtx->m[0][col];
+	pResult->y = pMtx->m[1][col];
+}
+
+void AEMtx33GetRow(AEVec2* pResult, const AEMtx33* pMtx, u32 row)
+{
+	pResult->x = pMtx->m[row][0];
+	pResult->y = pMtx->m[row][1];
+}
+
+void AEMtx33Trans(AEMtx33* pResult, f32 x, f32 y)
+{
+	AEMtx33Identity(pResult);
+	pResult->m[0][2] = x;
+	pResult->m[1][2] = y;
+}
+
+void AEMtx33TransApply(AEMtx33* pResult, const AEMtx33* pMtx, f32 x, f32 y)
+{
+	AEMtx33 trans;
+	AEMtx33Trans(&trans, x, y);
+	AEMtx33Concat(pResult, &trans, pMtx);
+}
+
+void AEMtx33Scale(AEMtx33* pResult, f32 x, f32 y)
+{
+	AEMtx33Identity(pResult);
+	pResult->m[0][0] = x;
+	pResult->m[1][1] = y;
+}
+
+void AEMtx33ScaleApply(AEMtx33* pResult, const AEMtx33* pMtx, f32 x, f32 y)
+{
+	AEMtx33 scale;
+	AEMtx33Scale(&scale, x, y);
+	AEMtx33Concat(pResult, &scale, pMtx);
+}
+
+void AEMtx33Rot(AEMtx33* pResult, f32 angle)
+{
+	const f32 c = cosf(angle), s = sinf(angle);
+	AEMtx33Identity(pResult);
+	pResult->m[0][0] = c;
+	pResult->m[0][1] = -s;
+	pResult->m[1][0] = s;
+	pResult->m[1][1] = c;
+}
+
+void AEMtx33RotDeg(AEMtx33* pResult, f32 angle) { AEMtx33Rot(pResult, AEDegToRad(angle)); }
+
+void AEMtx33MultVec(AEVec2* pResult, const AEMtx33* pMtx, const AEVec2* pVec)
+{
+	const AEVec2 v = *pVec;
+	pResult->x = pMtx->m[0][0] * v.x + pMtx->m[0][1] * v.y + pMtx->m[0][2];
+	pResult->y = pMtx->m[1][0] * v.x + pMtx->m[1][1] * v.y + pMtx->m[1][2];
+}
+
+void AEMtx33MultVecArray(AEVec2* pResult, const AEMtx33* pMtx, const AEVec2* pVec, u32 count)
+{
+	for (u32 i = 0; i < count; ++i)
+		AEMtx33MultVec(pResult + i, pMtx, pVec + i);
+}
+
+void AEMtx33MultVecSR(AEVec2* pResult, const AEMtx33* pMtx, const AEVec2* pVec)
+{
+	const AEVec2 v = *pVec;
+	pResult->x = pMtx->m[0][0] * v.x + pMtx->m[0][1] * v.y;
+	pResult->y = pMtx->m[1][0] * v.x + pMtx->m[1][1] * v.y;
+}
+
+void AEMtx33MultVecArraySR(AEVec2* pResult, const AEMtx33* pMtx, const AEVec2* pVec, u32 count)
+{
+	for (u32 i = 0; i < count; ++i)
+		AEMtx33MultVecSR(pResult + i, pMtx, pVec + i);
+}
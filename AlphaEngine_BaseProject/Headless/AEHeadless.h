@@ -0,0 +1,54 @@
+#pragma once
+#include "AEEngine.h"
+
+/**
+ * @brief	Controls for the headless AlphaEngine backend (AEHeadless.cpp).
+ *
+ *			The headless backend implements the AlphaEngine API without a
+ *			window, GPU or audio device so the gameplay code can be stepped
+ *			on any platform. Rendering and audio calls are accepted and
+ *			discarded, input is fed by the caller and the frame rate
+ *			controller reports a fixed frame time.
+ */
+namespace AEHeadless
+{
+	/**
+	 * @brief	Sets the frame time returned by AEFrameRateControllerGetFrameTime.
+	 * @param	dt	Seconds per frame. Defaults to 1/120 (same cap as Main.cpp)
+	 */
+	void SetFrameTime(f64 dt);
+	f64 GetFrameTime();
+
+	/**
+	 * @brief	Sets the seed used by AERandFloat so runs are reproducible.
+	 */
+	void SetRandomSeed(u32 seed);
+
+	/**
+	 * @brief	Sets the state of a key for the next AEInputUpdate.
+	 *			Keys stay down until released.
+	 * @param	key		AEVK_* key code
+	 * @param	isDown	Whether the key is held
+	 */
+	void SetKey(u8 key, bool isDown);
+	void ReleaseAllKeys();
+
+	void SetCursorPosition(s32 x, s32 y);
+
+	/**
+	 * @brief	Number of AEGfxMeshDraw calls since the last AESysFrameStart.
+	 */
+	u32 GetFrameDrawCount();
+
+	/**
+	 * @brief	Number of AEGfxMeshEnd calls (meshes created) since the last AESysFrameStart.
+	 */
+	u32 GetFrameMeshCreateCount();
+
+	/**
+	 * @brief	Number of meshes and textures currently alive.
+	 *			Useful for spotting leaks when running many frames.
+	 */
+	u32 GetLiveMeshCount();
+	u32 GetLiveTextureCount();
+}
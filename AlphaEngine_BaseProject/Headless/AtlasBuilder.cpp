@@ -0,0 +1,376 @@
+/**
+ * @file	AtlasBuilder.cpp
+ * @brief	Packs textures into atlases for TextureAtlas.
+ *
+ *	Usage: AtlasBuilder [--force] <file.atlas.json | folder>...
+ *
+ *	Run from the folder containing Assets, image paths in the manifest are relative to it (same as the game).
+ *	Each <name>.atlas.json is packed into <name>.png with the UV lookup table in <name>.uv.json, next to the manifest.
+ *	Folders build every .atlas.json inside (not recursive).
+ *	Atlases are skipped if the manifest and images haven't changed (hash stored in the .uv.json) unless --force is passed.
+ *	Returns 1 if any atlas failed to build.
+ *
+ *	Manifest:
+ *	{
+ *		"maxSize": 256,		// Largest width / height of the atlas
+ *		"padding": 1,		// Pixels around each image, filled with its edge pixels so filtering doesn't bleed
+ *		"scale": 1.0,		// (optional) Resizes every image, e.g. 0.5 for art that's never drawn at full size
+ *		"images": [ "Assets/Tmp/tile_surface.png", ... ]
+ *	}
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "Png.h"
+#include "../Source/Utils/FileHelper.h"
+
+namespace
+{
+	namespace fs = std::filesystem;
+
+	struct Manifest
+	{
+		u32 maxSize = 2048;
+		u32 padding = 1;
+		float scale = 1.f;
+		std::vector<std::string> images;
+	};
+
+	struct Placement
+	{
+		u32 x = 0, y = 0;	// Top left of the image, excluding the padding
+	};
+
+	std::vector<fs::path> FindManifests(const fs::path& input)
+	{
+		std::vector<fs::path> manifests;
+
+		std::error_code error;
+		if (!fs::is_directory(input, error))
+		{
+			manifests.push_back(input);
+			return manifests;
+		}
+
+		for (const fs::directory_entry& entry : fs::directory_iterator(input, error))
+		{
+			const std::string name = entry.path().filename().string();
+			if (entry.is_regular_file() && name.size() > 11 && name.ends_with(".atlas.json"))
+				manifests.push_back(entry.path());
+		}
+		std::sort(manifests.begin(), manifests.end());
+		return manifests;
+	}
+
+	bool ReadManifest(const fs::path& file, Manifest& outManifest)
+	{
+		rapidjson::Document document;
+		if (!FileHelper::TryReadJsonFile(file.generic_string(), document) || !document.IsObject())
+			return false;
+
+		if (!document.HasMember("images") || !document["images"].IsArray())
+		{
+			std::cout << "[AtlasBuilder] " << file.generic_string() << " is missing \"images\"\n";
+			return false;
+		}
+
+		if (document.HasMember("maxSize"))
+			outManifest.maxSize = document["maxSize"].GetUint();
+		if (document.HasMember("padding"))
+			outManifest.padding = document["padding"].GetUint();
+		if (document.HasMember("scale"))
+			outManifest.scale = document["scale"].GetFloat();
+
+		for (const auto& image : document["images"].GetArray())
+			outManifest.images.emplace_back(image.GetString());
+		return outManifest.scale > 0.f;
+	}
+
+	// Area average. Color is weighted by alpha so transparent pixels don't darken the edges
+	Png::Image Resize(const Png::Image& source, float scale)
+	{
+		Png::Image result;
+		result.width = (std::max)(1u, (u32)std::lround(source.width * scale));
+		result.height = (std::max)(1u, (u32)std::lround(source.height * scale));
+		result.pixels.resize((size_t)result.width * result.height * 4);
+
+		const float stepX = (float)source.width / result.width;
+		const float stepY = (float)source.height / result.height;
+		for (u32 y = 0; y < result.height; ++y)
+		{
+			const u32 minY = (u32)(y * stepY);
+			const u32 maxY = (std::max)(minY + 1, (std::min)(source.height, (u32)std::ceil((y + 1) * stepY)));
+			for (u32 x = 0; x < result.width; ++x)
+			{
+				const u32 minX = (u32)(x * stepX);
+				const u32 maxX = (std::max)(minX + 1, (std::min)(source.width, (u32)std::ceil((x + 1) * stepX)));
+
+				float r = 0.f, g = 0.f, b = 0.f, a = 0.f;
+				for (u32 sy = minY; sy < maxY; ++sy)
+				{
+					for (u32 sx = minX; sx < maxX; ++sx)
+					{
+						const u8* pixel = source.At(sx, sy);
+						const float alpha = pixel[3];
+						r += pixel[0] * alpha;
+						g += pixel[1] * alpha;
+						b += pixel[2] * alpha;
+						a += alpha;
+					}
+				}
+
+				u8* out = result.At(x, y);
+				const float count = (float)((maxX - minX) * (maxY - minY));
+				out[0] = a > 0.f ? (u8)std::lround(r / a) : 0;
+				out[1] = a > 0.f ? (u8)std::lround(g / a) : 0;
+				out[2] = a > 0.f ? (u8)std::lround(b / a) : 0;
+				out[3] = (u8)std::lround(a / count);
+			}
+		}
+		return result;
+	}
+
+	/**
+	 * @brief	Shelf packing, tallest images first. Tries the smallest power of 2 sizes first.
+	 * @return	false if it doesn't fit in maxSize x maxSize
+	 */
+	bool Pack(const std::vector<Png::Image>& images, const Manifest& manifest,
+		std::vector<Placement>& outPlacements, u32& outWidth, u32& outHeight)
+	{
+		std::vector<size_t> order(images.size());
+		for (size_t i = 0; i < order.size(); ++i)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+			return images[a].height > images[b].height;
+		});
+
+		const u32 padding = manifest.padding;
+		outPlacements.resize(images.size());
+		for (u32 height = 1; height <= manifest.maxSize; height *= 2)
+		{
+			// Width first, so the atlas is at most 2:1
+			for (u32 width = height; width <= (std::min)(height * 2, manifest.maxSize); width *= 2)
+			{
+				u32 shelfX = 0, shelfY = 0, shelfHeight = 0;
+				bool isFit = true;
+				for (size_t index : order)
+				{
+					const u32 paddedWidth = images[index].width + padding * 2;
+					const u32 paddedHeight = images[index].height + padding * 2;
+					if (shelfX + paddedWidth > width)
+					{
+						// Next shelf
+						shelfY += shelfHeight;
+						shelfX = 0;
+						shelfHeight = 0;
+					}
+
+					if (paddedWidth > width || shelfY + paddedHeight > height)
+					{
+						isFit = false;
+						break;
+					}
+
+					outPlacements[index] = Placement{ shelfX + padding, shelfY + padding };
+					shelfX += paddedWidth;
+					shelfHeight = (std::max)(shelfHeight, paddedHeight);
+				}
+
+				if (isFit)
+				{
+					outWidth = width;
+					outHeight = height;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	// Copies the image and repeats its edge pixels into the padding
+	void Blit(const Png::Image& image, const Placement& placement, u32 padding, Png::Image& atlas)
+	{
+		const int pad = (int)padding;
+		for (int y = -pad; y < (int)image.height + pad; ++y)
+		{
+			const u32 sourceY = (u32)std::clamp(y, 0, (int)image.height - 1);
+			for (int x = -pad; x < (int)image.width + pad; ++x)
+			{
+				const u32 sourceX = (u32)std::clamp(x, 0, (int)image.width - 1);
+				std::copy_n(image.At(sourceX, sourceY), 4, atlas.At(placement.x + x, placement.y + y));
+			}
+		}
+	}
+
+	bool WriteLookupTable(const fs::path& file, const std::string& texture, u64 sourceHash, const Manifest& manifest,
+		const std::vector<Png::Image>& images, const std::vector<Placement>& placements, u32 width, u32 height)
+	{
+		std::ofstream stream(file);
+		if (!stream)
+		{
+			std::cout << "[AtlasBuilder] Can't write " << file.generic_string() << "\n";
+			return false;
+		}
+
+		stream << "{\n"
+			   << "\t\"texture\": \"" << texture << "\",\n"
+			   << "\t\"width\": " << width << ",\n"
+			   << "\t\"height\": " << height << ",\n"
+			   << "\t\"sourceHash\": \"" << std::hex << sourceHash << std::dec << "\",\n"
+			   << "\t\"regions\": [\n";
+		for (size_t i = 0; i < images.size(); ++i)
+		{
+			const Placement& placement = placements[i];
+			stream << "\t\t{ \"name\": \"" << manifest.images[i] << "\""
+				   << ", \"x\": " << placement.x << ", \"y\": " << placement.y
+				   << ", \"w\": " << images[i].width << ", \"h\": " << images[i].height
+				   << ", \"u0\": " << (double)placement.x / width
+				   << ", \"v0\": " << (double)placement.y / height
+				   << ", \"u1\": " << (double)(placement.x + images[i].width) / width
+				   << ", \"v1\": " << (double)(placement.y + images[i].height) / height
+				   << " }" << (i + 1 < images.size() ? "," : "") << "\n";
+		}
+		stream << "\t]\n}\n";
+		return true;
+	}
+
+	// FNV-1a of the manifest and every image. Timestamps can't be used, copying Assets to the build folder updates them
+	u64 HashSources(const fs::path& manifestFile, const Manifest& manifest)
+	{
+		u64 hash = 14695981039346656037ull;
+		auto hashFile = [&hash](const fs::path& file) {
+			std::ifstream stream(file, std::ios::binary);
+			char buffer[1 << 16];
+			while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0)
+			{
+				for (std::streamsize i = 0; i < stream.gcount(); ++i)
+					hash = (hash ^ (u8)buffer[i]) * 1099511628211ull;
+			}
+		};
+
+		hashFile(manifestFile);
+		for (const std::string& image : manifest.images)
+			hashFile(image);
+		return hash;
+	}
+
+	bool IsUpToDate(const std::string& textureFile, const std::string& tableFile, u64 sourceHash)
+	{
+		std::error_code error;
+		if (!fs::exists(textureFile, error))
+			return false;
+
+		rapidjson::Document document;
+		std::ifstream stream(tableFile);
+		if (!stream)
+			return false;
+		const std::string json((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+		document.Parse(json.c_str());
+
+		return !document.HasParseError() && document.IsObject() && document.HasMember("sourceHash") &&
+			document["sourceHash"].IsString() && std::stoull(document["sourceHash"].GetString(), nullptr, 16) == sourceHash;
+	}
+
+	bool BuildAtlas(const fs::path& manifestFile, bool isForced, bool& outIsSkipped)
+	{
+		outIsSkipped = false;
+
+		Manifest manifest;
+		if (!ReadManifest(manifestFile, manifest))
+			return false;
+
+		// <name>.atlas.json -> <name>.png / <name>.uv.json
+		const std::string manifestPath = manifestFile.generic_string();
+		const std::string basePath = manifestPath.substr(0, manifestPath.size() - std::string(".atlas.json").size());
+		const std::string texturePath = basePath + ".png";
+		const std::string tablePath = basePath + ".uv.json";
+
+		const u64 sourceHash = HashSources(manifestFile, manifest);
+		if (!isForced && IsUpToDate(texturePath, tablePath, sourceHash))
+		{
+			outIsSkipped = true;
+			return true;
+		}
+
+		std::vector<Png::Image> images(manifest.images.size());
+		for (size_t i = 0; i < images.size(); ++i)
+		{
+			if (!Png::Load(manifest.images[i], images[i]))
+				return false;
+
+			if (manifest.scale != 1.f)
+				images[i] = Resize(images[i], manifest.scale);
+		}
+
+		std::vector<Placement> placements;
+		u32 width = 0, height = 0;
+		if (!Pack(images, manifest, placements, width, height))
+		{
+			std::cout << "[AtlasBuilder] " << manifestPath << " doesn't fit in " << manifest.maxSize << "x" << manifest.maxSize << "\n";
+			return false;
+		}
+
+		Png::Image atlas;
+		atlas.width = width;
+		atlas.height = height;
+		atlas.pixels.assign((size_t)width * height * 4, 0);
+		for (size_t i = 0; i < images.size(); ++i)
+			Blit(images[i], placements[i], manifest.padding, atlas);
+
+		if (!Png::Save(texturePath, atlas))
+			return false;
+
+		std::cout << "[AtlasBuilder] " << manifestPath << " -> " << texturePath << " ("
+				  << images.size() << " images, " << width << "x" << height << ")\n";
+		return WriteLookupTable(tablePath, texturePath, sourceHash, manifest, images, placements, width, height);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	bool isForced = false;
+	std::vector<fs::path> inputs;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--force"))
+			isForced = true;
+		else
+			inputs.emplace_back(argv[i]);
+	}
+
+	if (inputs.empty())
+	{
+		std::cout << "Usage: " << argv[0] << " [--force] <file.atlas.json | folder>...\n";
+		return 1;
+	}
+
+	int built = 0, skipped = 0, failed = 0;
+	for (const fs::path& input : inputs)
+	{
+		for (const fs::path& manifest : FindManifests(input))
+		{
+			bool isSkipped = false;
+			if (!BuildAtlas(manifest, isForced, isSkipped))
+			{
+				std::cout << "[AtlasBuilder] Failed to build " << manifest.generic_string() << "\n";
+				++failed;
+			}
+			else if (isSkipped)
+				++skipped;
+			else
+				++built;
+		}
+	}
+
+	std::cout << "[AtlasBuilder] " << built << " built, " << skipped << " up to date, " << failed << " failed\n";
+	return failed > 0 ? 1 : 0;
+}
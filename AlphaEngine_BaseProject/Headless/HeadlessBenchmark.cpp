@@ -0,0 +1,605 @@
+/**
+ * @file	HeadlessBenchmark.cpp
+ * @brief	Frame time benchmark for the gameplay update.
+ *
+ *	Usage: HeadlessBenchmark [--levels <dir>] [--level <path>]... [--frames <n>] [--warmup <n>]
+ *	                         [--dt <seconds>] [--seed <n>] [--csv <path>]
+ *	                         [--baseline <csv>] [--tolerance <fraction>] [--particles <n>] [--enemies <n>] [--memory]
+ *
+ *	For every level (default: every .lvl in Assets/Levels) the level is loaded and the rooms built,
+ *	then HeadlessSimulation is stepped with scripted input and each stage of the update is timed.
+ *	Reports mean / p50 / p99 / max per stage in microseconds.
+ *
+ *	With --baseline, the p50 frame time of each level is compared against a previous --csv output.
+ *	Returns 2 if any level is slower than baseline * (1 + tolerance).
+ *
+ *	Every level also reports its peak heap memory, allocations per frame and the memory left after it's unloaded
+ *	(see MemoryTracker). --memory prints the memory of every subsystem after each level.
+ *
+ *	With --particles, benchmarks ParticleSystem::Update instead of the levels:
+ *	n live particles of each behavior, updated for --frames frames.
+ *
+ *	With --enemies, benchmarks EnemyManager::UpdateAll instead of the levels:
+ *	n enemies spread around the spawns of the first level's start room, updated for --frames frames.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "AEHeadless.h"
+#include "HeadlessSimulation.h"
+#include "../Source/Game/Time.h"
+#include "../Source/Game/Timer.h"
+#include "../Source/Utils/ResourceCache.h"
+#include "../Source/Utils/FrameArena.h"
+#include "../Source/Utils/MemoryTracker.h"
+#include "../Source/Utils/ParticleSystem.h"
+#include "../Source/Utils/Animator.h"
+
+namespace
+{
+	using Stage = HeadlessSimulation::Stage;
+
+	// Name used for the whole frame in the reports
+	constexpr const char* FRAME_ROW = "Frame";
+
+	struct Options
+	{
+		std::string levelsDir = "Assets/Levels";
+		std::vector<std::string> levels;
+		u32 frames = 5000;
+		u32 warmup = 120;
+		f64 dt = 1.0 / 120.0;
+		u32 seed = 0;
+		std::string csvPath;
+		std::string baselinePath;
+		double tolerance = 0.15;
+		u32 particles = 0;
+		u32 enemies = 0;
+		bool dumpMemory = false;
+	};
+
+	struct Stats
+	{
+		double mean = 0.0, p50 = 0.0, p99 = 0.0, max = 0.0; // microseconds
+	};
+
+	struct LevelResult
+	{
+		std::string name;
+		double loadMs = 0.0;
+		u32 restarts = 0;
+		Stats frame;
+		Stats stages[HeadlessSimulation::STAGE_COUNT];
+
+		// Memory
+		s64 peakBytes = 0;
+		s64 leftoverBytes = 0;		// Live bytes after unloading - before loading
+		double allocationsPerFrame = 0.0;
+	};
+
+	struct ParticleResult
+	{
+		const char* behavior;
+		Stats update;
+	};
+
+	void PrintUsage(const char* exe)
+	{
+		std::cout << "Usage: " << exe << " [--levels <dir>] [--level <path>]... [--frames <n>] [--warmup <n>]\n"
+				  << "       [--dt <seconds>] [--seed <n>] [--csv <path>] [--baseline <csv>] [--tolerance <fraction>]\n"
+				  << "       [--particles <n>] [--enemies <n>] [--memory]\n";
+	}
+
+	bool ParseOptions(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const bool hasValue = i + 1 < argc;
+			if (!strcmp(argv[i], "--levels") && hasValue)
+				options.levelsDir = argv[++i];
+			else if (!strcmp(argv[i], "--level") && hasValue)
+				options.levels.emplace_back(argv[++i]);
+			else if (!strcmp(argv[i], "--frames") && hasValue)
+				options.frames = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--warmup") && hasValue)
+				options.warmup = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--dt") && hasValue)
+				options.dt = std::strtod(argv[++i], nullptr);
+			else if (!strcmp(argv[i], "--seed") && hasValue)
+				options.seed = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--csv") && hasValue)
+				options.csvPath = argv[++i];
+			else if (!strcmp(argv[i], "--baseline") && hasValue)
+				options.baselinePath = argv[++i];
+			else if (!strcmp(argv[i], "--tolerance") && hasValue)
+				options.tolerance = std::strtod(argv[++i], nullptr);
+			else if (!strcmp(argv[i], "--particles") && hasValue)
+				options.particles = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--enemies") && hasValue)
+				options.enemies = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--memory"))
+				options.dumpMemory = true;
+			else
+			{
+				PrintUsage(argv[0]);
+				return false;
+			}
+		}
+
+		return options.frames > 0 && options.dt > 0.0;
+	}
+
+	std::vector<std::string> FindLevels(const std::string& dir)
+	{
+		namespace fs = std::filesystem;
+
+		std::vector<std::string> levels;
+		std::error_code error;
+		for (const fs::directory_entry& entry : fs::directory_iterator(dir, error))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".lvl")
+				levels.emplace_back(entry.path().generic_string());
+		}
+
+		if (error)
+			std::cout << "[Benchmark] Failed to open " << dir << ": " << error.message() << "\n";
+
+		std::sort(levels.begin(), levels.end());
+		return levels;
+	}
+
+	/**
+	 * @brief	Computes the stats of samples (in seconds). Sorts the samples.
+	 */
+	Stats ComputeStats(std::vector<double>& samples)
+	{
+		Stats stats;
+		if (samples.empty())
+			return stats;
+
+		std::sort(samples.begin(), samples.end());
+
+		double sum = 0.0;
+		for (double s : samples)
+			sum += s;
+
+		// Nearest-rank percentile
+		auto percentile = [&samples](double p) {
+			size_t rank = (size_t)(p * (double)samples.size());
+			return samples[(std::min)(rank, samples.size() - 1)];
+		};
+
+		constexpr double toMicroseconds = 1e6;
+		stats.mean = sum / (double)samples.size() * toMicroseconds;
+		stats.p50 = percentile(0.50) * toMicroseconds;
+		stats.p99 = percentile(0.99) * toMicroseconds;
+		stats.max = samples.back() * toMicroseconds;
+		return stats;
+	}
+
+	LevelResult RunLevel(const std::string& levelPath, const Options& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		LevelResult result;
+		result.name = std::filesystem::path(levelPath).stem().string();
+
+		// Fresh run for every level
+		Time::GetInstance().ResetElapsedTime();
+		TimerSystem::GetInstance().Clear();
+		AEHeadless::SetRandomSeed(options.seed);
+
+		HeadlessSimulation simulation;
+
+		const Clock::time_point loadStart = Clock::now();
+		simulation.LoadLevel(levelPath);
+		result.loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+
+		std::vector<double> frameSamples;
+		std::vector<double> stageSamples[HeadlessSimulation::STAGE_COUNT];
+		frameSamples.reserve(options.frames);
+		for (std::vector<double>& samples : stageSamples)
+			samples.reserve(options.frames);
+
+		HeadlessSimulation::StageTimes stageTimes{};
+		u64 timedAllocationsStart = 0;
+		const u32 totalFrames = options.warmup + options.frames;
+		for (u32 frame = 0; frame < totalFrames; ++frame)
+		{
+			HeadlessSimulation::ApplyScriptedInput(frame);
+
+			if (frame == options.warmup)
+				timedAllocationsStart = MemoryTracker::GetTotalStats().totalAllocations;
+
+			if (frame < options.warmup)
+			{
+				simulation.Step();
+			}
+			else
+			{
+				const Clock::time_point frameStart = Clock::now();
+				simulation.Step(&stageTimes);
+				frameSamples.push_back(std::chrono::duration<double>(Clock::now() - frameStart).count());
+
+				for (int i = 0; i < HeadlessSimulation::STAGE_COUNT; ++i)
+					stageSamples[i].push_back(stageTimes[i]);
+			}
+
+			// Not timed, restarting is a level load
+			if (simulation.IsRunOver())
+			{
+				++result.restarts;
+				simulation.Restart();
+			}
+		}
+
+		result.allocationsPerFrame =
+			(double)(MemoryTracker::GetTotalStats().totalAllocations - timedAllocationsStart) / options.frames;
+
+		result.frame = ComputeStats(frameSamples);
+		for (int i = 0; i < HeadlessSimulation::STAGE_COUNT; ++i)
+			result.stages[i] = ComputeStats(stageSamples[i]);
+
+		return result;
+	}
+
+	/**
+	 * @brief	Times ParticleSystem::Update with options.particles live particles, once per behavior.
+	 *			Lifetimes are long enough that nothing expires during the run.
+	 */
+	std::vector<ParticleResult> RunParticles(const Options& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		constexpr const char* behaviorNames[] = { "normal", "Inward", "TornadoIn", "Gravity" };
+		static_assert(sizeof(behaviorNames) / sizeof(behaviorNames[0]) == (int)ParticleBehavior::Count);
+
+		std::vector<ParticleResult> results;
+		for (int behavior = 0; behavior < (int)ParticleBehavior::Count; ++behavior)
+		{
+			Time::GetInstance().ResetElapsedTime();
+			AEHeadless::SetRandomSeed(options.seed);
+
+			ParticleSystem::EmitterSettings emitter{
+				.spawnPosRangeX{ -20.f, 20.f },
+				.spawnPosRangeY{ -20.f, 20.f },
+				.angleRange{ 0.f, 2.f * PI },
+				.speedRange{ 0.5f, 2.f },
+				.lifetimeRange{ 1e6f, 1e6f },
+				.behavior = (ParticleBehavior)behavior,
+				.behaviorParams{ .center{ 0.f, 0.f }, .pull = 5.f, .swirl = 3.f },
+			};
+
+			ParticleSystem particleSystem((int)options.particles, emitter);
+			particleSystem.SetSpawnRate(0.f);
+			particleSystem.SpawnParticleBurst(options.particles);
+
+			std::vector<double> samples;
+			samples.reserve(options.frames);
+			for (u32 frame = 0; frame < options.warmup + options.frames; ++frame)
+			{
+				const Clock::time_point start = Clock::now();
+				particleSystem.Update();
+				if (frame >= options.warmup)
+					samples.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+
+				Time::GetInstance().Update();
+			}
+
+			results.push_back(ParticleResult{ behaviorNames[behavior], ComputeStats(samples) });
+		}
+
+		return results;
+	}
+
+	/**
+	 * @brief	Times EnemyManager::UpdateAll with options.enemies enemies in the first level's start room.
+	 *			The player doesn't move, so the enemies near it chase / attack and the rest wander.
+	 */
+	Stats RunEnemies(const Options& options)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		Time::GetInstance().ResetElapsedTime();
+		TimerSystem::GetInstance().Clear();
+		AEHeadless::SetRandomSeed(options.seed);
+
+		HeadlessSimulation simulation;
+		simulation.LoadLevel(options.levels.front());
+
+		EnemyManager& enemyMgr = simulation.GetEnemyManager();
+		MapGrid& map = simulation.GetMap();
+		const AEVec2 playerPos = simulation.GetPlayer().GetPosition();
+
+		// Spread the extra enemies around the room's own enemies, which are on the ground
+		std::vector<AEVec2> anchors;
+		enemyMgr.ForEachEnemy([&anchors](Enemy& enemy) { anchors.push_back(enemy.GetPosition()); });
+		if (anchors.empty())
+			anchors.push_back(playerPos);
+
+		for (u32 i = (u32)enemyMgr.Count(); i < options.enemies; ++i)
+		{
+			AEVec2 pos = anchors[i % anchors.size()];
+			pos.x += (float)((i / anchors.size()) % 9) * 0.25f - 1.f;
+			enemyMgr.Spawn(i % 2 ? Enemy::Preset::Skeleton : Enemy::Preset::Druid, pos);
+		}
+
+		std::vector<double> samples;
+		samples.reserve(options.frames);
+		for (u32 frame = 0; frame < options.warmup + options.frames; ++frame)
+		{
+			AESysFrameStart();
+			FrameArena::Reset();
+
+			const Clock::time_point start = Clock::now();
+			enemyMgr.UpdateAll(playerPos, map);
+			if (frame >= options.warmup)
+				samples.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+
+			Animator::Update();
+			Time::GetInstance().Update();
+			AESysFrameEnd();
+		}
+
+		return ComputeStats(samples);
+	}
+
+	void PrintStatsRow(const char* name, const Stats& stats)
+	{
+		std::cout << "  " << std::left << std::setw(12) << name << std::right
+				  << std::setw(10) << stats.mean
+				  << std::setw(10) << stats.p50
+				  << std::setw(10) << stats.p99
+				  << std::setw(10) << stats.max << "\n";
+	}
+
+	void PrintLevelResult(const LevelResult& result)
+	{
+		std::cout << "\n[Benchmark] " << result.name
+				  << " (load " << result.loadMs << " ms, restarts " << result.restarts << ")\n";
+		if (MemoryTracker::IsEnabled())
+			std::cout << "  memory: peak " << result.peakBytes / 1024.0 << " KB, " << result.allocationsPerFrame
+					  << " allocs/frame, " << result.leftoverBytes / 1024.0 << " KB left after unload\n";
+		std::cout
+				  << "  " << std::left << std::setw(12) << "stage (us)" << std::right
+				  << std::setw(10) << "mean" << std::setw(10) << "p50"
+				  << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+		for (int i = 0; i < HeadlessSimulation::STAGE_COUNT; ++i)
+			PrintStatsRow(HeadlessSimulation::GetStageName((Stage)i), result.stages[i]);
+		PrintStatsRow(FRAME_ROW, result.frame);
+	}
+
+	void PrintSummary(const std::vector<LevelResult>& results)
+	{
+		std::cout << "\n[Benchmark] Summary (us)\n"
+				  << "  " << std::left << std::setw(16) << "level" << std::right
+				  << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p99"
+				  << "  top stage\n";
+
+		for (const LevelResult& result : results)
+		{
+			int top = 0;
+			for (int i = 1; i < HeadlessSimulation::STAGE_COUNT; ++i)
+			{
+				if (result.stages[i].mean > result.stages[top].mean)
+					top = i;
+			}
+
+			std::cout << "  " << std::left << std::setw(16) << result.name << std::right
+					  << std::setw(10) << result.frame.mean
+					  << std::setw(10) << result.frame.p50
+					  << std::setw(10) << result.frame.p99
+					  << "  " << HeadlessSimulation::GetStageName((Stage)top) << "\n";
+		}
+	}
+
+	void PrintParticleResults(const Options& options, const std::vector<ParticleResult>& results)
+	{
+		std::cout << "\n[Benchmark] ParticleSystem::Update, " << options.particles << " particles, "
+				  << options.frames << " frames (+" << options.warmup << " warmup)\n"
+				  << "  " << std::left << std::setw(12) << "behavior (us)" << std::right
+				  << std::setw(10) << "mean" << std::setw(10) << "p50"
+				  << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+		for (const ParticleResult& result : results)
+			PrintStatsRow(result.behavior, result.update);
+	}
+
+	void PrintEnemyResult(const Options& options, const Stats& update)
+	{
+		std::cout << "\n[Benchmark] EnemyManager::UpdateAll, " << options.enemies << " enemies, "
+				  << options.frames << " frames (+" << options.warmup << " warmup)\n"
+				  << "  " << std::left << std::setw(12) << "stage (us)" << std::right
+				  << std::setw(10) << "mean" << std::setw(10) << "p50"
+				  << std::setw(10) << "p99" << std::setw(10) << "max" << "\n";
+
+		PrintStatsRow("Enemies", update);
+		std::cout << "  " << update.mean * 1000.0 / options.enemies << " ns per enemy (mean)\n";
+	}
+
+	bool WriteCsv(const std::string& path, const std::vector<LevelResult>& results)
+	{
+		std::ofstream file(path);
+		if (!file)
+		{
+			std::cout << "[Benchmark] Failed to write " << path << "\n";
+			return false;
+		}
+
+		file << "level,stage,mean_us,p50_us,p99_us,max_us\n";
+		auto writeRow = [&file](const std::string& level, const char* stage, const Stats& stats) {
+			file << level << "," << stage << "," << stats.mean << "," << stats.p50 << ","
+				 << stats.p99 << "," << stats.max << "\n";
+		};
+
+		for (const LevelResult& result : results)
+		{
+			for (int i = 0; i < HeadlessSimulation::STAGE_COUNT; ++i)
+				writeRow(result.name, HeadlessSimulation::GetStageName((Stage)i), result.stages[i]);
+			writeRow(result.name, FRAME_ROW, result.frame);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief	Reads the p50 frame time of each level from a csv written by WriteCsv.
+	 */
+	bool ReadBaseline(const std::string& path, std::map<std::string, double>& outFrameP50)
+	{
+		std::ifstream file(path);
+		if (!file)
+		{
+			std::cout << "[Benchmark] Failed to open baseline " << path << "\n";
+			return false;
+		}
+
+		std::string line;
+		std::getline(file, line); // header
+		while (std::getline(file, line))
+		{
+			std::stringstream ss(line);
+			std::string level, stage, mean, p50;
+			if (!std::getline(ss, level, ',') || !std::getline(ss, stage, ',') ||
+				!std::getline(ss, mean, ',') || !std::getline(ss, p50, ','))
+				continue;
+
+			if (stage == FRAME_ROW)
+				outFrameP50[level] = std::strtod(p50.c_str(), nullptr);
+		}
+		return true;
+	}
+
+	/**
+	 * @return	Number of levels slower than the baseline
+	 */
+	int CompareBaseline(const std::map<std::string, double>& baseline, const std::vector<LevelResult>& results, double tolerance)
+	{
+		int regressions = 0;
+		std::cout << "\n[Benchmark] Baseline comparison (p50 frame, tolerance " << tolerance * 100.0 << "%)\n";
+		for (const LevelResult& result : results)
+		{
+			auto it = baseline.find(result.name);
+			if (it == baseline.end() || it->second <= 0.0)
+			{
+				std::cout << "  " << std::left << std::setw(16) << result.name << "no baseline\n";
+				continue;
+			}
+
+			const double change = result.frame.p50 / it->second - 1.0;
+			const bool isRegression = change > tolerance;
+			regressions += isRegression;
+
+			std::cout << "  " << std::left << std::setw(16) << result.name << std::right
+					  << std::setw(10) << it->second << " -> " << std::setw(10) << result.frame.p50
+					  << "  " << std::showpos << change * 100.0 << "%" << std::noshowpos
+					  << (isRegression ? "  REGRESSION" : "") << "\n";
+		}
+		return regressions;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	// Output paths are relative to where the benchmark was started from
+	if (!options.csvPath.empty())
+		options.csvPath = std::filesystem::absolute(options.csvPath).string();
+	if (!options.baselinePath.empty())
+		options.baselinePath = std::filesystem::absolute(options.baselinePath).string();
+
+	HeadlessSimulation::SetAssetWorkingDirectory(argv[0]);
+
+	if (options.levels.empty())
+		options.levels = FindLevels(options.levelsDir);
+	if (options.levels.empty())
+	{
+		std::cout << "[Benchmark] No levels found\n";
+		return 1;
+	}
+
+	AESysInit(nullptr, 0, 1600, 900, 0, 120, false, nullptr);
+	AEFrameRateControllerInit(0);
+	AEHeadless::SetFrameTime(options.dt);
+	// Tick at the frame time so every frame is exactly 1 gameplay tick
+	Time::GetInstance().SetTickRate(1.0 / options.dt);
+
+	if (options.particles > 0)
+	{
+		std::cout << std::fixed << std::setprecision(2);
+		PrintParticleResults(options, RunParticles(options));
+
+		AESysExit();
+		return 0;
+	}
+
+	if (options.enemies > 0)
+	{
+		const Stats update = RunEnemies(options);
+		std::cout << std::fixed << std::setprecision(2);
+		PrintEnemyResult(options, update);
+
+		ResourceCache::Clear();
+		FrameArena::Clear();
+		AESysExit();
+		return 0;
+	}
+
+	std::vector<LevelResult> results;
+	results.reserve(options.levels.size());
+	for (const std::string& level : options.levels)
+	{
+		const s64 liveBytesBefore = MemoryTracker::GetTotalStats().liveBytes;
+		MemoryTracker::ResetPeaks();
+
+		LevelResult& result = results.emplace_back(RunLevel(level, options));
+
+		const MemoryTracker::TagStats memory = MemoryTracker::GetTotalStats();
+		result.peakBytes = memory.peakBytes;
+		result.leftoverBytes = memory.liveBytes - liveBytesBefore;
+
+		if (options.dumpMemory)
+		{
+			std::cout << "\n[Benchmark] " << result.name << " ";
+			MemoryTracker::Dump();
+		}
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << "\n[Benchmark] " << options.frames << " frames (+" << options.warmup
+			  << " warmup) @ " << options.dt << "s per level\n";
+	for (const LevelResult& result : results)
+		PrintLevelResult(result);
+	PrintSummary(results);
+
+	if (!options.csvPath.empty() && WriteCsv(options.csvPath, results))
+		std::cout << "\n[Benchmark] Wrote " << options.csvPath << "\n";
+
+	int exitCode = 0;
+	if (!options.baselinePath.empty())
+	{
+		std::map<std::string, double> baseline;
+		if (!ReadBaseline(options.baselinePath, baseline))
+			exitCode = 1;
+		else if (CompareBaseline(baseline, results, options.tolerance) > 0)
+			exitCode = 2;
+	}
+
+	ResourceCache::Clear();
+	FrameArena::Clear();
+	AESysExit();
+	return exitCode;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file	HeadlessMain.cpp
+ * @brief	Runs the game simulation without a window at a fixed dt.
+ *
+ *	Usage: HeadlessSim [--level <path>] [--frames <n>] [--dt <seconds>] [--tick-rate <hz>] [--seed <n>] [--render]
+ *	                   [--render-null] [--idle] [--trace <path>]
+ *
+ *	By default a simple scripted input (run, jump, attack, dash) drives the player
+ *	so the enemies, traps and room transitions get exercised.
+ *	--trace records the profiler zones and writes a chrome://tracing file at the end.
+ *	--render-null renders through Renderer::RecordingBackend, only counting the batches.
+ *	--tick-rate defaults to 1 / dt, so each frame runs exactly 1 fixed step as fast as it can.
+ *	Set it to something else to run a different number of ticks per frame, like the game at a low frame rate.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "AEHeadless.h"
+#include "HeadlessSimulation.h"
+#include "../Source/Game/Time.h"
+#include "../Source/Utils/Profiler.h"
+#include "../Source/Utils/ResourceCache.h"
+#include "../Source/Utils/Renderer.h"
+#include "../Source/Utils/FrameArena.h"
+
+namespace
+{
+	struct Options
+	{
+		std::string levelPath = "Assets/Levels/gamescene.lvl";
+		u32 frames = 6000;
+		f64 dt = 1.0 / 120.0;
+		f64 tickRate = 0.0;		// 0 = 1 / dt
+		u32 seed = 0;
+		bool render = false;
+		bool nullRenderer = false;
+		bool scriptedInput = true;
+		std::string tracePath;
+	};
+
+	bool ParseOptions(int argc, char* argv[], Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const bool hasValue = i + 1 < argc;
+			if (!strcmp(argv[i], "--level") && hasValue)
+				options.levelPath = argv[++i];
+			else if (!strcmp(argv[i], "--frames") && hasValue)
+				options.frames = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--dt") && hasValue)
+				options.dt = std::strtod(argv[++i], nullptr);
+			else if (!strcmp(argv[i], "--tick-rate") && hasValue)
+				options.tickRate = std::strtod(argv[++i], nullptr);
+			else if (!strcmp(argv[i], "--seed") && hasValue)
+				options.seed = (u32)std::strtoul(argv[++i], nullptr, 10);
+			else if (!strcmp(argv[i], "--render"))
+				options.render = true;
+			else if (!strcmp(argv[i], "--render-null"))
+				options.render = options.nullRenderer = true;
+			else if (!strcmp(argv[i], "--idle"))
+				options.scriptedInput = false;
+			else if (!strcmp(argv[i], "--trace") && hasValue)
+				options.tracePath = argv[++i];
+			else
+			{
+				std::cout << "Usage: " << argv[0]
+					<< " [--level <path>] [--frames <n>] [--dt <seconds>] [--tick-rate <hz>] [--seed <n>] [--render] [--render-null] [--idle] [--trace <path>]\n";
+				return false;
+			}
+		}
+
+		return options.dt > 0.0 && options.tickRate >= 0.0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+		return 1;
+
+	// Relative to where the simulation was started from
+	if (!options.tracePath.empty())
+		options.tracePath = std::filesystem::absolute(options.tracePath).string();
+
+	HeadlessSimulation::SetAssetWorkingDirectory(argv[0]);
+
+	AEHeadless::SetRandomSeed(options.seed);
+	AESysInit(nullptr, 0, 1600, 900, 0, 120, false, nullptr);
+	AEFrameRateControllerInit(0);
+	AEHeadless::SetFrameTime(options.dt);
+	Time::GetInstance().SetTickRate(options.tickRate > 0.0 ? options.tickRate : 1.0 / options.dt);
+
+	Renderer::RecordingBackend recordingBackend;
+	if (options.nullRenderer)
+		Renderer::SetBackend(&recordingBackend);
+
+	u32 restarts = 0;
+	u32 drawCalls = 0;
+	u32 meshCreates = 0;
+	f64 renderSeconds = 0.0;
+	auto startTime = std::chrono::steady_clock::now();
+	{
+		HeadlessSimulation simulation;
+		if (!simulation.LoadLevel(options.levelPath))
+			std::cout << "[Headless] Running fallback room\n";
+
+		if (!options.tracePath.empty())
+			Profiler::SetRecording(true);
+
+		for (u32 frame = 0; frame < options.frames; ++frame)
+		{
+			if (options.scriptedInput)
+				HeadlessSimulation::ApplyScriptedInput(frame);
+
+			simulation.Step();
+
+			if (options.render)
+			{
+				const auto renderStart = std::chrono::steady_clock::now();
+				simulation.Render();
+				renderSeconds += std::chrono::duration<f64>(std::chrono::steady_clock::now() - renderStart).count();
+				drawCalls += AEHeadless::GetFrameDrawCount();
+				meshCreates += AEHeadless::GetFrameMeshCreateCount();
+				recordingBackend.Clear();
+			}
+
+			if (simulation.IsRunOver())
+			{
+				++restarts;
+				simulation.Restart();
+			}
+		}
+
+		const std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+		const AEVec2& playerPos = simulation.GetPlayer().GetPosition();
+
+		std::cout << "[Headless] level:        " << options.levelPath << "\n"
+				  << "[Headless] frames:       " << options.frames << " @ " << options.dt << "s, "
+				  << Time::GetInstance().GetTickRate() << " ticks/s\n"
+				  << "[Headless] game time:    " << Time::GetInstance().GetScaledElapsedTime() << "s\n"
+				  << "[Headless] wall time:    " << wallTime.count() << "s ("
+				  << (wallTime.count() > 0.0 ? options.frames / wallTime.count() : 0.0) << " frames/s)\n"
+				  << "[Headless] player:       (" << playerPos.x << ", " << playerPos.y << ") hp "
+				  << simulation.GetPlayer().GetHealth() << "/" << simulation.GetPlayer().GetMaxHealth() << "\n"
+				  << "[Headless] room changes: " << simulation.GetRoomChanges() << "\n"
+				  << "[Headless] restarts:     " << restarts << "\n";
+
+		const ResourceCache::Stats& sheetStats = ResourceCache::GetSpriteSheetStats();
+		const ResourceCache::Stats& textureStats = ResourceCache::GetTextureStats();
+		std::cout << "[Headless] sprite cache: " << sheetStats.hits << " hits, " << sheetStats.misses << " misses, "
+				  << ResourceCache::GetSpriteSheetCount() << " loaded\n"
+				  << "[Headless] tex cache:    " << textureStats.hits << " hits, " << textureStats.misses << " misses, "
+				  << ResourceCache::GetTextureCount() << " loaded\n"
+				  << "[Headless] live tex:     " << AEHeadless::GetLiveTextureCount() << "\n"
+				  << "[Headless] frame arena:  peak " << FrameArena::GetPeakBytes() << " bytes of " << FrameArena::GetCapacity()
+				  << ", heap used in " << FrameArena::GetOverflowFrameCount() << " frames\n";
+		if (options.render)
+		{
+			const Renderer::Stats& renderStats = Renderer::GetTotalStats();
+			const u32 frameCount = options.frames ? options.frames : 1;
+			std::cout << "[Headless] draw calls:   " << drawCalls << " (" << drawCalls / frameCount << "/frame)\n"
+					  << "[Headless] meshes made: " << meshCreates << " (" << (f64)meshCreates / frameCount << "/frame)\n"
+					  << "[Headless] render time: " << renderSeconds * 1e6 / frameCount << "us/frame (CPU side, stub AlphaEngine)\n"
+					  << "[Headless] renderer:     " << renderStats.commands << " quads in " << renderStats.batches << " batches ("
+					  << renderStats.commands / frameCount << " quads, " << renderStats.batches / frameCount << " batches/frame), sort "
+					  << renderStats.sortSeconds * 1e6 / frameCount << "us/frame\n";
+		}
+	}
+
+	if (!options.tracePath.empty())
+	{
+		Profiler::SetRecording(false);
+		if (!Profiler::ExportChromeTrace(options.tracePath))
+			return 1;
+	}
+
+	Renderer::SetBackend(nullptr);
+	Renderer::Free();
+	ResourceCache::Clear();
+	FrameArena::Clear();
+	AESysExit();
+	return 0;
+}
@@ -0,0 +1,342 @@
+#include "HeadlessSimulation.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <new>
+
+#include "AEHeadless.h"
+#include "../Source/Game/Time.h"
+#include "../Source/Game/Timer.h"
+#include "../Source/Game/UI.h"
+#include "../Source/Game/Background.h"
+#include "../Source/Game/BuffCards.h"
+#include "../Source/Game/AudioManager.h"
+#include "../Source/Game/Scene/LevelIO.h"
+#include "../Source/Game/Rooms/RoomBuilder.h"
+#include "../Source/Utils/Profiler.h"
+#include "../Source/Utils/DebugDraw.h"
+#include "../Source/Utils/Renderer.h"
+#include "../Source/Utils/Animator.h"
+#include "../Source/Utils/Event/EventSystem.h"
+#include "../Source/Utils/FrameArena.h"
+#include "../Source/Utils/MemoryTracker.h"
+#include "../Source/Editor/Editor.h"
+
+HeadlessSimulation::HeadlessSimulation() :
+	map(ROOM_COLS, ROOM_ROWS),
+	player(&map, &enemyMgr),
+	camera({ 1,1 }, { (float)(ROOM_COLS - 1), (float)(ROOM_ROWS - 1) }, 64),
+	enemyBoss(35, 2.90f),
+	testParticleSystem(
+		20,
+		ParticleSystem::EmitterSettings{
+			.angleRange{ PI / 3, PI / 4 },
+			.speedRange{ 30.f, 50.f },
+			.lifetimeRange{1.f, 2.f},
+		}
+		),
+	roomSystem(map, player, camera, trapMgr, enemyMgr, enemyBoss, roomMgr)
+{
+	UI::Init(&player);
+	Background::Init();
+	AudioManager::Init();
+	SpikePlate::LoadSharedRenderResources();
+}
+
+HeadlessSimulation::~HeadlessSimulation()
+{
+	UI::Exit();
+	Background::Exit();
+	AudioManager::Exit();
+	SpikePlate::UnloadSharedRenderResources();
+}
+
+bool HeadlessSimulation::LoadLevel(const std::string& path)
+{
+	levelPath = path;
+	roomMgr.Clear();
+
+	LevelData level;
+	RoomID startRoom = ROOM_NONE;
+	const bool loadedFromFile = LoadLevelFromFile(path.c_str(), level);
+	if (!loadedFromFile)
+	{
+		std::cout << "[Headless] Failed to load " << path << ", using an empty room\n";
+
+		level = LevelData{};
+		level.rows = ROOM_ROWS;
+		level.cols = ROOM_COLS;
+		level.spawn = { 2.5f, 3.0f };
+		level.tiles.assign((size_t)ROOM_ROWS * (size_t)ROOM_COLS, (int)MapTile::Type::NONE);
+		for (int x = 0; x < ROOM_COLS; ++x)
+			level.tiles[x] = (int)MapTile::Type::GROUND_BOTTOM;
+	}
+
+	BuildRoomsFromLevelData(level, roomMgr, startRoom);
+
+	// Rebuild full level map (same as GameScene::Init)
+	map.~MapGrid();
+	new (&map) MapGrid(level.cols, level.rows);
+
+	for (int y = 0; y < level.rows; ++y)
+	{
+		for (int x = 0; x < level.cols; ++x)
+		{
+			int v = level.tiles[(size_t)y * (size_t)level.cols + (size_t)x];
+			if (v < 0 || v >= MapTile::typeCount)
+				v = (int)MapTile::Type::NONE;
+
+			map.SetTile(x, y, (MapTile::Type)v);
+		}
+	}
+
+	camera.~Camera();
+	new (&camera) Camera({ 0.f, 0.f }, { (float)level.cols, (float)level.rows }, 64.0f);
+
+	roomMgr.SetCurrentRoom(startRoom);
+	roomSystem.BuildCurrentRoom();
+	roomTransitionLocked = false;
+	roomSystem.ClearBlockedReturnDir();
+
+	player.Reset({ 1, 7.5 });
+	return loadedFromFile;
+}
+
+void HeadlessSimulation::Restart()
+{
+	Time::GetInstance().ResetElapsedTime();
+	TimerSystem::GetInstance().Clear();
+	UI::Reset();
+	BuffCardManager::ResetCurrentBuffs();
+	LoadLevel(levelPath);
+}
+
+bool HeadlessSimulation::IsRunOver() const
+{
+	return player.IsDead() || player.GetPosition().y < -(float)ROOM_ROWS;
+}
+
+const char* HeadlessSimulation::GetStageName(Stage stage)
+{
+	switch (stage)
+	{
+	case Stage::Player:		return "Player";
+	case Stage::Rooms:		return "Rooms";
+	case Stage::Camera:		return "Camera";
+	case Stage::Enemies:	return "Enemies";
+	case Stage::Boss:		return "Boss";
+	case Stage::Attacks:	return "Attacks";
+	case Stage::Traps:		return "Traps";
+	case Stage::Particles:	return "Particles";
+	case Stage::DamageText:	return "DamageText";
+	case Stage::UI:			return "UI";
+	case Stage::Animation:	return "Animation";
+	case Stage::Timers:		return "Timers";
+	default:				return "Unknown";
+	}
+}
+
+void HeadlessSimulation::SetAssetWorkingDirectory(const char* exePath)
+{
+	namespace fs = std::filesystem;
+	std::error_code error;
+	const fs::path exeDir = fs::absolute(exePath, error).parent_path();
+	if (!error && fs::exists(exeDir / "Assets"))
+		fs::current_path(exeDir, error);
+}
+
+void HeadlessSimulation::ApplyScriptedInput(u32 frame)
+{
+	AEHeadless::ReleaseAllKeys();
+
+	const bool goRight = (frame / 600) % 2 == 0;
+	AEHeadless::SetKey(goRight ? AEVK_RIGHT : AEVK_LEFT, true);
+
+	if (frame % 90 < 20)
+		AEHeadless::SetKey(AEVK_SPACE, true);
+	if (frame % 45 < 10)
+		AEHeadless::SetKey(AEVK_X, true);
+	if (frame % 240 == 0)
+		AEHeadless::SetKey(AEVK_Z, true);
+}
+
+void HeadlessSimulation::Step(StageTimes* outTimes)
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (outTimes)
+		outTimes->fill(0.0);
+
+	// Runs fn, adding the time taken to the stage if timing is requested
+	auto runStage = [outTimes](Stage stage, auto&& fn)
+	{
+		if (!outTimes)
+		{
+			fn();
+			return;
+		}
+
+		const Clock::time_point start = Clock::now();
+		fn();
+		(*outTimes)[(int)stage] += std::chrono::duration<double>(Clock::now() - start).count();
+	};
+
+	// Same zone names as the game so traces can be compared
+	PROFILE_SCOPE("GSM::Update");
+	AESysFrameStart();
+	MemoryTracker::BeginFrame();
+	FrameArena::Reset();
+
+	// Debug shapes from the previous frame if it wasn't rendered
+	DebugDraw::Clear();
+
+	// Same fixed step as GSM::Update. With the frame time at the tick rate (--dt), it's 1 tick per Step
+	Time& time = Time::GetInstance();
+	time.BeginFrame();
+	while (time.BeginTick())
+	{
+		PROFILE_SCOPE("GameScene::FixedUpdate");
+
+		if (UI::IsBossIntroActive())
+		{
+			runStage(Stage::Camera, [this] { camera.Update(); });
+		}
+		else
+		{
+			float dt = static_cast<float>(time.GetScaledDeltaTime());
+
+			runStage(Stage::Player, [this] { player.Update(); });
+
+			bool continueTick = true;
+			runStage(Stage::Rooms, [&] {
+				continueTick = UpdateRoomTransition();
+				if (continueTick)
+					roomSystem.UpdatePrefetch();
+			});
+
+			if (continueTick)
+			{
+				runStage(Stage::Camera, [this] { camera.Update(); });
+
+				// Same as EnemyManager::UpdateAll(pos, facing, map), split to time the boss separately
+				const AEVec2 playerPos = player.GetPosition();
+				runStage(Stage::Enemies, [&] { enemyMgr.UpdateAll(playerPos, map); });
+				runStage(Stage::Boss, [&] {
+					if (EnemyBoss* boss = roomSystem.GetActiveBoss())
+						boss->Update(playerPos, player.GetIsFacingRight(), map);
+				});
+
+				runStage(Stage::Attacks, [this] {
+					attackSystem.UpdateEnemyAttack(player, enemyMgr, roomSystem.GetActiveBoss(), map);
+				});
+				runStage(Stage::Traps, [&] { trapMgr.Update(dt, player); });
+				runStage(Stage::Particles, [this] {
+					testParticleSystem.SetSpawnRate(AEInputCheckCurr(AEVK_F) ? 2000.f : 0.f);
+					testParticleSystem.Update();
+				});
+				runStage(Stage::DamageText, [] { UI::GetDamageTextSpawner().Update(); });
+			}
+		}
+
+		// Same place as GSM::Update
+		runStage(Stage::Animation, [] { Animator::Update(); });
+
+		time.EndTick();
+	}
+
+	{
+		PROFILE_SCOPE("GameScene::Update");
+
+		if (!UI::IsBossIntroActive())
+		{
+			player.LatchInput();
+
+			runStage(Stage::Particles, [this] {
+				if (AEInputCheckTriggered(AEVK_G))
+					testParticleSystem.SpawnParticleBurst(300);
+			});
+		}
+
+		runStage(Stage::UI, [] { UI::Update(); });
+	}
+
+	// Same place as GSM::Update
+	EventSystem::FlushQueued();
+
+	runStage(Stage::Timers, [&time] {
+		time.Update();
+		TimerSystem::GetInstance().Update();
+	});
+
+	AESysFrameEnd();
+}
+
+void HeadlessSimulation::Render()
+{
+	PROFILE_SCOPE("GameScene::Render");
+
+	Renderer::BeginFrame();
+
+	Background::Render();
+	map.Render();
+	testParticleSystem.Render();
+	trapMgr.Render();
+	player.Render();
+	if (roomSystem.GetActiveBoss())
+		roomSystem.GetActiveBoss()->Render();
+	enemyMgr.RenderAll();
+	// Same place as GameScene::Render
+	Renderer::Flush();
+	attackSystem.Render();
+	UI::Render();
+	Editor::DrawDebugShapes();
+}
+
+bool HeadlessSimulation::UpdateRoomTransition()
+{
+	// unlock only when player is back inside room bounds
+	if (roomTransitionLocked)
+	{
+		if (roomSystem.CheckRoomExit() == DIR_NONE)
+			roomTransitionLocked = false;
+	}
+
+	if (roomTransitionLocked)
+		return true;
+
+	RoomDirection exitDir = roomSystem.CheckRoomExit();
+	if (exitDir == DIR_NONE)
+		return true;
+
+	if (exitDir == roomSystem.GetBlockedReturnDir())
+		return false;
+
+	const RoomID previousRoom = roomMgr.GetCurrentRoomID();
+	const AEVec2 previousPos = player.GetPosition();
+
+	roomTransitionLocked = true;
+	if (!roomMgr.ChangeRoom(exitDir))
+		return false;
+
+	RoomDirection cameFrom = DIR_NONE;
+	BuffCardManager::IsRoomCleared() = true;
+	BuffCardScreen::ResetFlipSequence();
+
+	switch (exitDir)
+	{
+	case DIR_TOP:    cameFrom = DIR_BOTTOM; break;
+	case DIR_LEFT:   cameFrom = DIR_RIGHT;  break;
+	case DIR_BOTTOM: cameFrom = DIR_TOP;    break;
+	case DIR_RIGHT:  cameFrom = DIR_LEFT;   break;
+	default: break;
+	}
+
+	const RoomID nextRoom = roomMgr.GetCurrentRoomID();
+	const AEVec2 transitionSpawn = roomSystem.ComputeTransitionSpawn(previousRoom, nextRoom, previousPos);
+	roomSystem.SetBlockedReturnDir(cameFrom);
+	roomSystem.BuildCurrentRoom(cameFrom, &transitionSpawn);
+
+	++roomChanges;
+	return false;
+}
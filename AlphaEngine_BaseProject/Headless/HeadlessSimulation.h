@@ -0,0 +1,129 @@
+#pragma once
+#include <array>
+#include <string>
+
+#include "../Source/Game/Player/Player.h"
+#include "../Source/Game/Camera.h"
+#include "../Source/Game/Environment/MapGrid.h"
+#include "../Source/Game/Environment/traps.h"
+#include "../Source/Game/enemy/EnemyBoss.h"
+#include "../Source/Game/enemy/EnemyManager.h"
+#include "../Source/Game/enemy/AttackSystem.h"
+#include "../Source/Game/Rooms/RoomManager.h"
+#include "../Source/Game/Rooms/RoomSystem.h"
+#include "../Source/Utils/ParticleSystem.h"
+
+/**
+ * @brief	GameScene without the pause menu, audio music switching and scene changes.
+ *			Steps the same gameplay systems in the same order as GameScene::FixedUpdate / Update
+ *			so it can run headless at a fixed dt.
+ */
+class HeadlessSimulation
+{
+public:
+	/**
+	 * @brief	Parts of the frame that are timed separately, in update order.
+	 */
+	enum class Stage
+	{
+		Player,
+		Rooms,
+		Camera,
+		Enemies,
+		Boss,
+		Attacks,
+		Traps,
+		Particles,
+		DamageText,
+		UI,
+		Animation,
+		Timers,
+
+		Count
+	};
+	static constexpr int STAGE_COUNT = (int)Stage::Count;
+	static const char* GetStageName(Stage stage);
+
+	/**
+	 * @brief	Seconds spent in each stage for one frame. Skipped stages are 0.
+	 */
+	using StageTimes = std::array<double, STAGE_COUNT>;
+
+	HeadlessSimulation();
+	~HeadlessSimulation();
+
+	/**
+	 * @brief	Loads a .lvl file and builds the room graph, map and start room.
+	 *			Falls back to a flat room if the file can't be loaded (same as GameScene).
+	 * @param	levelPath	Path to the level, relative to the working directory
+	 * @return	True if the level was loaded from the file
+	 */
+	bool LoadLevel(const std::string& levelPath);
+
+	/**
+	 * @brief	Reloads the last level and resets the run (same as restarting from game over)
+	 */
+	void Restart();
+
+	/**
+	 * @brief	Runs one frame: engine frame start, fixed step gameplay ticks, per frame update, Time / TimerSystem update.
+	 *			Input for the frame must be set with AEHeadless::SetKey before calling.
+	 * @param	outTimes	If not null, filled with the time taken by each stage
+	 */
+	void Step(StageTimes* outTimes = nullptr);
+
+	/**
+	 * @brief	Runs GameScene's render path against the headless renderer.
+	 *			Optional, only needed to exercise the render code.
+	 */
+	void Render();
+
+	/**
+	 * @brief	Assets are loaded relative to the working directory.
+	 *			Same as MainMenuScene::Init, run from the executable's directory (Assets are copied there)
+	 * @param	exePath	argv[0]
+	 */
+	static void SetAssetWorkingDirectory(const char* exePath);
+
+	/**
+	 * @brief	Run right, turn around every few seconds, jump, attack and dash periodically.
+	 *			Used so runs exercise enemies, traps and combat without a player.
+	 * @param	frame	Current frame number
+	 */
+	static void ApplyScriptedInput(u32 frame);
+
+	/**
+	 * @brief	Whether the run should be restarted: player died or left the level.
+	 *			(Room 1 has an open left side, scripted input can walk out of the level)
+	 */
+	bool IsRunOver() const;
+
+	const Player& GetPlayer() const { return player; }
+	const RoomManager& GetRoomManager() const { return roomMgr; }
+	const EnemyManager& GetEnemyManager() const { return enemyMgr; }
+	EnemyManager& GetEnemyManager() { return enemyMgr; }
+	MapGrid& GetMap() { return map; }
+	u32 GetRoomChanges() const { return roomChanges; }
+
+private:
+	/**
+	 * @brief	Checks for room exits and builds the next room.
+	 * @return	False if the room changed / is blocked. Rest of the frame is skipped, same as GameScene.
+	 */
+	bool UpdateRoomTransition();
+
+	MapGrid map;
+	Player player;
+	Camera camera;
+	EnemyBoss enemyBoss;
+	ParticleSystem testParticleSystem;
+	TrapManager trapMgr;
+	EnemyManager enemyMgr;
+	AttackSystem attackSystem;
+	RoomManager roomMgr;
+	RoomSystem roomSystem;
+
+	std::string levelPath;
+	bool roomTransitionLocked = false;
+	u32 roomChanges = 0;
+};
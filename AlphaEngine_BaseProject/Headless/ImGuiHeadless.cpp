@@ -0,0 +1,45 @@
+/**
+ * @file	ImGuiHeadless.cpp
+ * @brief	Replaces the Win32 / OpenGL3 ImGui backends for headless builds.
+ *
+ *			GSM and Editor call into the platform / renderer backends directly.
+ *			These versions keep ImGui's IO in sync with the headless engine and
+ *			discard the draw data.
+ */
+#include <imgui.h>
+#include <imgui_impl_win32.h>
+#include <imgui_impl_opengl3.h>
+
+#include "AEHeadless.h"
+
+// ===========================================================================
+// Platform backend
+// ===========================================================================
+
+bool ImGui_ImplWin32_Init(void*) { return true; }
+bool ImGui_ImplWin32_InitForOpenGL(void*) { return true; }
+void ImGui_ImplWin32_Shutdown() {}
+
+void ImGui_ImplWin32_NewFrame()
+{
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2((float)AEGfxGetWindowWidth(), (float)AEGfxGetWindowHeight());
+	io.DeltaTime = (float)AEHeadless::GetFrameTime();
+}
+
+void ImGui_ImplWin32_EnableDpiAwareness() {}
+float ImGui_ImplWin32_GetDpiScaleForHwnd(void*) { return 1.f; }
+float ImGui_ImplWin32_GetDpiScaleForMonitor(void*) { return 1.f; }
+void ImGui_ImplWin32_EnableAlphaCompositing(void*) {}
+
+// ===========================================================================
+// Renderer backend
+// ===========================================================================
+
+bool ImGui_ImplOpenGL3_Init(const char*) { return true; }
+void ImGui_ImplOpenGL3_Shutdown() {}
+void ImGui_ImplOpenGL3_NewFrame() {}
+void ImGui_ImplOpenGL3_RenderDrawData(ImDrawData*) {}
+bool ImGui_ImplOpenGL3_CreateDeviceObjects() { return true; }
+void ImGui_ImplOpenGL3_DestroyDeviceObjects() {}
+void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData*) {}
@@ -0,0 +1,75 @@
+/**
+ * @file	LevelCompiler.cpp
+ * @brief	Compiles text levels (.lvl) into the binary format (.lvlb) loaded by LoadLevelFromFile.
+ *
+ *	Usage: LevelCompiler <file.lvl | folder>...
+ *
+ *	Each .lvl is written to a .lvlb next to it. Folders compile every .lvl inside (not recursive).
+ *	Returns 1 if any level failed to compile.
+ */
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../Source/Game/Scene/LevelIO.h"
+
+namespace
+{
+	namespace fs = std::filesystem;
+
+	std::vector<fs::path> FindLevels(const fs::path& input)
+	{
+		std::vector<fs::path> levels;
+
+		std::error_code error;
+		if (!fs::is_directory(input, error))
+		{
+			levels.push_back(input);
+			return levels;
+		}
+
+		for (const fs::directory_entry& entry : fs::directory_iterator(input, error))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".lvl")
+				levels.push_back(entry.path());
+		}
+		return levels;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cout << "Usage: " << argv[0] << " <file.lvl | folder>...\n";
+		return 1;
+	}
+
+	int compiled = 0, failed = 0;
+	for (int i = 1; i < argc; ++i)
+	{
+		for (const fs::path& level : FindLevels(argv[i]))
+		{
+			const std::string source = level.generic_string();
+			const std::string output = GetCompiledLevelPath(source);
+
+			if (CompileLevelFile(source.c_str(), output.c_str()))
+			{
+				++compiled;
+			}
+			else
+			{
+				std::cout << "[LevelCompiler] Failed to compile " << source << "\n";
+				++failed;
+			}
+		}
+	}
+
+	std::cout << "[LevelCompiler] Compiled " << compiled << " level(s)";
+	if (failed > 0)
+		std::cout << ", " << failed << " failed";
+	std::cout << "\n";
+
+	return failed > 0 ? 1 : 0;
+}
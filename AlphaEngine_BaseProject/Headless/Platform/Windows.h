@@ -0,0 +1,3 @@
+#pragma once
+// Case-sensitive file systems: some sources include <Windows.h>
+#include "windows.h"
@@ -0,0 +1,162 @@
+#pragma once
+/**
+ * @file	windows.h
+ * @brief	Minimal stand-in for <windows.h> used by the headless build.
+ *
+ *			AEEngine.h (and a few gameplay headers) include <windows.h> for
+ *			the Win32 handle types, the VK_* key codes and the min/max macros.
+ *			This header provides just enough of that surface for the game
+ *			sources to compile unchanged on non-Windows platforms.
+ *			It is only on the include path of the headless CMake targets.
+ */
+
+#ifndef _WIN32
+
+#include <cstdio>
+#include <cstdarg>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// AEExport.h marks the whole engine API as __declspec(dllexport)
+#ifndef __declspec
+#define __declspec(x)
+#endif
+
+#ifndef CALLBACK
+#define CALLBACK
+#endif
+
+#ifndef WINAPI
+#define WINAPI
+#endif
+
+typedef void*			HANDLE;
+typedef void*			HWND;
+typedef void*			HINSTANCE;
+typedef void*			HMONITOR;
+typedef unsigned int	UINT;
+typedef unsigned long	DWORD;
+typedef int				BOOL;
+typedef uintptr_t		WPARAM;
+typedef intptr_t		LPARAM;
+typedef intptr_t		LRESULT;
+
+#ifndef TRUE
+#define TRUE 1
+#endif
+#ifndef FALSE
+#define FALSE 0
+#endif
+
+// Only used by the AE_ASSERT family of macros
+#define MB_OK 0x00000000L
+inline int MessageBox(void*, const char* text, const char* caption, unsigned int)
+{
+	std::fprintf(stderr, "[%s] %s\n", caption, text);
+	return 0;
+}
+
+// Module / working directory helpers used by the menu scene
+#define MAX_PATH 260
+inline DWORD GetModuleFileNameA(HANDLE, char* buffer, DWORD size)
+{
+	ssize_t length = readlink("/proc/self/exe", buffer, size ? size - 1 : 0);
+	if (length < 0)
+		length = 0;
+	if (size)
+		buffer[length] = '\0';
+	return static_cast<DWORD>(length);
+}
+
+inline BOOL CreateDirectoryA(const char* path, void*)
+{
+	return mkdir(path, 0755) == 0;
+}
+
+inline BOOL SetCurrentDirectoryA(const char* path)
+{
+	return chdir(path) == 0;
+}
+
+// MSVC secure CRT variants used by the game
+template <size_t Size>
+inline int sprintf_s(char (&buffer)[Size], const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int result = std::vsnprintf(buffer, Size, format, args);
+	va_end(args);
+	return result;
+}
+
+// Virtual key codes referenced by AEInput.h
+#define VK_LBUTTON		0x01
+#define VK_RBUTTON		0x02
+#define VK_MBUTTON		0x04
+#define VK_BACK			0x08
+#define VK_TAB			0x09
+#define VK_RETURN		0x0D
+#define VK_PAUSE		0x13
+#define VK_CAPITAL		0x14
+#define VK_ESCAPE		0x1B
+#define VK_SPACE		0x20
+#define VK_PRIOR		0x21
+#define VK_NEXT			0x22
+#define VK_END			0x23
+#define VK_HOME			0x24
+#define VK_LEFT			0x25
+#define VK_UP			0x26
+#define VK_RIGHT		0x27
+#define VK_DOWN			0x28
+#define VK_SNAPSHOT		0x2C
+#define VK_INSERT		0x2D
+#define VK_DELETE		0x2E
+#define VK_NUMPAD0		0x60
+#define VK_NUMPAD1		0x61
+#define VK_NUMPAD2		0x62
+#define VK_NUMPAD3		0x63
+#define VK_NUMPAD4		0x64
+#define VK_NUMPAD5		0x65
+#define VK_NUMPAD6		0x66
+#define VK_NUMPAD7		0x67
+#define VK_NUMPAD8		0x68
+#define VK_NUMPAD9		0x69
+#define VK_MULTIPLY		0x6A
+#define VK_ADD			0x6B
+#define VK_SUBTRACT		0x6D
+#define VK_DECIMAL		0x6E
+#define VK_DIVIDE		0x6F
+#define VK_F1			0x70
+#define VK_F2			0x71
+#define VK_F3			0x72
+#define VK_F4			0x73
+#define VK_F5			0x74
+#define VK_F6			0x75
+#define VK_F7			0x76
+#define VK_F8			0x77
+#define VK_F9			0x78
+#define VK_F10			0x79
+#define VK_F11			0x7A
+#define VK_F12			0x7B
+#define VK_NUMLOCK		0x90
+#define VK_SCROLL		0x91
+#define VK_LSHIFT		0xA0
+#define VK_RSHIFT		0xA1
+#define VK_LCONTROL		0xA2
+#define VK_RCONTROL		0xA3
+#define VK_LMENU		0xA4
+#define VK_RMENU		0xA5
+#define VK_OEM_1		0xBA
+#define VK_OEM_PLUS		0xBB
+#define VK_OEM_COMMA	0xBC
+#define VK_OEM_MINUS	0xBD
+#define VK_OEM_PERIOD	0xBE
+#define VK_OEM_2		0xBF
+#define VK_OEM_3		0xC0
+#define VK_OEM_4		0xDB
+#define VK_OEM_5		0xDC
+#define VK_OEM_6		0xDD
+#define VK_OEM_7		0xDE
+
+#endif // _WIN32
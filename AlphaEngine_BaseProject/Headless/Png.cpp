@@ -0,0 +1,625 @@
+#include "Png.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace
+{
+	const u8 SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	// Deflate length / distance codes (RFC 1951 3.2.5)
+	const u16 LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const u8 LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const u16 DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const u8 DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	// ---------------------------------------------------------------------------
+	// Checksums
+	// ---------------------------------------------------------------------------
+	u32 Crc32(const u8* data, size_t size, u32 crc = 0)
+	{
+		static u32 table[256];
+		static bool isTableBuilt = false;
+		if (!isTableBuilt)
+		{
+			for (u32 i = 0; i < 256; ++i)
+			{
+				u32 c = i;
+				for (int k = 0; k < 8; ++k)
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				table[i] = c;
+			}
+			isTableBuilt = true;
+		}
+
+		crc = ~crc;
+		for (size_t i = 0; i < size; ++i)
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	u32 Adler32(const std::vector<u8>& data)
+	{
+		u32 a = 1, b = 0;
+		for (u8 byte : data)
+		{
+			a = (a + byte) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+	u32 ReadU32(const u8* data)
+	{
+		return ((u32)data[0] << 24) | ((u32)data[1] << 16) | ((u32)data[2] << 8) | data[3];
+	}
+
+	void WriteU32(std::vector<u8>& out, u32 value)
+	{
+		out.push_back((u8)(value >> 24));
+		out.push_back((u8)(value >> 16));
+		out.push_back((u8)(value >> 8));
+		out.push_back((u8)value);
+	}
+
+	// ---------------------------------------------------------------------------
+	// Inflate
+	// ---------------------------------------------------------------------------
+	struct BitReader
+	{
+		const u8* data;
+		size_t size;
+		size_t pos = 0;
+		u32 bitBuffer = 0;
+		int bitCount = 0;
+		bool isError = false;
+
+		int Bits(int count)
+		{
+			while (bitCount < count)
+			{
+				if (pos >= size)
+				{
+					isError = true;
+					return 0;
+				}
+				bitBuffer |= (u32)data[pos++] << bitCount;
+				bitCount += 8;
+			}
+
+			const int value = (int)(bitBuffer & ((1u << count) - 1));
+			bitBuffer >>= count;
+			bitCount -= count;
+			return value;
+		}
+	};
+
+	// Canonical Huffman code, decoded 1 bit at a time
+	struct Huffman
+	{
+		u16 counts[16]{};	// Number of codes of each length
+		u16 symbols[288]{};	// Symbols ordered by code
+
+		void Build(const u8* lengths, int count)
+		{
+			std::memset(counts, 0, sizeof(counts));
+			for (int i = 0; i < count; ++i)
+				++counts[lengths[i]];
+			counts[0] = 0;
+
+			u16 offsets[16]{};
+			for (int length = 1; length < 15; ++length)
+				offsets[length + 1] = offsets[length] + counts[length];
+
+			for (int i = 0; i < count; ++i)
+			{
+				if (lengths[i])
+					symbols[offsets[lengths[i]]++] = (u16)i;
+			}
+		}
+
+		int Decode(BitReader& reader) const
+		{
+			int code = 0, first = 0, index = 0;
+			for (int length = 1; length < 16; ++length)
+			{
+				code |= reader.Bits(1);
+				const int count = counts[length];
+				if (code - count < first)
+					return symbols[index + (code - first)];
+
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+			return -1;
+		}
+	};
+
+	bool InflateCodes(BitReader& reader, const Huffman& lengthCode, const Huffman& distCode, std::vector<u8>& out)
+	{
+		while (!reader.isError)
+		{
+			int symbol = lengthCode.Decode(reader);
+			if (symbol < 0)
+				return false;
+
+			if (symbol < 256)
+			{
+				out.push_back((u8)symbol);
+				continue;
+			}
+			if (symbol == 256)
+				return true;
+
+			symbol -= 257;
+			if (symbol >= 29)
+				return false;
+			const int length = LENGTH_BASE[symbol] + reader.Bits(LENGTH_EXTRA[symbol]);
+
+			const int distSymbol = distCode.Decode(reader);
+			if (distSymbol < 0 || distSymbol >= 30)
+				return false;
+			const size_t dist = DIST_BASE[distSymbol] + reader.Bits(DIST_EXTRA[distSymbol]);
+			if (dist > out.size())
+				return false;
+
+			// Byte by byte, the copy can overlap what it writes
+			const size_t from = out.size() - dist;
+			for (int i = 0; i < length; ++i)
+				out.push_back(out[from + i]);
+		}
+		return false;
+	}
+
+	bool Inflate(const u8* data, size_t size, std::vector<u8>& out)
+	{
+		BitReader reader{ data, size };
+
+		int isLast = 0;
+		while (!isLast)
+		{
+			isLast = reader.Bits(1);
+			const int type = reader.Bits(2);
+
+			if (type == 0)
+			{
+				// Stored, starts at the next byte
+				reader.bitBuffer = 0;
+				reader.bitCount = 0;
+				if (reader.pos + 4 > size)
+					return false;
+
+				const u32 length = data[reader.pos] | (data[reader.pos + 1] << 8);
+				reader.pos += 4;
+				if (reader.pos + length > size)
+					return false;
+
+				out.insert(out.end(), data + reader.pos, data + reader.pos + length);
+				reader.pos += length;
+			}
+			else if (type == 1)
+			{
+				static Huffman fixedLengthCode, fixedDistCode;
+				static bool isFixedBuilt = false;
+				if (!isFixedBuilt)
+				{
+					u8 lengths[288];
+					std::memset(lengths, 8, 144);
+					std::memset(lengths + 144, 9, 112);
+					std::memset(lengths + 256, 7, 24);
+					std::memset(lengths + 280, 8, 8);
+					fixedLengthCode.Build(lengths, 288);
+
+					std::memset(lengths, 5, 30);
+					fixedDistCode.Build(lengths, 30);
+					isFixedBuilt = true;
+				}
+
+				if (!InflateCodes(reader, fixedLengthCode, fixedDistCode, out))
+					return false;
+			}
+			else if (type == 2)
+			{
+				const int lengthCount = reader.Bits(5) + 257;
+				const int distCount = reader.Bits(5) + 1;
+				const int codeCount = reader.Bits(4) + 4;
+				if (lengthCount > 286 || distCount > 30)
+					return false;
+
+				static const u8 CODE_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+				u8 lengths[320]{};
+				for (int i = 0; i < codeCount; ++i)
+					lengths[CODE_ORDER[i]] = (u8)reader.Bits(3);
+
+				Huffman codeLengthCode;
+				codeLengthCode.Build(lengths, 19);
+
+				int index = 0;
+				while (index < lengthCount + distCount)
+				{
+					const int symbol = codeLengthCode.Decode(reader);
+					if (symbol < 0 || reader.isError)
+						return false;
+
+					if (symbol < 16)
+					{
+						lengths[index++] = (u8)symbol;
+						continue;
+					}
+
+					u8 repeatLength = 0;
+					int repeat;
+					if (symbol == 16)
+					{
+						if (index == 0)
+							return false;
+						repeatLength = lengths[index - 1];
+						repeat = 3 + reader.Bits(2);
+					}
+					else if (symbol == 17)
+						repeat = 3 + reader.Bits(3);
+					else
+						repeat = 11 + reader.Bits(7);
+
+					if (index + repeat > lengthCount + distCount)
+						return false;
+					while (repeat--)
+						lengths[index++] = repeatLength;
+				}
+
+				Huffman lengthCode, distCode;
+				lengthCode.Build(lengths, lengthCount);
+				distCode.Build(lengths + lengthCount, distCount);
+
+				if (!InflateCodes(reader, lengthCode, distCode, out))
+					return false;
+			}
+			else
+				return false;
+
+			if (reader.isError)
+				return false;
+		}
+		return true;
+	}
+
+	// ---------------------------------------------------------------------------
+	// Deflate. Fixed Huffman codes with a hash chain match finder, good enough for generated assets
+	// ---------------------------------------------------------------------------
+	struct BitWriter
+	{
+		std::vector<u8>& out;
+		u32 bitBuffer = 0;
+		int bitCount = 0;
+
+		void Bits(u32 value, int count)
+		{
+			bitBuffer |= value << bitCount;
+			bitCount += count;
+			while (bitCount >= 8)
+			{
+				out.push_back((u8)bitBuffer);
+				bitBuffer >>= 8;
+				bitCount -= 8;
+			}
+		}
+
+		// Huffman codes are stored from the most significant bit
+		void Code(u32 code, int length)
+		{
+			u32 reversed = 0;
+			for (int i = 0; i < length; ++i)
+				reversed |= ((code >> i) & 1) << (length - 1 - i);
+			Bits(reversed, length);
+		}
+
+		void Flush()
+		{
+			if (bitCount > 0)
+				out.push_back((u8)bitBuffer);
+			bitBuffer = 0;
+			bitCount = 0;
+		}
+	};
+
+	void WriteFixedLiteral(BitWriter& writer, int symbol)
+	{
+		if (symbol < 144)
+			writer.Code(0x30 + symbol, 8);
+		else if (symbol < 256)
+			writer.Code(0x190 + symbol - 144, 9);
+		else if (symbol < 280)
+			writer.Code(symbol - 256, 7);
+		else
+			writer.Code(0xC0 + symbol - 280, 8);
+	}
+
+	void WriteMatch(BitWriter& writer, int length, int dist)
+	{
+		int lengthIndex = 28;
+		while (LENGTH_BASE[lengthIndex] > length)
+			--lengthIndex;
+		WriteFixedLiteral(writer, 257 + lengthIndex);
+		writer.Bits(length - LENGTH_BASE[lengthIndex], LENGTH_EXTRA[lengthIndex]);
+
+		int distIndex = 29;
+		while (DIST_BASE[distIndex] > dist)
+			--distIndex;
+		writer.Code(distIndex, 5);
+		writer.Bits(dist - DIST_BASE[distIndex], DIST_EXTRA[distIndex]);
+	}
+
+	void Deflate(const std::vector<u8>& data, std::vector<u8>& out)
+	{
+		constexpr int WINDOW_SIZE = 32768;
+		constexpr int MIN_MATCH = 3;
+		constexpr int MAX_MATCH = 258;
+		constexpr int HASH_BITS = 15;
+		constexpr int MAX_CHAIN = 32;
+
+		// Most recent position of each hash, and the position before it with the same hash
+		std::vector<int> head(1 << HASH_BITS, -1);
+		std::vector<int> previous(WINDOW_SIZE, -1);
+		auto hash = [&data](size_t i) {
+			return ((data[i] << 10) ^ (data[i + 1] << 5) ^ data[i + 2]) & ((1 << HASH_BITS) - 1);
+		};
+		auto insert = [&](size_t i) {
+			if (i + MIN_MATCH > data.size())
+				return;
+			const int h = hash(i);
+			previous[i % WINDOW_SIZE] = head[h];
+			head[h] = (int)i;
+		};
+
+		BitWriter writer{ out };
+		writer.Bits(1, 1);	// Last block
+		writer.Bits(1, 2);	// Fixed Huffman
+
+		size_t i = 0;
+		while (i < data.size())
+		{
+			int bestLength = 0, bestDist = 0;
+			if (i + MIN_MATCH <= data.size())
+			{
+				const int maxLength = (int)(std::min)((size_t)MAX_MATCH, data.size() - i);
+				int candidate = head[hash(i)];
+				for (int chain = 0; chain < MAX_CHAIN && candidate >= 0 && (int)i - candidate <= WINDOW_SIZE; ++chain)
+				{
+					int length = 0;
+					while (length < maxLength && data[candidate + length] == data[i + length])
+						++length;
+
+					if (length > bestLength)
+					{
+						bestLength = length;
+						bestDist = (int)i - candidate;
+						if (length == maxLength)
+							break;
+					}
+					candidate = previous[candidate % WINDOW_SIZE];
+				}
+			}
+
+			if (bestLength >= MIN_MATCH)
+			{
+				WriteMatch(writer, bestLength, bestDist);
+				for (int k = 0; k < bestLength; ++k)
+					insert(i + k);
+				i += bestLength;
+			}
+			else
+			{
+				WriteFixedLiteral(writer, data[i]);
+				insert(i);
+				++i;
+			}
+		}
+
+		WriteFixedLiteral(writer, 256);
+		writer.Flush();
+	}
+
+	// ---------------------------------------------------------------------------
+	// Filters
+	// ---------------------------------------------------------------------------
+	u8 Paeth(int a, int b, int c)
+	{
+		const int p = a + b - c;
+		const int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+		if (pa <= pb && pa <= pc)
+			return (u8)a;
+		return (u8)(pb <= pc ? b : c);
+	}
+
+	// Filter type 0-4 applied to 1 byte. left / up / upLeft are the raw bytes
+	u8 FilterPredict(int type, u8 left, u8 up, u8 upLeft)
+	{
+		switch (type)
+		{
+		case 1: return left;
+		case 2: return up;
+		case 3: return (u8)((left + up) / 2);
+		case 4: return Paeth(left, up, upLeft);
+		default: return 0;
+		}
+	}
+
+	bool ReadFile(const std::string& file, std::vector<u8>& out)
+	{
+		std::ifstream stream(file, std::ios::binary);
+		if (!stream)
+			return false;
+		out.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	void WriteChunk(std::vector<u8>& out, const char* type, const std::vector<u8>& data)
+	{
+		WriteU32(out, (u32)data.size());
+		const size_t typeStart = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data.begin(), data.end());
+		WriteU32(out, Crc32(&out[typeStart], out.size() - typeStart));
+	}
+}
+
+bool Png::Load(const std::string& file, Image& outImage)
+{
+	std::vector<u8> bytes;
+	if (!ReadFile(file, bytes))
+	{
+		std::cout << "[Png] Can't open " << file << "\n";
+		return false;
+	}
+
+	if (bytes.size() < 8 || std::memcmp(bytes.data(), SIGNATURE, 8) != 0)
+	{
+		std::cout << "[Png] Not a PNG: " << file << "\n";
+		return false;
+	}
+
+	u32 width = 0, height = 0;
+	int channels = 0;
+	std::vector<u8> compressed;
+	size_t pos = 8;
+	while (pos + 12 <= bytes.size())
+	{
+		const u32 length = ReadU32(&bytes[pos]);
+		const char* type = (const char*)&bytes[pos + 4];
+		const u8* data = &bytes[pos + 8];
+		if (pos + 12 + length > bytes.size())
+			break;
+
+		if (!std::memcmp(type, "IHDR", 4))
+		{
+			width = ReadU32(data);
+			height = ReadU32(data + 4);
+			const u8 bitDepth = data[8], colorType = data[9], interlace = data[12];
+			if (bitDepth != 8 || (colorType != 2 && colorType != 6) || interlace != 0)
+			{
+				std::cout << "[Png] Only 8 bit non interlaced RGB / RGBA is supported: " << file << "\n";
+				return false;
+			}
+			channels = colorType == 6 ? 4 : 3;
+		}
+		else if (!std::memcmp(type, "IDAT", 4))
+			compressed.insert(compressed.end(), data, data + length);
+		else if (!std::memcmp(type, "IEND", 4))
+			break;
+
+		pos += 12 + length;
+	}
+
+	// Skip the 2 byte zlib header, the adler checksum at the end isn't checked
+	std::vector<u8> filtered;
+	if (channels == 0 || compressed.size() < 2 || (compressed[0] & 0x0F) != 8 ||
+		!Inflate(compressed.data() + 2, compressed.size() - 2, filtered))
+	{
+		std::cout << "[Png] Failed to decompress " << file << "\n";
+		return false;
+	}
+
+	const size_t stride = (size_t)width * channels;
+	if (filtered.size() < (stride + 1) * height)
+	{
+		std::cout << "[Png] Image data is too short: " << file << "\n";
+		return false;
+	}
+
+	// Undo the filters in place
+	std::vector<u8> raw(stride * height);
+	for (u32 y = 0; y < height; ++y)
+	{
+		const int filter = filtered[y * (stride + 1)];
+		const u8* in = &filtered[y * (stride + 1) + 1];
+		u8* row = &raw[y * stride];
+		const u8* previousRow = y > 0 ? &raw[(y - 1) * stride] : nullptr;
+
+		for (size_t i = 0; i < stride; ++i)
+		{
+			const u8 left = i >= (size_t)channels ? row[i - channels] : 0;
+			const u8 up = previousRow ? previousRow[i] : 0;
+			const u8 upLeft = (previousRow && i >= (size_t)channels) ? previousRow[i - channels] : 0;
+			row[i] = (u8)(in[i] + FilterPredict(filter, left, up, upLeft));
+		}
+	}
+
+	outImage.width = width;
+	outImage.height = height;
+	outImage.pixels.resize((size_t)width * height * 4);
+	for (size_t i = 0; i < (size_t)width * height; ++i)
+	{
+		for (int c = 0; c < 3; ++c)
+			outImage.pixels[i * 4 + c] = raw[i * channels + c];
+		outImage.pixels[i * 4 + 3] = channels == 4 ? raw[i * 4 + 3] : 255;
+	}
+	return true;
+}
+
+bool Png::Save(const std::string& file, const Image& image)
+{
+	const size_t stride = (size_t)image.width * 4;
+
+	// Pick the filter with the smallest sum of differences for each row
+	std::vector<u8> filtered;
+	filtered.reserve((stride + 1) * image.height);
+	std::vector<u8> candidate(stride), best(stride);
+	for (u32 y = 0; y < image.height; ++y)
+	{
+		const u8* row = &image.pixels[y * stride];
+		const u8* previousRow = y > 0 ? &image.pixels[(y - 1) * stride] : nullptr;
+
+		int bestFilter = 0;
+		u64 bestScore = UINT64_MAX;
+		for (int filter = 0; filter < 5; ++filter)
+		{
+			u64 score = 0;
+			for (size_t i = 0; i < stride; ++i)
+			{
+				const u8 left = i >= 4 ? row[i - 4] : 0;
+				const u8 up = previousRow ? previousRow[i] : 0;
+				const u8 upLeft = (previousRow && i >= 4) ? previousRow[i - 4] : 0;
+				candidate[i] = (u8)(row[i] - FilterPredict(filter, left, up, upLeft));
+				score += (u64)std::abs((int)(s8)candidate[i]);
+			}
+
+			if (score < bestScore)
+			{
+				bestScore = score;
+				bestFilter = filter;
+				best.swap(candidate);
+			}
+		}
+
+		filtered.push_back((u8)bestFilter);
+		filtered.insert(filtered.end(), best.begin(), best.end());
+	}
+
+	std::vector<u8> zlib = { 0x78, 0x01 };
+	Deflate(filtered, zlib);
+	WriteU32(zlib, Adler32(filtered));
+
+	std::vector<u8> header;
+	WriteU32(header, image.width);
+	WriteU32(header, image.height);
+	header.insert(header.end(), { 8, 6, 0, 0, 0 });	// 8 bit RGBA, not interlaced
+
+	std::vector<u8> bytes(SIGNATURE, SIGNATURE + 8);
+	WriteChunk(bytes, "IHDR", header);
+	WriteChunk(bytes, "IDAT", zlib);
+	WriteChunk(bytes, "IEND", {});
+
+	std::ofstream stream(file, std::ios::binary);
+	if (!stream.write((const char*)bytes.data(), bytes.size()))
+	{
+		std::cout << "[Png] Can't write " << file << "\n";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "AETypes.h"
+
+/**
+ * @brief	Minimal PNG reading / writing for the offline tools (AtlasBuilder).
+ *			Only 8 bit, non interlaced RGB / RGBA images, which is what the game's art is exported as.
+ *			The game itself still loads textures with AEGfxTextureLoad.
+ */
+namespace Png
+{
+	struct Image
+	{
+		u32 width = 0;
+		u32 height = 0;
+		std::vector<u8> pixels;	// RGBA, row major from the top row
+
+		u8* At(u32 x, u32 y) { return &pixels[((size_t)y * width + x) * 4]; }
+		const u8* At(u32 x, u32 y) const { return &pixels[((size_t)y * width + x) * 4]; }
+	};
+
+	/**
+	 * @brief	Reads a PNG. RGB images are converted to RGBA
+	 * @return	false and prints the reason if the file can't be read or the format isn't supported
+	 */
+	bool Load(const std::string& file, Image& outImage);
+
+	bool Save(const std::string& file, const Image& image);
+}
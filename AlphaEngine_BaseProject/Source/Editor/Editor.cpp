@@ -6,6 +6,9 @@
 #include "../Utils/AEExtras.h"
 #include "../Utils/FileHelper.h"
 #include "../Game/Time.h"
+#include "../Utils/Profiler.h"
+#include "../Utils/MemoryTracker.h"
+#include "../Utils/DebugDraw.h"
 
 #undef GetObject
 
@@ -46,6 +49,7 @@ const Editor::EditorPrefs& Editor::GetEditorPrefs()
 
 void Editor::Update()
 {
+	MEMORY_SCOPE(Editor);
 	Editor& instance = Get();
 	if (AEInputCheckTriggered(AEVK_TAB))
 		instance.showInspectors = !instance.showInspectors;
@@ -82,6 +86,7 @@ void Editor::Update()
 
 void Editor::DrawInspectors()
 {
+	MEMORY_SCOPE(Editor);
 	Editor& instance = Get();
 
 	if (instance.showInspectors)
@@ -105,6 +110,16 @@ void Editor::DrawInspectors()
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 }
 
+void Editor::DrawDebugShapes()
+{
+	PROFILE_SCOPE("Editor::DrawDebugShapes");
+
+	if (Get().showColliders)
+		DebugDraw::Flush();
+	else
+		DebugDraw::Clear();
+}
+
 bool Editor::GetShowColliders()
 {
 	return Get().showColliders;
@@ -160,6 +175,14 @@ void Editor::DrawMenus()
 			ImGui::MenuItem("Show colliders", "Ctrl", &instance.showColliders);
 			ImGui::MenuItem("Show Demo Window", NULL, &instance.showDemoWindow);
 
+			ImGui::Separator();
+			if (ImGui::MenuItem("Record Profiler", NULL, Profiler::IsRecording()))
+				Profiler::SetRecording(!Profiler::IsRecording());
+			if (ImGui::MenuItem("Export Profiler Trace", NULL, false, Profiler::GetEventCount() > 0))
+				Profiler::ExportChromeTrace(profilerTracePath);
+			if (ImGui::MenuItem("Dump Memory Stats", NULL, false, MemoryTracker::IsEnabled()))
+				MemoryTracker::Dump();
+
 			ImGui::EndMenu();
 		}
 
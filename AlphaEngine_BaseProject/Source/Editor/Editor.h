@@ -30,10 +30,18 @@ public:
 	static void Update();
 	static void DrawInspectors();
 
+	/**
+	 * @brief	Draws the DebugDraw shapes recorded this frame if showing colliders, then clears them.
+	 *			Call after the scene renders so the shapes are on top.
+	 */
+	static void DrawDebugShapes();
+
 	static bool GetShowColliders();
 private:
 
 	inline static std::string editorPrefsPath = "Assets/Editor/prefs.json";
+	// Open in chrome://tracing or https://ui.perfetto.dev
+	inline static std::string profilerTracePath = "profiler_trace.json";
 	EditorPrefs editorPrefs;
 
 	bool showInspectors = false;
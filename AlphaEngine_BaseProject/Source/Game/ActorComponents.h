@@ -0,0 +1,27 @@
+#pragma once
+#include "AEEngine.h"
+
+// Components shared by actors stored in a ComponentTable (see enemy/EnemyComponents.h)
+
+/**
+ * @brief	Where the actor is. The hurtbox is centered on position
+ */
+struct Transform
+{
+	AEVec2 position{ 0.f, 0.f };
+	AEVec2 size{ 0.8f, 0.8f };		// Full size of the hurtbox
+	AEVec2 previousPosition{ 0.f, 0.f };	// Position before the last tick, for render interpolation
+};
+
+struct Motion
+{
+	AEVec2 velocity{ 0.f, 0.f };
+	AEVec2 facing{ 1.f, 0.f };
+};
+
+struct Health
+{
+	int hp = 1;
+	int maxHp = 10;
+	bool dead = false;
+};
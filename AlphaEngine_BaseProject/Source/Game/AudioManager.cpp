@@ -4,6 +4,7 @@
 #include <iostream>
 #include "../Game/Time.h"
 #include "../Game/Rooms/RoomData.h"
+#include "../Utils/MemoryTracker.h"
 
 // Declare background music.
 std::unique_ptr<BGMAudio> AudioManager::bossIntroMusic = nullptr;
@@ -143,6 +144,7 @@ SFXAudio::~SFXAudio() { // Dtor for automatic cleanup
     }
 }
 void AudioManager::PlayBossMusic(EnemyBoss const& boss, RoomManager const& roomMgr) {
+    MEMORY_SCOPE(Audio);
     // For the first time, play both tracks together so they sync perfectly and align
     // with crossfade effect.
 
@@ -153,7 +155,7 @@ void AudioManager::PlayBossMusic(EnemyBoss const& boss, RoomManager const& roomM
         bossFightMusic->Play(0.0f);
         bossFightMusic->SetActive(true);
     }
-    if (roomMgr.GetCurrentRoomID() == ROOM_11) {
+    if (roomMgr.IsBossRoom(roomMgr.GetCurrentRoomID())) {
         // Triggered boss phase 2
         if (boss.phase2 && !gIsPlaying) { // To remove check triggered when rooms are spawned properly.
             std::cout << "2ND PHASE" << '\n';
@@ -191,6 +193,7 @@ void AudioManager::RefreshAllMusicVolumes()
         gameMusic->ApplyFinalVolume();
 }
 void AudioManager::PlaySFX(SFXAudio const& sfx, f32 const& pitch) {
+    MEMORY_SCOPE(Audio);
     const AEAudio& audio = sfx.GetAudio();
     if (AEAudioIsValidAudio(audio))
     {
@@ -203,6 +206,7 @@ void AudioManager::PlaySFX(SFXAudio const& sfx, f32 const& pitch) {
 |                                                  |
 --------------------------------------------------*/
 void AudioManager::Init() {
+    MEMORY_SCOPE(Audio);
     if (!AEAudioIsValidGroup(gMusicGroup)) {
         gMusicGroup = AEAudioCreateGroup();
     }
@@ -240,6 +244,7 @@ void AudioManager::Init() {
 }
 
 void AudioManager::Update() {
+    MEMORY_SCOPE(Audio);
     // Update crossfade variables for volumes of fadein and fadeout track.
     if (gIsCrossfading && gFadeOutTrack && gFadeInTrack) {
         gFadeTimer += static_cast<f32>(Time::GetInstance().GetDeltaTime());
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include "AEEngine.h"
 #include "../Game/enemy/EnemyBoss.h"
 #include "../Game/Rooms/RoomManager.h"
@@ -5,6 +5,7 @@
 #include "../Utils/MeshGenerator.h"
 #include "../Utils/AEExtras.h"
 #include "../Utils/FileHelper.h"
+#include "../Utils/Renderer.h"
 #include "../Utils/Event/EventSystem.h"
 #include "../Game/UI.h"
 #include "Time.h"
@@ -13,6 +14,25 @@
 #include "Timer.h"
 #include "../Game/AudioManager.h"
 
+namespace {
+	// Timer names are interned once, they're checked every frame
+	TimerNameId GetFlipTimerName(int cardIndex) {
+		static TimerNameId names[NUM_CARDS] = {};
+		static bool isInterned = false;
+		if (!isInterned) {
+			for (int i = 0; i < NUM_CARDS; ++i)
+				names[i] = TimerSystem::GetInstance().InternName("Flip Timer " + std::to_string(i));
+			isInterned = true;
+		}
+		return names[cardIndex];
+	}
+
+	TimerNameId GetChooseBuffTimerName() {
+		static TimerNameId name = TimerSystem::GetInstance().InternName("Choose Buff Timer");
+		return name;
+	}
+}
+
 BuffCard::BuffCard( // Constructor
 	CARD_RARITY cr,
 	CARD_TYPE ct,
@@ -36,23 +56,23 @@ void BuffCardScreen::Init() {
 	cardMesh = MeshGenerator::GetRectMesh(1.0f, 1.0f);
 
 	// Card assets
-	cardBackTex = AEGfxTextureLoad("Assets/Art/0_CardBack.png");
-	cardFrontTex[HERMES_FAVOR] = AEGfxTextureLoad("Assets/Art/Hermes_Favor.png");
-	cardFrontTex[IRON_DEFENCE] = AEGfxTextureLoad("Assets/Art/Iron_Defence.png");
-	cardFrontTex[SWITCH_IT_UP] = AEGfxTextureLoad("Assets/Art/Switch_It_Up.png");
-	cardFrontTex[REVITALIZE] = AEGfxTextureLoad("Assets/Art/Revitalize.png");
-	cardFrontTex[SHARPEN] = AEGfxTextureLoad("Assets/Art/Sharpen.png");
-	cardFrontTex[BERSERKER] = AEGfxTextureLoad("Assets/Art/Berserker.png");
-	cardFrontTex[FLEETING_STEP] = AEGfxTextureLoad("Assets/Art/Fleeting_Step.png");
-	cardFrontTex[SUREFOOTED] = AEGfxTextureLoad("Assets/Art/Surefooted.png");
-	cardFrontTex[DEEP_VITALITY] = AEGfxTextureLoad("Assets/Art/Deep_Vitality.png");
-	cardFrontTex[HAND_OF_FATE] = AEGfxTextureLoad("Assets/Art/Hand_Of_Fate.png");
-	cardFrontTex[SUNDERING_BLOW] = AEGfxTextureLoad("Assets/Art/Sundering_Blow.png");
-
-	cardRarityTex[RARITY_UNCOMMON] = AEGfxTextureLoad("Assets/Art/Uncommon_Emission.png");
-	cardRarityTex[RARITY_RARE] = AEGfxTextureLoad("Assets/Art/Rare_Emission.png");
-	cardRarityTex[RARITY_EPIC] = AEGfxTextureLoad("Assets/Art/Epic_Emission.png");
-	cardRarityTex[RARITY_LEGENDARY] = AEGfxTextureLoad("Assets/Art/Legendary_Emission.png");
+	cardBackTex = TextureAtlas::Acquire("Assets/Art/0_CardBack.png");
+	cardFrontTex[HERMES_FAVOR] = TextureAtlas::Acquire("Assets/Art/Hermes_Favor.png");
+	cardFrontTex[IRON_DEFENCE] = TextureAtlas::Acquire("Assets/Art/Iron_Defence.png");
+	cardFrontTex[SWITCH_IT_UP] = TextureAtlas::Acquire("Assets/Art/Switch_It_Up.png");
+	cardFrontTex[REVITALIZE] = TextureAtlas::Acquire("Assets/Art/Revitalize.png");
+	cardFrontTex[SHARPEN] = TextureAtlas::Acquire("Assets/Art/Sharpen.png");
+	cardFrontTex[BERSERKER] = TextureAtlas::Acquire("Assets/Art/Berserker.png");
+	cardFrontTex[FLEETING_STEP] = TextureAtlas::Acquire("Assets/Art/Fleeting_Step.png");
+	cardFrontTex[SUREFOOTED] = TextureAtlas::Acquire("Assets/Art/Surefooted.png");
+	cardFrontTex[DEEP_VITALITY] = TextureAtlas::Acquire("Assets/Art/Deep_Vitality.png");
+	cardFrontTex[HAND_OF_FATE] = TextureAtlas::Acquire("Assets/Art/Hand_Of_Fate.png");
+	cardFrontTex[SUNDERING_BLOW] = TextureAtlas::Acquire("Assets/Art/Sundering_Blow.png");
+
+	cardRarityTex[RARITY_UNCOMMON] = TextureAtlas::Acquire("Assets/Art/Uncommon_Emission.png");
+	cardRarityTex[RARITY_RARE] = TextureAtlas::Acquire("Assets/Art/Rare_Emission.png");
+	cardRarityTex[RARITY_EPIC] = TextureAtlas::Acquire("Assets/Art/Epic_Emission.png");
+	cardRarityTex[RARITY_LEGENDARY] = TextureAtlas::Acquire("Assets/Art/Legendary_Emission.png");
 
 	buffPromptFont = AEGfxCreateFont("Assets/m04.ttf", BUFF_PROMPT_FONT_SIZE);
 	cardBuffFont = AEGfxCreateFont("Assets/Pixellari.ttf", CARD_BUFF_FONT_SIZE);
@@ -336,7 +356,8 @@ void BuffCardManager::LoadCardInfo() {
 	std::string actualAssetPath = "../../Assets/config/" + file;
 
 	if (!std::filesystem::exists(actualAssetPath)) {
-		std::cout << "Card info file does not exist: " << actualAssetPath << std::endl;
+		std::cout << "ERROR: Card info file does not exist: " << actualAssetPath
+			<< " (relative to " << std::filesystem::current_path().string() << "). No buff cards will be offered." << std::endl;
 		return; // nothing to load
 	}
 
@@ -424,13 +445,15 @@ void BuffCardScreen::Update() {
 
 			cardFlipStates[i] += static_cast<f32>(FLIP_SPEED * raritySpeedMultiplier * Time::GetInstance().GetDeltaTime());
 			if (cardFlipStates[i] >= 1.0f) {
-				f32 pitch{};
-				switch (cards[i].rarity)
-				{
-				case RARITY_UNCOMMON:  pitch = 1.0f; break;
-				case RARITY_RARE:      pitch = 1.2f; break;
-				case RARITY_EPIC:      pitch = 1.35f; break;
-				case RARITY_LEGENDARY: pitch = 1.5f; break;
+				f32 pitch{ 1.0f };
+				if (i < (int)cards.size()) {
+					switch (cards[i].rarity)
+					{
+					case RARITY_UNCOMMON:  pitch = 1.0f; break;
+					case RARITY_RARE:      pitch = 1.2f; break;
+					case RARITY_EPIC:      pitch = 1.35f; break;
+					case RARITY_LEGENDARY: pitch = 1.5f; break;
+					}
 				}
 
 				AudioManager::PlaySFX(*AudioManager::buffRevealSFX, pitch);
@@ -444,7 +467,7 @@ void BuffCardScreen::Update() {
 		// Check if we need to start flipping the next card
 		if (currentFlipIndex < NUM_CARDS) {
 			// Create timer for this card if not created yet
-			std::string timerName = "Flip Timer " + std::to_string(currentFlipIndex);
+			TimerNameId timerName = GetFlipTimerName(currentFlipIndex);
 
 			if (!flipTimerCreated[currentFlipIndex]) {
 				float delay = 0.45f; // Delay between cards
@@ -470,7 +493,7 @@ void BuffCardScreen::Update() {
 	if (AEInputCheckTriggered(AEVK_L)) {
 		ResetFlipSequence();
 	}
-	f32 dt = static_cast<f32>(AEFrameRateControllerGetFrameTime());
+	f32 dt = static_cast<f32>(Time::GetInstance().GetDeltaTime());
 
 	if (BuffCardManager::IsCardSelectedThisUpdate())
 	{
@@ -511,8 +534,7 @@ void BuffCardScreen::ResetFlipSequence()
 		flipTimerCreated[i] = false;
 
 		// Remove any existing timers
-		std::string timerName = "Flip Timer " + std::to_string(i);
-		TimerSystem::GetInstance().RemoveTimer(timerName);
+		TimerSystem::GetInstance().RemoveTimer(GetFlipTimerName(i));
 	}
 
 	currentFlipIndex = 0;
@@ -580,7 +602,7 @@ void BuffCardScreen::DrawBlackOverlay()
 }
 void BuffCardScreen::DrawPromptText(const std::vector<BuffCard>& cards, int selectedIdx) {
 	if (!textLoading) {
-		TimerSystem::GetInstance().AddTimer("Choose Buff Timer", 1.2f, true, true);
+		TimerSystem::GetInstance().AddTimer(GetChooseBuffTimerName(), 1.2f, true, true);
 		textLoading = true;
 	}
 	// Approximate text width calculation
@@ -589,15 +611,16 @@ void BuffCardScreen::DrawPromptText(const std::vector<BuffCard>& cards, int sele
 	f32 textWidth = text.length() * charWidth;
 	f32 centeredX = -textWidth * 0.5f;  // Offset by half width to center
 	f32 textVert = 0.68f;
-	if (TimerSystem::GetInstance().GetTimerByName("Choose Buff Timer") &&
-		!TimerSystem::GetInstance().GetTimerByName("Choose Buff Timer")->completed) { // Fade in.
+	const Timer* chooseBuffTimer = TimerSystem::GetInstance().GetTimerByName(GetChooseBuffTimerName());
+	if (chooseBuffTimer &&
+		!chooseBuffTimer->completed) { // Fade in.
 		AEGfxPrint(buffPromptFont,
 			text.c_str(),
 			centeredX,
 			textVert,
 			1.0f,
 			1.0f, 1.0f, 1.0f,
-			static_cast<f32>(TimerSystem::GetInstance().GetTimerByName("Choose Buff Timer")->percentage));
+			TimerSystem::GetInstance().GetTimerPercentage(*chooseBuffTimer));
 	}
 	else {
 		// Stay at 1 alpha.
@@ -670,6 +693,16 @@ void BuffCardScreen::DrawPromptText(const std::vector<BuffCard>& cards, int sele
 	}
 }
 // Draw buff cards.
+void BuffCardScreen::SubmitCard(const TextureAtlas::Region& region, const AEMtx33& transform) {
+	Renderer::DrawCommand command;
+	command.texture = region.texture;
+	command.transform = transform;
+	command.u0 = region.u0;
+	command.v0 = region.v0;
+	command.u1 = region.u1;
+	command.v1 = region.v1;
+	Renderer::Submit(command);
+}
 void BuffCardScreen::DrawDeck(const std::vector<BuffCard> cards) {
 	cachedCardRects.clear();
 	// Render state
@@ -729,7 +762,7 @@ void BuffCardScreen::DrawDeck(const std::vector<BuffCard> cards) {
 		AEMtx33 scale;
 		AEMtx33Scale(&scale, scaleX, scaleY);
 
-		AEGfxTexture* currentTexture = (cardFlipProgress < 0) ? cardBackTex : cardFrontTex[cards[i].type];
+		const TextureAtlas::Region& currentTexture = (cardFlipProgress < 0) ? cardBackTex : cardFrontTex[cards[i].type];
 
 		AEMtx33 translate;
 		AEMtx33Trans(&translate,
@@ -747,13 +780,11 @@ void BuffCardScreen::DrawDeck(const std::vector<BuffCard> cards) {
 		AEMtx33Concat(&transform, &rotate, &scale);
 		AEMtx33Concat(&transform, &translate, &transform);
 
-		AEGfxTextureSet(currentTexture, 0, 0);
-		AEGfxSetTransform(transform.m);
-		AEGfxMeshDraw(cardMesh, AE_GFX_MDM_TRIANGLES);
+		SubmitCard(currentTexture, transform);
 
 		// --- Draw Rarity/Emission Overlay ---
-		AEGfxTexture* emissionTex = cardRarityTex[cards[i].rarity];
-		if (emissionTex) {
+		const TextureAtlas::Region& emissionTex = cardRarityTex[cards[i].rarity];
+		if (emissionTex.texture) {
 			AEMtx33 emissionScale;
 			float EMISSION_SCALE = 1.15f; // 15% bigger than card
 			AEMtx33Scale(&emissionScale, scaleX * EMISSION_SCALE, scaleY * EMISSION_SCALE);
@@ -763,11 +794,12 @@ void BuffCardScreen::DrawDeck(const std::vector<BuffCard> cards) {
 			AEMtx33Concat(&emissionTransform, &rotate, &emissionScale);
 			AEMtx33Concat(&emissionTransform, &translate, &emissionTransform);
 
-			AEGfxTextureSet(emissionTex, 0, 0);
-			AEGfxSetTransform(emissionTransform.m);
-			AEGfxMeshDraw(cardMesh, AE_GFX_MDM_TRIANGLES);
+			SubmitCard(emissionTex, emissionTransform);
 		}
 	}
+
+	// Cards and emissions share the atlas, so the whole deck is 1 draw call
+	Renderer::Flush();
 }
 void BuffCardScreen::Render() {
 	if (BuffCardManager::IsRoomCleared()) {
@@ -793,23 +825,24 @@ void BuffCardScreen::Exit() {
 		AEGfxMeshFree(rectMesh);
 	}
 	// Free textures
-	if (cardBackTex) {
-		AEGfxTextureUnload(cardBackTex);
+	if (cardBackTex.texture) {
+		TextureAtlas::Release(cardBackTex);
+		cardBackTex = {};
 	}
 	for (auto& tex : cardFrontTex)
 	{
-		if (tex)
+		if (tex.texture)
 		{
-			AEGfxTextureUnload(tex);
-			tex = nullptr;
+			TextureAtlas::Release(tex);
+			tex = {};
 		}
 	}
 	for (auto& tex : cardRarityTex)
 	{
-		if (tex)
+		if (tex.texture)
 		{
-			AEGfxTextureUnload(tex);
-			tex = nullptr;
+			TextureAtlas::Release(tex);
+			tex = {};
 		}
 	}
 	// Free fonts
@@ -3,6 +3,7 @@
 #include "AETypes.h"
 #include <string>
 #include <vector>
+#include "../Utils/TextureAtlas.h"
 
 // Enumeration types for card type.
 enum CARD_TYPE {
@@ -205,7 +206,7 @@ public:
 
 	// Reset flip states and timers to simulate a shuffle, allowing cards to be drawn again.
 	static void ResetFlipSequence();
-	inline AEGfxTexture* GetCardBackTexture() const { return cardBackTex; }
+	inline AEGfxTexture* GetCardBackTexture() const { return cardBackTex.texture; }
 	inline AEGfxVertexList* GetCardMesh() const { return cardMesh; }
 	inline static const bool GetCardsFlipStatus() { return allCardsFlipped; } // Check if all cards have been flipped to show fronts and descriptions.
 	inline static const std::vector<f32> GetCardFlipStates() { return cardFlipStates; }
@@ -227,13 +228,16 @@ private:
 	static const int CARD_BUFF_FONT_SIZE = 32;
 
 	// Card texture and mesh
-	inline static AEGfxTexture* cardBackTex = nullptr;
+	inline static TextureAtlas::Region cardBackTex;
 	static const int UNIQUE_CARD_TEXTURES = 20; // Total number of unique card textures available (for different types and rarities).
-	inline static AEGfxTexture* cardFrontTex[UNIQUE_CARD_TEXTURES] = { nullptr }; // 5 different front textures
+	inline static TextureAtlas::Region cardFrontTex[UNIQUE_CARD_TEXTURES]; // 5 different front textures
 	static const int UNIQUE_RARITY_TEXTURES = 4; // Total number of unique rarity textures available (for different rarities).
-	inline static AEGfxTexture* cardRarityTex[UNIQUE_RARITY_TEXTURES] = { nullptr }; // 4 different rarities
+	inline static TextureAtlas::Region cardRarityTex[UNIQUE_RARITY_TEXTURES]; // 4 different rarities
 	inline static AEGfxVertexList* cardMesh = nullptr;
 
+	// Queues a card quad (unit rect) with the region's UVs, drawn by Renderer::Flush at the end of DrawDeck
+	static void SubmitCard(const TextureAtlas::Region& region, const AEMtx33& transform);
+
 	// Card visual attributes.
 	inline static std::vector<f32> cardFlipStates { -1.0f, -1.0f, -1.0f }; // Start showing backs
 	inline static f32 cardYOffset[NUM_CARDS] = { 0 }; // 0 = normal
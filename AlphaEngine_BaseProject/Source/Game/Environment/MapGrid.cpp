@@ -2,11 +2,12 @@
 #include <algorithm>
 
 #include "MapGrid.h"
-#include "../../Utils/MeshGenerator.h"
 #include "../Camera.h"
 #include "../../Utils/AEExtras.h"
-#include "../../Utils/QuickGraphics.h"
 #include "../../Editor/Editor.h"
+#include "../../Utils/Profiler.h"
+#include "../../Utils/DebugDraw.h"
+#include "../Rooms/RoomData.h"
 
 #undef min
 #undef max
@@ -22,20 +23,32 @@ namespace
 	static constexpr float PLATFORM_WIDTH_TILES = 1.0f;
 	static constexpr float PLATFORM_HEIGHT_TILES = 1.0f;
 	static constexpr int   PLATFORM_COLLISION_WIDTH = 1;
+
+	// Gap kept between a box and the tiles in SweepBox so the box never ends up exactly on a cell edge
+	static constexpr float SWEEP_SKIN = 0.01f;
+
+	// Render chunk size, 1 room
+	static constexpr int CHUNK_COLS = ROOM_COLS;
+	static constexpr int CHUNK_ROWS = ROOM_ROWS;
 }
 
 MapGrid::MapGrid(int cols, int rows)
 	: size(cols, rows),
 	tiles(cols* rows),
-	tileCount(cols* rows)
+	tileCount(cols* rows),
+	wordsPerRow((cols + 63) / 64),
+	chunkCount((cols + CHUNK_COLS - 1) / CHUNK_COLS, (rows + CHUNK_ROWS - 1) / CHUNK_ROWS)
 {
-	// full texture on a 1x1 quad
-	tileMesh = MeshGenerator::GetSquareMesh(1.f, 1.f, 1.f);
+	// Every tile starts as NONE
+	solidBits.assign((size_t)wordsPerRow * (size_t)rows, 0);
+
+	// Built on the first Render
+	chunks.resize((size_t)chunkCount.x * chunkCount.y);
 
-	surfaceTexture = AEGfxTextureLoad(SURFACE_PATH);
-	bodyTexture = AEGfxTextureLoad(BODY_PATH);
-	bottomTexture = AEGfxTextureLoad(BOTTOM_PATH);
-	platformTexture = AEGfxTextureLoad(PLATFORM_PATH);
+	tileRegions[MapTile::Type::GROUND_SURFACE] = TextureAtlas::Acquire(SURFACE_PATH);
+	tileRegions[MapTile::Type::GROUND_BODY] = TextureAtlas::Acquire(BODY_PATH);
+	tileRegions[MapTile::Type::GROUND_BOTTOM] = TextureAtlas::Acquire(BOTTOM_PATH);
+	tileRegions[MapTile::Type::PLATFORM] = TextureAtlas::Acquire(PLATFORM_PATH);
 
 	for (auto& t : tiles)
 		t.type = MapTile::Type::NONE;
@@ -47,23 +60,23 @@ MapGrid::MapGrid(const char*) : MapGrid(10, 10)
 
 MapGrid::~MapGrid()
 {
-	if (tileMesh)
-		AEGfxMeshFree(tileMesh);
-
-	if (surfaceTexture)
-		AEGfxTextureUnload(surfaceTexture);
-
-	if (bodyTexture)
-		AEGfxTextureUnload(bodyTexture);
-
-	if (bottomTexture)
-		AEGfxTextureUnload(bottomTexture);
+	for (Chunk& chunk : chunks)
+	{
+		for (AEGfxVertexList* mesh : chunk.meshes)
+		{
+			if (mesh)
+				AEGfxMeshFree(mesh);
+		}
+	}
 
-	if (platformTexture)
-		AEGfxTextureUnload(platformTexture);
+	for (const TextureAtlas::Region& region : tileRegions)
+	{
+		if (region.texture)
+			TextureAtlas::Release(region);
+	}
 }
 
-bool MapGrid::IsSolidAtGridCell(int x, int y) const
+bool MapGrid::ComputeIsSolid(int x, int y) const
 {
 	if (x < 0 || x >= size.x || y < 0 || y >= size.y)
 		return false;
@@ -98,7 +111,10 @@ bool MapGrid::IsSolidAtGridCell(int x, int y) const
 
 void MapGrid::Render()
 {
-	AEMtx33 transform;
+	PROFILE_SCOPE("MapGrid::Render");
+
+	if (chunks.empty())
+		return;
 
 	AEVec2 bottomLeft, topRight;
 	AEExtras::ScreenToWorldPosition(AEVec2(0, (f32)AEGfxGetWindowHeight()), bottomLeft);
@@ -111,77 +127,178 @@ void MapGrid::Render()
 	WorldToGridCoordsClamped(bottomLeft, minX, minY);
 	WorldToGridCoordsClamped(topRight, maxX, maxY);
 
-	for (int y = minY; y <= maxY; ++y)
+	// Chunk meshes are in world units, only the camera scale is left
+	AEMtx33 transform;
+	AEMtx33Scale(&transform, Camera::scale, Camera::scale);
+	AEGfxSetTransform(transform.m);
+
+	for (int chunkY = minY / CHUNK_ROWS; chunkY <= maxY / CHUNK_ROWS; ++chunkY)
 	{
-		for (int x = minX; x <= maxX; ++x)
+		for (int chunkX = minX / CHUNK_COLS; chunkX <= maxX / CHUNK_COLS; ++chunkX)
 		{
-			const MapTile* tile = GetTile(x, y);
-			if (tile == nullptr || tile->type == MapTile::Type::NONE)
-				continue;
-
-			AEGfxTexture* tex = nullptr;
-			float scaleX = Camera::scale;
-			float scaleY = Camera::scale;
-			float drawX = (float)x + 0.5f;
-			float drawY = (float)y + 0.5f;
+			Chunk& chunk = chunks[(size_t)chunkY * chunkCount.x + chunkX];
+			if (chunk.isDirty)
+				BuildChunk(chunkX, chunkY);
 
-			switch (tile->type)
+			for (int type = 0; type < MapTile::typeCount; ++type)
 			{
-			case MapTile::Type::GROUND_SURFACE:
-				tex = surfaceTexture;
-				break;
+				if (!chunk.meshes[type])
+					continue;
 
-			case MapTile::Type::GROUND_BODY:
-				tex = bodyTexture;
-				break;
+				AEGfxTextureSet(tileRegions[type].texture, 0.0f, 0.0f);
+				AEGfxMeshDraw(chunk.meshes[type], AE_GFX_MDM_TRIANGLES);
+			}
+		}
+	}
+}
 
-			case MapTile::Type::GROUND_BOTTOM:
-				tex = bottomTexture;
-				break;
+void MapGrid::BuildChunk(int chunkX, int chunkY)
+{
+	Chunk& chunk = chunks[(size_t)chunkY * chunkCount.x + chunkX];
+	chunk.isDirty = false;
 
-			case MapTile::Type::PLATFORM:
-				tex = platformTexture;
+	const int startX = chunkX * CHUNK_COLS;
+	const int startY = chunkY * CHUNK_ROWS;
+	const int endX = (std::min)(startX + CHUNK_COLS, size.x);
+	const int endY = (std::min)(startY + CHUNK_ROWS, size.y);
 
-				// one platform tile is the LEFT anchor of a 5x1 platform
-				scaleX = Camera::scale * PLATFORM_WIDTH_TILES;
-				scaleY = Camera::scale * PLATFORM_HEIGHT_TILES;
+	for (int meshType = 0; meshType < MapTile::typeCount; ++meshType)
+	{
+		if (chunk.meshes[meshType])
+		{
+			AEGfxMeshFree(chunk.meshes[meshType]);
+			chunk.meshes[meshType] = nullptr;
+		}
 
-				drawX = (float)x + (PLATFORM_WIDTH_TILES * 0.5f);
-				drawY = (float)y + 0.5f;
-				break;
+		// 1 mesh for each texture, belongs to the first type using it
+		AEGfxTexture* texture = tileRegions[meshType].texture;
+		if (meshType == MapTile::Type::NONE || !texture)
+			continue;
 
-			default:
-				break;
+		bool isTextureUsedBefore = false;
+		for (int type = 0; type < meshType; ++type)
+			isTextureUsedBefore |= tileRegions[type].texture == texture;
+		if (isTextureUsedBefore)
+			continue;
+
+		bool hasTile = false;
+		for (int y = startY; y < endY; ++y)
+		{
+			for (int x = startX; x < endX; ++x)
+			{
+				const MapTile::Type type = tiles[y * size.x + x].type;
+				const TextureAtlas::Region& region = tileRegions[type];
+				if (type == MapTile::Type::NONE || region.texture != texture)
+					continue;
+
+				if (!hasTile)
+				{
+					AEGfxMeshStart();
+					hasTile = true;
+				}
+
+				// Size of the quad, centered on the tile.
+				// A platform tile is the LEFT anchor of the platform
+				float width = 1.f, height = 1.f;
+				if (type == MapTile::Type::PLATFORM)
+				{
+					width = PLATFORM_WIDTH_TILES;
+					height = PLATFORM_HEIGHT_TILES;
+				}
+
+				// Same layout as MeshGenerator::GetRectMesh
+				const float left = (float)x + 0.5f - width * 0.5f;
+				const float right = left + width;
+				const float bottom = (float)y + 0.5f - height * 0.5f;
+				const float top = bottom + height;
+				AEGfxTriAdd(
+					left, bottom, 0xFFFFFFFF, region.u0, region.v1,
+					right, bottom, 0xFFFFFFFF, region.u1, region.v1,
+					left, top, 0xFFFFFFFF, region.u0, region.v0
+				);
+				AEGfxTriAdd(
+					right, bottom, 0xFFFFFFFF, region.u1, region.v1,
+					right, top, 0xFFFFFFFF, region.u1, region.v0,
+					left, top, 0xFFFFFFFF, region.u0, region.v0
+				);
 			}
+		}
 
-			if (!tex)
-				continue;
+		if (hasTile)
+			chunk.meshes[meshType] = AEGfxMeshEnd();
+	}
+}
 
-			AEMtx33Trans(&transform, drawX, drawY);
-			AEMtx33ScaleApply(&transform, &transform, scaleX, scaleY);
-			AEGfxSetTransform(transform.m);
+void MapGrid::SetTile(int x, int y, MapTile::Type type)
+{
+	if (x < 0 || x >= size.x || y < 0 || y >= size.y)
+		return;
 
-			AEGfxTextureSet(tex, 0.0f, 0.0f);
-			AEGfxMeshDraw(tileMesh, AE_GFX_MDM_TRIANGLES);
-		}
+	if (tiles[y * size.x + x].type == type)
+		return;
+
+	tiles[y * size.x + x].type = type;
+	chunks[(size_t)(y / CHUNK_ROWS) * chunkCount.x + x / CHUNK_COLS].isDirty = true;
+
+	// A platform anchor also covers the cells to its right
+	UpdateSolidBits(x, x + PLATFORM_COLLISION_WIDTH - 1, y);
+}
+
+void MapGrid::UpdateSolidBits(int minX, int maxX, int y)
+{
+	minX = (std::max)(minX, 0);
+	maxX = (std::min)(maxX, size.x - 1);
+
+	for (int x = minX; x <= maxX; ++x)
+	{
+		u64& word = solidBits[(size_t)y * wordsPerRow + (x >> 6)];
+		const u64 bit = 1ull << (x & 63);
+
+		if (ComputeIsSolid(x, y))
+			word |= bit;
+		else
+			word &= ~bit;
 	}
 }
 
-inline const MapTile* MapGrid::GetTile(int x, int y)
+bool MapGrid::RowHasSolid(int y, int minX, int maxX) const
 {
-#if _DEBUG
-	if (x < 0 || x >= size.x || y < 0 || y >= size.y)
-		return nullptr;
-#endif
-	return &(tiles[y * size.x + x]);
+	const u64* row = &solidBits[(size_t)y * wordsPerRow];
+	const int firstWord = minX >> 6, lastWord = maxX >> 6;
+
+	// Mask off the bits before minX in the first word and after maxX in the last word
+	const u64 firstMask = ~0ull << (minX & 63);
+	const u64 lastMask = ~0ull >> (63 - (maxX & 63));
+
+	if (firstWord == lastWord)
+		return (row[firstWord] & firstMask & lastMask) != 0;
+
+	if (row[firstWord] & firstMask)
+		return true;
+	for (int w = firstWord + 1; w < lastWord; ++w)
+	{
+		if (row[w])
+			return true;
+	}
+	return (row[lastWord] & lastMask) != 0;
 }
 
-void MapGrid::SetTile(int x, int y, MapTile::Type type)
+bool MapGrid::CheckCellRangeCollision(int minX, int minY, int maxX, int maxY) const
 {
-	if (x < 0 || x >= size.x || y < 0 || y >= size.y)
-		return;
+	// Outside the grid isn't solid
+	minX = (std::max)(minX, 0);
+	minY = (std::max)(minY, 0);
+	maxX = (std::min)(maxX, size.x - 1);
+	maxY = (std::min)(maxY, size.y - 1);
+	if (minX > maxX || minY > maxY)
+		return false;
 
-	tiles[y * size.x + x].type = type;
+	for (int y = minY; y <= maxY; ++y)
+	{
+		if (RowHasSolid(y, minX, maxX))
+			return true;
+	}
+	return false;
 }
 
 bool MapGrid::CheckPointCollision(float x, float y)
@@ -200,10 +317,13 @@ bool MapGrid::CheckBoxCollision(const AEVec2& boxPosition, const AEVec2& boxSize
 {
 	AEVec2 halfBoxSize(boxSize.x * 0.5f, boxSize.y * 0.5f);
 
-	return CheckPointCollision(boxPosition.x - halfBoxSize.x, boxPosition.y - halfBoxSize.y) ||
-		CheckPointCollision(boxPosition.x - halfBoxSize.x, boxPosition.y + halfBoxSize.y) ||
-		CheckPointCollision(boxPosition.x + halfBoxSize.x, boxPosition.y - halfBoxSize.y) ||
-		CheckPointCollision(boxPosition.x + halfBoxSize.x, boxPosition.y + halfBoxSize.y);
+	// Every cell between the corners, not just the corners. Same result for boxes up to 1 tile,
+	// bigger boxes (e.g. boss) also collide with tiles in the middle.
+	int minX, minY, maxX, maxY;
+	WorldToGridCoords(boxPosition - halfBoxSize, minX, minY);
+	WorldToGridCoords(boxPosition + halfBoxSize, maxX, maxY);
+
+	return CheckCellRangeCollision(minX, minY, maxX, maxY);
 }
 
 bool MapGrid::CheckBoxCollision(const Box& box)
@@ -211,7 +331,46 @@ bool MapGrid::CheckBoxCollision(const Box& box)
 	return CheckBoxCollision(box.position, box.size);
 }
 
-float MapGrid::Raycast(const AEVec2& start, const AEVec2& end)
+namespace
+{
+	// Raycast debug drawing, picked once per ray at compile time
+	// so the normal version has no editor checks or draw calls in the loop
+	struct RaycastNoDebugDraw
+	{
+		static void Cell(const Vec2Int&, bool) {}
+		static void Hit(const AEVec2&, const AEVec2&) {}
+		static void Miss(const AEVec2&, const AEVec2&) {}
+	};
+
+	struct RaycastDebugDraw
+	{
+		static void Cell(const Vec2Int& cell, bool isSolid)
+		{
+			DebugDraw::AddRect(cell.GetAEVec2() + AEVec2{ 0.5f, 0.5f }, { 1.f, 1.f }, isSolid ? 0xFFFF0000 : 0xFF00FF00, AE_GFX_MDM_LINES_STRIP);
+		}
+		static void Hit(const AEVec2& start, const AEVec2& hitPoint)
+		{
+			DebugDraw::AddRay(start, hitPoint, 0.1f, 0xAAFF8800);
+		}
+		static void Miss(const AEVec2& start, const AEVec2& end)
+		{
+			DebugDraw::AddRay(start, end, 0.1f, 0xAA88FF88);
+		}
+	};
+}
+
+float MapGrid::Raycast(const AEVec2& start, const AEVec2& end) const
+{
+	PROFILE_SCOPE("MapGrid::Raycast");
+
+	if (Editor::GetShowColliders())
+		return RaycastImpl<RaycastDebugDraw>(start, end);
+	else
+		return RaycastImpl<RaycastNoDebugDraw>(start, end);
+}
+
+template <typename DrawPolicy>
+float MapGrid::RaycastImpl(const AEVec2& start, const AEVec2& end) const
 {
 	if (start == end)
 		return 0.f;
@@ -223,7 +382,9 @@ float MapGrid::Raycast(const AEVec2& start, const AEVec2& end)
 
 	Vec2Int step{ Sign(ray.x), Sign(ray.y) };
 
-	Vec2Int currCell{ start };
+	// Floor instead of Vec2Int{ start }, truncating puts -1 < x < 0 in cell 0
+	Vec2Int currCell;
+	WorldToGridCoords(start, currCell.x, currCell.y);
 
 	if (IsSolidAtGridCell(currCell.x, currCell.y))
 		return 0.f;
@@ -254,20 +415,14 @@ float MapGrid::Raycast(const AEVec2& start, const AEVec2& end)
 	{
 		if (IsSolidAtGridCell(currCell.x, currCell.y))
 		{
-			if (Editor::GetShowColliders())
-			{
-				QuickGraphics::DrawRay(start, start + (isAxisX ? (tMax.x - delta.x) : (tMax.y - delta.y)) * ray, 0.1f, 0xAAFF8800);
-				QuickGraphics::DrawRect(currCell.GetAEVec2() + AEVec2{0.5f, 0.5f}, { 1.f, 1.f }, 0xFFFF0000, AE_GFX_MDM_LINES_STRIP);
-			}
+			const float hitT = isAxisX ? (tMax.x - delta.x) : (tMax.y - delta.y);
+			DrawPolicy::Hit(start, start + hitT * ray);
+			DrawPolicy::Cell(currCell, true);
 
-			if (isAxisX)
-				return (tMax.x - delta.x) * rayDist;
-			else
-				return (tMax.y - delta.y) * rayDist;
+			return hitT * rayDist;
 		}
 
-		if (Editor::GetShowColliders())
-			QuickGraphics::DrawRect(currCell.GetAEVec2() + AEVec2{0.5f, 0.5f}, { 1.f, 1.f }, 0xFF00FF00, AE_GFX_MDM_LINES_STRIP);
+		DrawPolicy::Cell(currCell, false);
 
 		// Step on the axis where tMax is the smallest
 		if (tMax.x < tMax.y)
@@ -284,80 +439,242 @@ float MapGrid::Raycast(const AEVec2& start, const AEVec2& end)
 		}
 	}
 
-	if (Editor::GetShowColliders())
-		QuickGraphics::DrawRay(start, end, 0.1f, 0xAA88FF88);
+	DrawPolicy::Miss(start, end);
 
 	return rayDist;
 }
 
-// Not the most efficient algorithm but not sure how else to do dynamic collision with a grid...
-// Also doesn't handle properly if colliderSize > 2
-// Rough explanation
-// - Raycasts from 4 vertices of the box
-// - Get min dist from the raycasts
-// - Make it slide
-void MapGrid::HandleBoxCollision(AEVec2& currPosition, AEVec2& , const AEVec2& nextPosition, const AEVec2& colliderSizeTmp, bool ifSlide)
+int MapGrid::RayBatch::Add(const AEVec2& start, const AEVec2& end)
 {
-	if (currPosition == nextPosition)
-		return;
+	startX.push_back(start.x);
+	startY.push_back(start.y);
+	endX.push_back(end.x);
+	endY.push_back(end.y);
+	return (int)startX.size() - 1;
+}
 
-	//float epsilon = EPSILON;
-	constexpr float epsilon = 0.01f;
+void MapGrid::RayBatch::Clear()
+{
+	startX.clear();
+	startY.clear();
+	endX.clear();
+	endY.clear();
+	hitDist.clear();
+	normalX.clear();
+	normalY.clear();
+	hit.clear();
+}
 
-	AEVec2 colliderSize = colliderSizeTmp - AEVec2{ epsilon, epsilon };
-	AEVec2 halfColliderSize = colliderSize * 0.5f;
+void MapGrid::RaycastBatch(RayBatch& batch) const
+{
+	PROFILE_SCOPE("MapGrid::RaycastBatch");
 
-	AEVec2 ray = nextPosition - currPosition;
-	float rayDist = AEExtras::Dist(ray);
-	AEVec2 rayDir = ray / rayDist;
-	AEVec2 epsilonDir{ Sign(rayDir.x) * epsilon, Sign(rayDir.y) * epsilon };
+	const int count = batch.Size();
+	batch.hitDist.resize(count);
+	batch.normalX.assign(count, 0.f);
+	batch.normalY.assign(count, 0.f);
+	batch.hit.assign(count, 0);
+
+	// Ray lengths in a separate pass, no branches so the compiler can vectorise it
+	for (int i = 0; i < count; ++i)
+	{
+		const float dx = batch.endX[i] - batch.startX[i];
+		const float dy = batch.endY[i] - batch.startY[i];
+		batch.hitDist[i] = sqrtf(dx * dx + dy * dy);
+	}
 
-	Vec2Int raySign{ Sign_NoZero(rayDir.x), Sign_NoZero(rayDir.y) };
+	constexpr float infinity = std::numeric_limits<f32>::max();
 
-	float dist = rayDist;
-	AEVec2 corner{ currPosition + raySign * halfColliderSize };
-	dist = std::min(dist, Raycast(corner, corner + ray));
+	for (int i = 0; i < count; ++i)
+	{
+		const float startX = batch.startX[i], startY = batch.startY[i];
+		const float dx = batch.endX[i] - startX, dy = batch.endY[i] - startY;
+		const float length = batch.hitDist[i];
+
+		// Clip the ray to the grid, [tMin, tMax] is the part inside.
+		// Also track which side it entered from for the normal
+		float tMin = 0.f, tMax = 1.f;
+		int entryAxis = -1;
+		auto clip = [&](float start, float delta, float gridSize, int axis) {
+			if (delta == 0.f)
+			{
+				if (start < 0.f || start >= gridSize)
+					tMin = infinity;
+				return;
+			}
+			const float t0 = (0.f - start) / delta, t1 = (gridSize - start) / delta;
+			const float tEnter = (std::min)(t0, t1), tExit = (std::max)(t0, t1);
+			if (tEnter > tMin)
+			{
+				tMin = tEnter;
+				entryAxis = axis;
+			}
+			tMax = (std::min)(tMax, tExit);
+		};
+		clip(startX, dx, (float)size.x, 0);
+		clip(startY, dy, (float)size.y, 1);
 
-	corner.x -= colliderSize.x * raySign.x;
-	dist = std::min(dist, Raycast(corner, corner + ray));
-	
-	corner.x += colliderSize.x * raySign.x; // Revert previous offset
-	corner.y -= colliderSize.y * raySign.y;
-	dist = std::min(dist, Raycast(corner, corner + ray));
+		if (tMin > tMax)
+			continue;
 
-	// EPSILON to prevent clipping into the tile
-	currPosition += rayDir * dist - epsilonDir;
+		// Amanatides and Woo, same as Raycast but starting from where the ray enters the grid
+		const Vec2Int step{ Sign(dx), Sign(dy) };
+		int cellX = std::clamp((int)floorf(startX + dx * tMin), 0, size.x - 1);
+		int cellY = std::clamp((int)floorf(startY + dy * tMin), 0, size.y - 1);
 
-	// ===== Sliding =====
-	if (!ifSlide || dist == rayDist)
-		return;
-	AEVec2 remainingRay = rayDir * (rayDist - dist);
+		float nextX = dx == 0.f ? infinity : ((float)(cellX + (step.x > 0)) - startX) / dx;
+		float nextY = dy == 0.f ? infinity : ((float)(cellY + (step.y > 0)) - startY) / dy;
+		const float deltaX = dx == 0.f ? infinity : fabsf(1.f / dx);
+		const float deltaY = dy == 0.f ? infinity : fabsf(1.f / dy);
+
+		float tEntry = tMin;
+		float normalX = entryAxis == 0 ? (float)-step.x : 0.f;
+		float normalY = entryAxis == 1 ? (float)-step.y : 0.f;
+
+		while (true)
+		{
+			if ((solidBits[(size_t)cellY * wordsPerRow + (cellX >> 6)] >> (cellX & 63)) & 1)
+			{
+				batch.hit[i] = 1;
+				batch.hitDist[i] = tEntry * length;
+				batch.normalX[i] = normalX;
+				batch.normalY[i] = normalY;
+				break;
+			}
+
+			// Step on the axis where the next cell boundary is closest
+			if (nextX < nextY)
+			{
+				tEntry = nextX;
+				nextX += deltaX;
+				cellX += step.x;
+				normalX = (float)-step.x;
+				normalY = 0.f;
+			}
+			else
+			{
+				tEntry = nextY;
+				nextY += deltaY;
+				cellY += step.y;
+				normalX = 0.f;
+				normalY = (float)-step.y;
+			}
 
-	// Check raycast for x (on the leading side and in that direction)
-	if (std::abs(remainingRay.x) > epsilon)
+			// Past the end of the ray or left the grid
+			if (tEntry > tMax || cellX < 0 || cellX >= size.x || cellY < 0 || cellY >= size.y)
+				break;
+		}
+	}
+}
+
+void MapGrid::CheckBoxCollisionBatch(const AEVec2* positions, int count, const AEVec2& boxSize, bool* outHits) const
+{
+	const AEVec2 halfBoxSize(boxSize.x * 0.5f, boxSize.y * 0.5f);
+
+	for (int i = 0; i < count; ++i)
 	{
-		AEVec2 point = currPosition + raySign * halfColliderSize;
-		float x1 = Raycast(point, { point.x + remainingRay.x, point.y });
+		outHits[i] = CheckCellRangeCollision(
+			(int)floorf(positions[i].x - halfBoxSize.x), (int)floorf(positions[i].y - halfBoxSize.y),
+			(int)floorf(positions[i].x + halfBoxSize.x), (int)floorf(positions[i].y + halfBoxSize.y));
+	}
+}
 
-		point.y -= colliderSize.y * raySign.y;
-		float x2 = Raycast(point, { point.x + remainingRay.x, point.y });
+float MapGrid::SweepAxis(float leadingEdge, float delta, int perpMin, int perpMax, bool isAxisX) const
+{
+	auto isColumnSolid = [&](int cell) {
+		return isAxisX ?
+			CheckCellRangeCollision(cell, perpMin, cell, perpMax) :
+			CheckCellRangeCollision(perpMin, cell, perpMax, cell);
+	};
 
-		remainingRay.x = std::min(x1, x2) * raySign.x - epsilonDir.x;
+	if (delta > 0.f)
+	{
+		// Cells in front of the leading edge. A cell the box already overlaps is skipped so it can move out
+		const int first = (int)floorf(leadingEdge - SWEEP_SKIN) + 1;
+		const int last = (int)floorf(leadingEdge + delta);
+		for (int cell = first; cell <= last; ++cell)
+		{
+			if (isColumnSolid(cell))
+				return (std::min)(delta, cell - SWEEP_SKIN - leadingEdge);
+		}
+	}
+	else
+	{
+		const int first = (int)floorf(leadingEdge + SWEEP_SKIN) - 1;
+		const int last = (int)floorf(leadingEdge + delta);
+		for (int cell = first; cell >= last; --cell)
+		{
+			if (isColumnSolid(cell))
+				return (std::max)(delta, cell + 1 + SWEEP_SKIN - leadingEdge);
+		}
 	}
 
-	// Check raycast for y (on the leading side and in that direction)
-	if (std::abs(remainingRay.y) > epsilon)
+	return delta;
+}
+
+MapGrid::SweepResult MapGrid::SweepBox(const AEVec2& position, const AEVec2& size, const AEVec2& displacement, bool ifSlide) const
+{
+	PROFILE_SCOPE("MapGrid::SweepBox");
+
+	SweepResult result;
+	result.position = position;
+
+	const AEVec2 halfSize = size * 0.5f;
+
+	// Cells covered on the other axis. Shrunk by the skin so touching a tile on the side doesn't count
+	auto cellRange = [](float center, float half, int& outMin, int& outMax) {
+		outMin = (int)floorf(center - half + SWEEP_SKIN);
+		outMax = (int)floorf(center + half - SWEEP_SKIN);
+	};
+
+	int perpMin, perpMax;
+
+	if (displacement.x != 0.f)
+	{
+		cellRange(result.position.y, halfSize.y, perpMin, perpMax);
+
+		const float leadingEdge = result.position.x + (displacement.x > 0.f ? halfSize.x : -halfSize.x);
+		const float moved = SweepAxis(leadingEdge, displacement.x, perpMin, perpMax, true);
+
+		result.position.x += moved;
+		if (moved != displacement.x)
+		{
+			result.hitX = true;
+			result.normal.x = displacement.x > 0.f ? -1.f : 1.f;
+		}
+	}
+
+	if (displacement.y != 0.f && (ifSlide || !result.hitX))
 	{
-		AEVec2 point = currPosition + raySign * halfColliderSize;
-		float y1 = Raycast(point, { point.x, point.y + remainingRay.y });
+		cellRange(result.position.x, halfSize.x, perpMin, perpMax);
 
-		point.x -= colliderSize.x * raySign.x;
-		float y2 = Raycast(point, { point.x, point.y + remainingRay.y });
+		const float leadingEdge = result.position.y + (displacement.y > 0.f ? halfSize.y : -halfSize.y);
+		const float moved = SweepAxis(leadingEdge, displacement.y, perpMin, perpMax, false);
 
-		remainingRay.y = std::min(y1, y2) * raySign.y - epsilonDir.y;
+		result.position.y += moved;
+		if (moved != displacement.y)
+		{
+			result.hitY = true;
+			result.normal.y = displacement.y > 0.f ? -1.f : 1.f;
+		}
 	}
 
-	currPosition += remainingRay;
+	if (Editor::GetShowColliders() && (result.hitX || result.hitY))
+		DebugDraw::AddRect(result.position, size, 0xAAFF8800, AE_GFX_MDM_LINES_STRIP);
+
+	return result;
+}
+
+AEVec2 MapGrid::HandleBoxCollision(AEVec2& currPosition, AEVec2& , const AEVec2& nextPosition, const AEVec2& colliderSize, bool ifSlide)
+{
+	PROFILE_SCOPE("MapGrid::HandleBoxCollision");
+
+	if (currPosition == nextPosition)
+		return { 0, 0 };
+
+	const SweepResult result = SweepBox(currPosition, colliderSize, nextPosition - currPosition, ifSlide);
+	currPosition = result.position;
+	return result.normal;
 }
 
 int MapGrid::WorldToIndex(float x, float y)
@@ -382,7 +699,7 @@ int MapGrid::WorldToIndex(const AEVec2& worldPosition)
 	return y * size.x + x;
 }
 
-inline void MapGrid::WorldToGridCoords(const AEVec2& worldPosition, int& outX, int& outY)
+inline void MapGrid::WorldToGridCoords(const AEVec2& worldPosition, int& outX, int& outY) const
 {
 	outX = (int)floorf(worldPosition.x);
 	outY = (int)floorf(worldPosition.y);
@@ -5,49 +5,177 @@
 #include "MapTile.h"
 #include "../../Utils/Vec2Int.h"
 #include "../../Utils/Box.h"
+#include "../../Utils/TextureAtlas.h"
 #include "../Camera.h"
 
 class MapGrid
 {
 public:
+	/**
+	 * @brief	Result of SweepBox
+	 */
+	struct SweepResult
+	{
+		AEVec2 position;		// Where the box stopped
+		AEVec2 normal{ 0, 0 };	// Contact normal of each axis that hit, e.g. {0, 1} when landing. Zero if no hit
+		bool hitX = false;
+		bool hitY = false;
+	};
+
+	/**
+	 * @brief	Rays for RaycastBatch, each field in its own array (structure of arrays).
+	 *			Add() the rays, call RaycastBatch(), then read the results at the index Add() returned.
+	 *			Reuse the same batch every frame to avoid reallocating.
+	 */
+	struct RayBatch
+	{
+		// Input
+		std::vector<float> startX, startY;
+		std::vector<float> endX, endY;
+
+		// Output
+		std::vector<float> hitDist;				// Distance to the hit. Ray length if nothing was hit
+		std::vector<float> normalX, normalY;	// Face of the cell that was hit. Zero if nothing was hit or the ray started inside a tile
+		std::vector<u8> hit;					// 1 if hit
+
+		int Add(const AEVec2& start, const AEVec2& end);
+		void Clear();
+		int Size() const { return (int)startX.size(); }
+	};
+
 	MapGrid(int cols, int rows);
 	MapGrid(const char* file);
 	~MapGrid();
 
+	// Owns the chunk meshes
+	MapGrid(const MapGrid&) = delete;
+	MapGrid& operator=(const MapGrid&) = delete;
+
+	/**
+	 * @brief	Draws the chunks on screen, 1 draw call per texture in each chunk (1 if the tiles are in the same atlas).
+	 *			Chunks changed by SetTile are rebuilt first.
+	 */
 	void Render();
 
-	inline const MapTile* GetTile(int x, int y);
+	// Defined here since it is also used outside MapGrid.cpp (LevelIO)
+	inline const MapTile* GetTile(int x, int y)
+	{
+#if _DEBUG
+		if (x < 0 || x >= size.x || y < 0 || y >= size.y)
+			return nullptr;
+#endif
+		return &(tiles[y * size.x + x]);
+	}
 	void SetTile(int x, int y, MapTile::Type type);
 
 	bool CheckPointCollision(float x, float y);
 	bool CheckPointCollision(const AEVec2& worldPosition);
 
+	/**
+	 * @brief	If any cell the box covers is solid
+	 * @param	boxPosition	Center of the box
+	 * @param	boxSize		Full width / height
+	 */
 	bool CheckBoxCollision(const AEVec2& boxPosition, const AEVec2& boxSize);
 	bool CheckBoxCollision(const Box& box);
 
-	float Raycast(const AEVec2& start, const AEVec2& end);
+	/**
+	 * @brief	If any cell in the range is solid (inclusive, grid coords). Cells outside the grid aren't solid.
+	 */
+	bool CheckCellRangeCollision(int minX, int minY, int maxX, int maxY) const;
+
+	/**
+	 * @brief	Distance from start to the first solid tile, ray length if nothing was hit.
+	 *			Records debug shapes (DebugDraw) when the editor is showing colliders.
+	 */
+	float Raycast(const AEVec2& start, const AEVec2& end) const;
+
+	/**
+	 * @brief	Casts every ray in the batch. Same result as Raycast but without the debug drawing.
+	 *			Rays are clipped to the grid first so the walk doesn't need bounds checks.
+	 */
+	void RaycastBatch(RayBatch& batch) const;
+
+	/**
+	 * @brief	CheckBoxCollision for multiple positions with the same box size
+	 * @param	outHits	count elements, true if that box collides
+	 */
+	void CheckBoxCollisionBatch(const AEVec2* positions, int count, const AEVec2& size, bool* outHits) const;
 
-	void HandleBoxCollision(AEVec2& currentPosition, AEVec2& velocity, const AEVec2& nextPosition, const AEVec2& size, bool ifSlide = false);
+	/**
+	 * @brief	Moves a box by displacement, stopping at solid tiles.
+	 *			Moves along x then y, each axis checks every cell the box covers, so any box size works.
+	 *			Boxes already overlapping a tile aren't pushed out, they can only move out of it.
+	 * @param	position		Center of the box
+	 * @param	size			Full width / height
+	 * @param	displacement	Amount to move this frame
+	 * @param	ifSlide			If false, stops completely after the first axis hits
+	 */
+	SweepResult SweepBox(const AEVec2& position, const AEVec2& size, const AEVec2& displacement, bool ifSlide = true) const;
+
+	/**
+	 * @brief	Moves currentPosition towards nextPosition with SweepBox
+	 * @return	Contact normal, zero if nothing was hit
+	 */
+	AEVec2 HandleBoxCollision(AEVec2& currentPosition, AEVec2& velocity, const AEVec2& nextPosition, const AEVec2& size, bool ifSlide = false);
 
 private:
-	bool IsSolidAtGridCell(int x, int y) const;
+	bool IsSolidAtGridCell(int x, int y) const
+	{
+		if (x < 0 || x >= size.x || y < 0 || y >= size.y)
+			return false;
+
+		return (solidBits[(size_t)y * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+	}
+
+	// If any cell in [minX, maxX] of row y is solid. Range must be inside the grid.
+	bool RowHasSolid(int y, int minX, int maxX) const;
+
+	// DrawPolicy: debug drawing for each step, see RaycastDebugDraw / RaycastNoDebugDraw in MapGrid.cpp
+	template <typename DrawPolicy>
+	float RaycastImpl(const AEVec2& start, const AEVec2& end) const;
+
+	// Distance the box can move on one axis before touching a solid cell.
+	// perpMin / perpMax: range of cells covered on the other axis
+	float SweepAxis(float leadingEdge, float delta, int perpMin, int perpMax, bool isAxisX) const;
+
+	// Works out if a cell is solid from the tile types. Only used to build solidBits
+	bool ComputeIsSolid(int x, int y) const;
+	void UpdateSolidBits(int minX, int maxX, int y);
+
+	// Rebuilds the meshes of chunk (chunkX, chunkY) from the tiles
+	void BuildChunk(int chunkX, int chunkY);
 
 private:
 	std::vector<MapTile> tiles;
 	Vec2Int size;
 	int tileCount;
 
-	AEGfxVertexList* tileMesh = nullptr;
+	// 1 bit per cell, 1 = solid. Row major, each row starts on a new word.
+	// Updated in SetTile so collision queries don't need to check the tile types
+	std::vector<u64> solidBits;
+	int wordsPerRow;
+
+	// Tiles are drawn in chunks the size of a room (ROOM_COLS x ROOM_ROWS).
+	// Each chunk has 1 static mesh per texture, in world units.
+	// SetTile only marks its chunk dirty, the chunk is rebuilt when it is next drawn.
+	struct Chunk
+	{
+		// Indexed by the first MapTile::Type using the texture, has every tile type with that texture.
+		// nullptr if the chunk has none of those types
+		AEGfxVertexList* meshes[MapTile::typeCount]{};
+		bool isDirty = true;
+	};
+	std::vector<Chunk> chunks;	// Row major
+	Vec2Int chunkCount;
 
-	AEGfxTexture* surfaceTexture = nullptr;
-	AEGfxTexture* bodyTexture = nullptr;    // tile_middle.png
-	AEGfxTexture* bottomTexture = nullptr;  // tile_bottom.png
-	AEGfxTexture* platformTexture = nullptr;
+	// Indexed by MapTile::Type. Usually all in the same atlas
+	TextureAtlas::Region tileRegions[MapTile::typeCount];
 
 
 	int WorldToIndex(const AEVec2& worldPosition);
 	int WorldToIndex(float x, float y);
 
-	inline void WorldToGridCoords(const AEVec2& worldPosition, int& outX, int& outY);
+	inline void WorldToGridCoords(const AEVec2& worldPosition, int& outX, int& outY) const;
 	inline void WorldToGridCoordsClamped(const AEVec2& worldPosition, int& outX, int& outY);
 };
\ No newline at end of file
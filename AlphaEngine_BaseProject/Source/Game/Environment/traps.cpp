@@ -7,6 +7,7 @@
 
 #include "../../Game/Player/Player.h"
 #include "../../Utils/QuickGraphics.h"
+#include "../../Utils/Renderer.h"
 
 // ---------- AABB overlap ----------
 static inline float MinX(const Box& b) { return b.position.x; }
@@ -14,8 +15,7 @@ static inline float MinY(const Box& b) { return b.position.y; }
 static inline float MaxX(const Box& b) { return b.position.x + b.size.x; }
 static inline float MaxY(const Box& b) { return b.position.y + b.size.y; }
 
-AEGfxTexture* SpikePlate::s_spikeTexture = nullptr;
-AEGfxVertexList* SpikePlate::s_spikeMeshes[4] = { nullptr, nullptr, nullptr, nullptr };
+TextureAtlas::Region SpikePlate::s_spikeRegion;
 bool SpikePlate::s_resourcesLoaded = false;
 
 bool IntersectsBox(const Box& a, const Box& b)
@@ -65,31 +65,12 @@ Box MakePlayerBodyBox(const Player& p)
     return b;
 }
 
-AEGfxVertexList* SpikePlate::MakeSpikeMesh(int frame)
-{
-    const float uMin = frame * 0.25f;
-    const float uMax = (frame + 1) * 0.25f;
-
-    AEGfxMeshStart();
-    AEGfxTriAdd(-0.5f, -0.5f, 0xFFFFFFFF, uMin, 1.f,
-        0.5f, -0.5f, 0xFFFFFFFF, uMax, 1.f,
-        -0.5f, 0.5f, 0xFFFFFFFF, uMin, 0.f);
-
-    AEGfxTriAdd(0.5f, -0.5f, 0xFFFFFFFF, uMax, 1.f,
-        0.5f, 0.5f, 0xFFFFFFFF, uMax, 0.f,
-        -0.5f, 0.5f, 0xFFFFFFFF, uMin, 0.f);
-
-    return AEGfxMeshEnd();
-}
-
 void SpikePlate::LoadSharedRenderResources()
 {
     if (s_resourcesLoaded)
         return;
 
-    s_spikeTexture = AEGfxTextureLoad("Assets/Tmp/spikes.png");
-    for (int i = 0; i < 4; ++i)
-        s_spikeMeshes[i] = MakeSpikeMesh(i);
+    s_spikeRegion = TextureAtlas::Acquire("Assets/Tmp/spikes.png");
 
     s_resourcesLoaded = true;
 }
@@ -99,19 +80,10 @@ void SpikePlate::UnloadSharedRenderResources()
     if (!s_resourcesLoaded)
         return;
 
-    if (s_spikeTexture)
+    if (s_spikeRegion.texture)
     {
-        AEGfxTextureUnload(s_spikeTexture);
-        s_spikeTexture = nullptr;
-    }
-
-    for (int i = 0; i < 4; ++i)
-    {
-        if (s_spikeMeshes[i])
-        {
-            AEGfxMeshFree(s_spikeMeshes[i]);
-            s_spikeMeshes[i] = nullptr;
-        }
+        TextureAtlas::Release(s_spikeRegion);
+        s_spikeRegion = {};
     }
 
     s_resourcesLoaded = false;
@@ -135,7 +107,7 @@ void Trap::Update(float dt, Player& player)
     }
 
 
-    const bool overlap = IntersectsBox(m_box, playerBox);
+    const bool overlap = m_nearPlayer && IntersectsBox(m_box, playerBox);
 
     if (overlap && !m_prevOverlap) OnPlayerEnter(player);
     if (overlap)                   OnPlayerStay(dt, player);
@@ -343,7 +315,7 @@ void SpikePlate::OnPlayerStay(float, Player& player)
 
 void SpikePlate::Render() const
 {
-    if (!s_resourcesLoaded || !s_spikeTexture)
+    if (!s_resourcesLoaded || !s_spikeRegion.texture)
         return;
 
     int frame = m_animFrame;
@@ -360,23 +332,57 @@ void SpikePlate::Render() const
     // using box size
     AEMtx33ScaleApply(&m, &m, box.size.x * Camera::scale, box.size.y * Camera::scale);
 
-    AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
-    AEGfxSetBlendMode(AE_GFX_BM_BLEND);
-    AEGfxSetColorToMultiply(1.f, 1.f, 1.f, 1.f);
-    AEGfxSetColorToAdd(0.f, 0.f, 0.f, 0.f);
-    AEGfxSetTransparency(1.f);
-    AEGfxTextureSet(s_spikeTexture, 0.f, 0.f);
-    AEGfxSetTransform(m.m);
-    AEGfxMeshDraw(s_spikeMeshes[frame], AE_GFX_MDM_TRIANGLES);
+    // 4 frames side by side, inside the spike region of the atlas
+    const TextureAtlas::Region& region = s_spikeRegion;
+    Renderer::DrawCommand command;
+    command.texture = region.texture;
+    command.transform = m;
+    command.u0 = region.u0 + frame * 0.25f * region.GetUVWidth();
+    command.u1 = region.u0 + (frame + 1) * 0.25f * region.GetUVWidth();
+    command.v0 = region.v0;
+    command.v1 = region.v1;
+    Renderer::Submit(command);
 }
 
 
 // ---------------- TrapManager ----------------
 void TrapManager::Update(float dt, Player& player)
 {
+    UpdateNearPlayer(player);
+
+    // Still update every trap for the timers / animations
     for (auto& t : m_traps) t->Update(dt, player);
 }
 
+void TrapManager::UpdateNearPlayer(const Player& player)
+{
+    if (m_indexDirty)
+    {
+        m_index.Clear();
+        for (auto& t : m_traps)
+        {
+            // Trap boxes are from the bottom left corner, SpatialHash uses the center
+            const Box& b = t->GetBox();
+            m_index.Insert(t.get(), { b.position.x + b.size.x * 0.5f, b.position.y + b.size.y * 0.5f }, b.size);
+        }
+        m_index.Build();
+        m_indexDirty = false;
+    }
+
+    for (auto& t : m_traps) t->SetNearPlayer(false);
+
+    // Box around both the feet and body boxes used by Trap::Update
+    const Box feet = MakePlayerFeetBox(player);
+    const Box body = MakePlayerBodyBox(player);
+    const float minX = (std::min)(feet.position.x, body.position.x);
+    const float minY = (std::min)(feet.position.y, body.position.y);
+    const float maxX = (std::max)(feet.position.x + feet.size.x, body.position.x + body.size.x);
+    const float maxY = (std::max)(feet.position.y + feet.size.y, body.position.y + body.size.y);
+
+    m_index.QueryBox({ (minX + maxX) * 0.5f, (minY + maxY) * 0.5f }, { maxX - minX, maxY - minY },
+        [](Trap* t) { t->SetNearPlayer(true); });
+}
+
 void TrapManager::Render() const
 {
     for (auto& t : m_traps) t->Render();
@@ -5,6 +5,8 @@
 
 #include "AEEngine.h"
 #include "../../Utils/Box.h" 
+#include "../../Utils/SpatialHash.h"
+#include "../../Utils/TextureAtlas.h"
 
 class Player;
 
@@ -32,6 +34,9 @@ public:
     const Box& GetBox() const { return m_box; }
     void SetBox(const Box& b) { m_box = b; }
 
+    // Set by TrapManager's broadphase. If false, skips the overlap test (player can't be touching it)
+    void SetNearPlayer(bool nearPlayer) { m_nearPlayer = nearPlayer; }
+
 protected:
     virtual void OnPlayerEnter(Player&) {}
     virtual void OnPlayerStay(float, Player&) {}
@@ -44,6 +49,7 @@ private:
 
     bool m_prevOverlap = false;
     bool m_triggered = false;
+    bool m_nearPlayer = true;
 };
 
 class LavaPool final : public Trap
@@ -91,7 +97,6 @@ protected:
     void OnPlayerStay(float dt, Player& player) override;
 
 private:
-    static AEGfxVertexList* MakeSpikeMesh(int frame);
     float m_upTime = 1.f;
     float m_downTime = 1.f;
     int   m_damageOnHit = 10;
@@ -106,8 +111,7 @@ private:
     int   m_animFrame = 0;   // 0~3
     float m_animTimer = 0.f;
 
-    static AEGfxTexture* s_spikeTexture;
-    static AEGfxVertexList* s_spikeMeshes[4];
+    static TextureAtlas::Region s_spikeRegion;
     static bool s_resourcesLoaded;
 };
 
@@ -120,12 +124,24 @@ public:
         auto u = std::make_unique<T>(std::forward<Args>(args)...);
         T& ref = *u;
         m_traps.emplace_back(std::move(u));
+        m_indexDirty = true;
         return ref;
     }
 
     void Update(float dt, Player& player);
+    // Spikes are submitted to the Renderer, drawn at the next Renderer::Flush
     void Render() const;
 
+    // Call after moving / resizing a trap with SetBox
+    void MarkIndexDirty() { m_indexDirty = true; }
+
 private:
+    // Marks which traps the player could be touching
+    void UpdateNearPlayer(const Player& player);
+
     std::vector<std::unique_ptr<Trap>> m_traps;
+
+    // Traps don't move, only rebuilt when traps are added
+    SpatialHash<Trap*> m_index;
+    bool m_indexDirty = true;
 };
\ No newline at end of file
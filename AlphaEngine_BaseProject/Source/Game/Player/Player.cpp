@@ -5,11 +5,14 @@
 #include "Player.h"
 #include "../Camera.h"
 #include "../../Utils/QuickGraphics.h"
+#include "../../Utils/Renderer.h"
 #include "../../Utils/AEExtras.h"
 #include "../../Utils/Event/EventSystem.h"
 #include "../../Editor/Editor.h"
 #include "../../Game/Time.h"
 #include "../UI.h"
+#include "../../Utils/Profiler.h"
+#include "../../Utils/MemoryTracker.h"
 #include "../../Utils/PhysicsUtils.h"
 #include "../AudioManager.h"
 
@@ -33,6 +36,7 @@ Player::Player(MapGrid* map, EnemyManager* enemyManager) :
     map(map),
     enemyManager(enemyManager)
 {
+    MEMORY_SCOPE(Player);
     Reset(AEVec2{ 10, 10 });
 
     particleSystem.Init();
@@ -52,6 +56,13 @@ Player::~Player()
 
 void Player::Update()
 {
+    PROFILE_SCOPE("Player::Update");
+    MEMORY_SCOPE(Player);
+
+    previousPosition = position;
+
+    HandleAnimEndEvents();
+
     if (IsDead())
     {
         UpdateAnimation();
@@ -99,32 +110,30 @@ void Player::Update()
 
 void Player::Render()
 {
+    MEMORY_SCOPE(Player);
     particleSystem.Render();
 
     // Local scale. For flipping sprite's facing direction
     // Multiply height by 0.74f because sprite aspect ratio isn't a square
     constexpr float scale = 2.f;
+    const AEVec2 renderPosition = GetRenderPosition();
     AEMtx33Scale(&transform, isFacingRight ? scale : -scale, scale * 0.74f);
     AEMtx33TransApply(
         &transform,
         &transform,
-        position.x - (0.5f - sprite.metadata.pivot.x),
-        position.y + (0.5f - sprite.metadata.pivot.y)
+        renderPosition.x - (0.5f - sprite.metadata.pivot.x),
+        renderPosition.y + (0.5f - sprite.metadata.pivot.y)
     );
     // Camera scale. Scales translation too.
     AEMtx33ScaleApply(&transform, &transform, Camera::scale, Camera::scale);
-    AEGfxSetTransform(transform.m);
-    
-    // maybe remove, dash time is quite short player might not notice
-    if (IsInvincible())
-        AEGfxSetTransparency(0.5f);
-
-    sprite.Render();
 
-    AEGfxSetTransparency(1.f);
+    // maybe remove, dash time is quite short player might not notice
+    sprite.Render(transform, IsInvincible() ? Renderer::ToColor(1.f, 1.f, 1.f, 0.5f) : 0xFFFFFFFF);
 
     if (Editor::GetShowColliders())
     {
+        // On top of the sprite
+        Renderer::Flush();
         //RenderDebugCollider(stats.groundChecker);
         //RenderDebugCollider(stats.ceilingChecker);
         //RenderDebugCollider(stats.leftWallChecker);
@@ -153,12 +162,15 @@ void Player::Render()
 void Player::Reset(const AEVec2& initialPos)
 {
     position = initialPos;
+    previousPosition = initialPos;
     AEVec2Zero(&velocity);
     AEMtx33Identity(&transform);
     
     AEVec2Set(&inputDirection, 1.f, 0.f);
     isJumpHeld = false;
     lastJumpPressed = -1.f;
+    isJumpLatched = false;
+    isDashLatched = false;
     ifReleaseJumpAfterJumping = true;
 
     isFacingRight = true;
@@ -198,6 +210,11 @@ const AEVec2& Player::GetPosition() const
     return position;
 }
 
+AEVec2 Player::GetRenderPosition() const
+{
+    return AEExtras::Lerp(previousPosition, position, Time::GetInstance().GetInterpolationAlpha());
+}
+
 int Player::GetHealth() const
 {
     return health;
@@ -241,11 +258,18 @@ void Player::UpdateInput()
     inputDirection.y = (f32)((AEInputCheckCurr(AEVK_UP) || AEInputCheckCurr(AEVK_W))
                      - (AEInputCheckCurr(AEVK_DOWN) || AEInputCheckCurr(AEVK_S)));
 
+    // Triggered keys only count on the first tick of the frame, or else they'd be pressed again every tick
+    const bool isFirstTick = Time::GetInstance().GetTicksThisFrame() == 0;
+    const bool isJumpTriggered = isJumpLatched || (isFirstTick && (AEInputCheckTriggered(AEVK_SPACE) || AEInputCheckTriggered(AEVK_C)));
+    const bool isDashTriggered = isDashLatched || (isFirstTick && AEInputCheckTriggered(AEVK_Z));
+    isJumpLatched = false;
+    isDashLatched = false;
+
     isJumpHeld = AEInputCheckCurr(AEVK_SPACE) || AEInputCheckCurr(AEVK_C);
-    if (AEInputCheckTriggered(AEVK_SPACE) || AEInputCheckTriggered(AEVK_C))
+    if (isJumpTriggered)
         lastJumpPressed = currTime;
 
-    if (inputDirection.x != 0 && (!IsAttacking() || AEInputCheckTriggered(AEVK_Z)))
+    if (inputDirection.x != 0 && (!IsAttacking() || isDashTriggered))
         isFacingRight = inputDirection.x > 0;
 
     if (AEInputCheckCurr(AEVK_X))
@@ -255,6 +279,15 @@ void Player::UpdateInput()
         dashStartTime = currTime;
 }
 
+void Player::LatchInput()
+{
+    if (Time::GetInstance().GetTicksThisFrame() > 0)
+        return;
+
+    isJumpLatched |= AEInputCheckTriggered(AEVK_SPACE) || AEInputCheckTriggered(AEVK_C);
+    isDashLatched |= static_cast<bool>(AEInputCheckTriggered(AEVK_Z));
+}
+
 void Player::UpdateTriggerColliders()
 {
     bool wasGroundCollided = isGroundCollided;
@@ -395,7 +428,7 @@ void Player::HandleGravity()
         if (!isJumpHeld)
             acceleration *= stats.gravityMultiplierWhenRelease;
         
-        velocity.y = max(velocity.y + acceleration * dt, maxFallSpeed);
+        velocity.y = (std::max)(velocity.y + acceleration * dt, maxFallSpeed);
     }
 }
 
@@ -486,9 +519,7 @@ void Player::SetAttack(AnimState toState)
     
     //AudioManager::PlayNextAttackSFX();
 
-    sprite.SetState(toState, false,
-        [this](int index) { OnAttackAnimEnd(index); }
-    );
+    sprite.SetState(toState, false, true);
 }
 
 void Player::AttackDamageable(IDamageable& damageable, const AttackStats& attack, bool isGroundAttack)
@@ -552,10 +583,10 @@ void Player::UpdateAttacks()
     // Check if attack hit enemy
     if (enemyManager)
     {
-        enemyManager->ForEachDamageable([&](IDamageable& obj) {
-            // If hit enemy && current enemy isn't in attackedEnemies
-            bool ifAttack = PhysicsUtils::AABB(colliderPos, attack->collider.size, obj.GetHurtboxPos(), obj.GetHurtboxSize()) &&
-                            std::find(attackedEnemies.cbegin(), attackedEnemies.cend(), &obj) == attackedEnemies.cend();
+        // Only gives the ones overlapping the attack collider
+        enemyManager->ForEachDamageableInBox(colliderPos, attack->collider.size, [&](IDamageable& obj) {
+            // If current enemy isn't in attackedEnemies
+            bool ifAttack = std::find(attackedEnemies.cbegin(), attackedEnemies.cend(), &obj) == attackedEnemies.cend();
 
             if (ifAttack)
                 AttackDamageable(obj, *attack, isGroundAttack);
@@ -566,6 +597,23 @@ void Player::UpdateAttacks()
         QuickGraphics::DrawRect(colliderPos, attack->collider.size, 0xFF8888FF);
 }
 
+void Player::HandleAnimEndEvents()
+{
+    for (const Animator::AnimEndEvent& animEndEvent : Animator::GetAnimEndEvents())
+    {
+        if (!sprite.IsAnimEndEvent(animEndEvent))
+            continue;
+
+        if (animEndEvent.state == AnimState::DEATH)
+        {
+            sprite.SetState(AnimState::DEATH_LOOP);
+            //AudioManager::PlayMusic(MusicId::Death);
+        }
+        else
+            OnAttackAnimEnd(animEndEvent.state);
+    }
+}
+
 void Player::OnAttackAnimEnd(int spriteStateIndex)
 {
     AnimState spriteState = static_cast<AnimState>(spriteStateIndex);
@@ -603,8 +651,8 @@ IDamageable* Player::IfCollideEnemy(const Box& collider)
     IDamageable* collidedEnemy = nullptr;
 
     // Will override collidedEnemy but not solving for now
-    enemyManager->ForEachDamageable([&](IDamageable& obj) {
-        if (!obj.IsDead() && PhysicsUtils::AABB(collider.position, collider.size, obj.GetHurtboxPos(), obj.GetHurtboxSize()))
+    enemyManager->ForEachDamageableInBox(collider.position, collider.size, [&](IDamageable& obj) {
+        if (!obj.IsDead())
             collidedEnemy = &obj;
     });
 
@@ -705,7 +753,7 @@ void Player::OnBuffSelected(const BuffSelectedEvent& ev)
     case CARD_TYPE::HERMES_FAVOR:   buff_MoveSpeedMulti     *= PercentToScale(card.effectValue1); break;
     case CARD_TYPE::IRON_DEFENCE:   buff_DmgReduction       *= PercentToScaleInvert(card.effectValue1); break;
     case CARD_TYPE::REVITALIZE: {
-        healAmt = min(static_cast<int>(card.effectValue1 / 100.f * maxHealth), maxHealth - health);
+        healAmt = (std::min)(static_cast<int>(card.effectValue1 / 100.f * maxHealth), maxHealth - health);
         EventSystem::Subscribe<OverlayFadeCompleteEvent>([this, healAmt](const OverlayFadeCompleteEvent& ev) {
             (void)ev;
             UI::GetDamageTextSpawner().SpawnDamageText(healAmt, DAMAGE_TYPE_HEAL, position, { 0.f, 1.f }); });
@@ -760,22 +808,20 @@ bool Player::TryTakeDamage(int dmg, const AEVec2& hitOrigin, DAMAGE_TYPE type)
     if (health <= dmg)
     {
         health = 0;
-        EventSystem::Trigger<PlayerDeathEvent>({ *this });
-        sprite.SetState(AnimState::DEATH, false, [&](int) {
-            sprite.SetState(AnimState::DEATH_LOOP); 
-            //AudioManager::PlayMusic(MusicId::Death);
-        });
+        // Queued, this is usually called while looping through attacks
+        EventSystem::Queue<PlayerDeathEvent>({ *this });
+        sprite.SetState(AnimState::DEATH, false, true);
         return false;
     }
 
     health -= dmg;
     
-    float knockbackStrength = max(dmg / stats.maxKnockbackDmg, 1.f) * stats.knockbackAmt;
+    float knockbackStrength = (std::max)(dmg / stats.maxKnockbackDmg, 1.f) * stats.knockbackAmt;
 
     // Calculate knockback direction based on hit origin
     AEVec2 hitDirection = position - hitOrigin;
     AEVec2Normalize(&hitDirection, &hitDirection);
-    hitDirection.y = max(hitDirection.y, 0.4f);
+    hitDirection.y = (std::max)(hitDirection.y, 0.4f);
     velocity = hitDirection * knockbackStrength;
 
 
@@ -50,10 +50,17 @@ public:
 
     Player(MapGrid* map, EnemyManager* enemyManager);
     ~Player();
+    // Runs in GameScene::FixedUpdate
     void Update();
     void Render();
     void Reset(const AEVec2& initialPos);
 
+    /**
+     * @brief   Call once a frame, after the ticks. AEInputCheckTriggered is only true for 1 frame,
+     *          so keys pressed on a frame that didn't run a tick are kept for the next tick.
+     */
+    void LatchInput();
+
     // === Inspectable ===
     void DrawInspector() override;
     bool CheckIfClicked(const AEVec2& mousePos) override;
@@ -66,6 +73,7 @@ public:
 
     // === Getters ===
     const AEVec2&       GetPosition() const;
+    AEVec2              GetRenderPosition() const;  // Between the last 2 ticks' positions
     const PlayerStats&  GetStats()    const;
     float   GetDashCooldownPercentage() const;
     int     GetHealth()     const;
@@ -87,9 +95,13 @@ private:
     f64 lastJumpPressed = -1.f;
     bool ifReleaseJumpAfterJumping = true;
     f64 lastAttackHeld = -1.f;
+    // Triggered keys from frames without a tick, see LatchInput
+    bool isJumpLatched = false;
+    bool isDashLatched = false;
 
     // === Movement data ===
     AEVec2 position;
+    AEVec2 previousPosition;    // Position before the last tick, for render interpolation
     AEVec2 velocity;
     bool isFacingRight;
     f64 lastJumpTime = -1.f;
@@ -150,6 +162,10 @@ private:
     void SetAttack(AnimState toState);
     void AttackDamageable(IDamageable& damageable, const AttackStats& attack, bool isGroundAttack);
     void UpdateAttacks();
+    /**
+     * @brief Handles the sprite's Animator::AnimEndEvent from the last frame
+     */
+    void HandleAnimEndEvents();
     void OnAttackAnimEnd(int spriteStateIndex);
     IDamageable* IfCollideEnemy(const Box& collider);
     float GetSlamAttackScale();
@@ -1,45 +1,116 @@
 #include "RoomBuilder.h"
 
 #include "../Scene/LevelIO.h"
-#include <algorithm>
+#include "../enemy/EnemyManager.h"
+#include <cmath>
 
 namespace
 {
+    int GetTile(const LevelData& lvl, int x, int y)
+    {
+        if (x < 0 || x >= lvl.cols || y < 0 || y >= lvl.rows)
+            return static_cast<int>(MapTile::Type::NONE);
+
+        return lvl.tiles[static_cast<size_t>(y) * static_cast<size_t>(lvl.cols) + static_cast<size_t>(x)];
+    }
 
+    // Platforms can be jumped / dropped through, but not walked through
+    bool IsOpenTile(int tile, bool isVertical)
+    {
+        return tile == static_cast<int>(MapTile::Type::NONE) ||
+            (isVertical && tile == static_cast<int>(MapTile::Type::PLATFORM));
+    }
 
-    RoomID RoomIdFromGrid(int rx, int ry)
+    // True if the player can get from the room to the next one in dir,
+    // i.e. the tiles on both sides of the shared edge are open somewhere along it
+    bool HasOpening(const LevelData& lvl, const RoomData& room, RoomDirection dir)
     {
-        if (rx == 0 && ry == 0) return ROOM_1;
-        if (rx == 1 && ry == 0) return ROOM_2;
-        if (rx == 2 && ry == 0) return ROOM_3;
-        if (rx == 2 && ry == 1) return ROOM_4;
-        if (rx == 1 && ry == 1) return ROOM_5;
-        if (rx == 0 && ry == 1) return ROOM_6;
-        if (rx == 0 && ry == 2) return ROOM_7;
-        if (rx == 1 && ry == 2) return ROOM_8;
-        if (rx == 2 && ry == 2) return ROOM_9;
-        if (rx == 3 && ry == 2) return ROOM_10;
-        if (rx == 3 && ry == 1) return ROOM_11;
-
-        return ROOM_NONE;
+        const int ox = room.gridX * ROOM_COLS;
+        const int oy = room.gridY * ROOM_ROWS;
+
+        switch (dir)
+        {
+        case DIR_LEFT:
+        case DIR_RIGHT:
+        {
+            const int x = (dir == DIR_LEFT) ? ox : ox + ROOM_COLS - 1;
+            const int nextX = (dir == DIR_LEFT) ? x - 1 : x + 1;
+            for (int y = oy; y < oy + ROOM_ROWS; ++y)
+            {
+                if (IsOpenTile(GetTile(lvl, x, y), false) && IsOpenTile(GetTile(lvl, nextX, y), false))
+                    return true;
+            }
+            return false;
+        }
+        case DIR_TOP:
+        case DIR_BOTTOM:
+        {
+            const int y = (dir == DIR_BOTTOM) ? oy : oy + ROOM_ROWS - 1;
+            const int nextY = (dir == DIR_BOTTOM) ? y - 1 : y + 1;
+            for (int x = ox; x < ox + ROOM_COLS; ++x)
+            {
+                if (IsOpenTile(GetTile(lvl, x, y), true) && IsOpenTile(GetTile(lvl, x, nextY), true))
+                    return true;
+            }
+            return false;
+        }
+        default:
+            return false;
+        }
     }
 
-    bool PointInRoom(const AEVec2& p, int roomX, int roomY)
+    // Index of the room sized cell that contains p, -1 if it's outside the level
+    int GetCellIndex(const AEVec2& p, int roomsX, int roomsY)
     {
-        const float minX = static_cast<float>(roomX * ROOM_COLS);
-        const float minY = static_cast<float>(roomY * ROOM_ROWS);
-        const float maxX = minX + static_cast<float>(ROOM_COLS);
-        const float maxY = minY + static_cast<float>(ROOM_ROWS);
+        const int rx = static_cast<int>(std::floor(p.x / static_cast<float>(ROOM_COLS)));
+        const int ry = static_cast<int>(std::floor(p.y / static_cast<float>(ROOM_ROWS)));
+        if (rx < 0 || rx >= roomsX || ry < 0 || ry >= roomsY)
+            return -1;
 
-        return p.x >= minX && p.x < maxX &&
-            p.y >= minY && p.y < maxY;
+        return ry * roomsX + rx;
+    }
+
+    AEVec2 ToRoomSpace(const AEVec2& p, const RoomData& room)
+    {
+        return {
+            p.x - room.gridX * static_cast<float>(ROOM_COLS),
+            p.y - room.gridY * static_cast<float>(ROOM_ROWS)
+        };
+    }
+
+    // Depth is the number of rooms between the start room and each room,
+    // only going through edges that have an opening. Unreachable rooms stay at 0.
+    void ComputeRoomDepths(const LevelData& lvl, RoomManager& roomMgr, RoomID startRoom)
+    {
+        std::vector<bool> isReached(static_cast<size_t>(roomMgr.GetRoomCount()), false);
+        std::vector<RoomID> queue;
+        queue.reserve(isReached.size());
+
+        isReached[startRoom] = true;
+        queue.push_back(startRoom);
+
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            const RoomData& room = roomMgr.GetRoom(queue[i]);
+            for (int dir = DIR_TOP; dir < DIR_COUNT; ++dir)
+            {
+                const RoomID next = room.neighbors[dir];
+                if (next == ROOM_NONE || isReached[next] ||
+                    !HasOpening(lvl, room, static_cast<RoomDirection>(dir)))
+                    continue;
+
+                isReached[next] = true;
+                roomMgr.GetRoom(next).depth = room.depth + 1;
+                queue.push_back(next);
+            }
+        }
     }
 }
 
 void BuildRoomsFromLevelData(const LevelData& lvl, RoomManager& roomMgr, RoomID& outStartRoom)
 {
     roomMgr.Clear();
-    outStartRoom = ROOM_1;
+    outStartRoom = ROOM_NONE;
 
     if (lvl.cols <= 0 || lvl.rows <= 0)
         return;
@@ -50,50 +121,43 @@ void BuildRoomsFromLevelData(const LevelData& lvl, RoomManager& roomMgr, RoomID&
     if (roomsX <= 0 || roomsY <= 0)
         return;
 
-    const int totalRooms = roomsX * roomsY;
-    const int roomCountToUse = (std::min)(totalRooms, ROOM_COUNT);
+    // Every cell with a tile or a spawn in it is a room
+    const size_t cellCount = static_cast<size_t>(roomsX) * static_cast<size_t>(roomsY);
+    std::vector<bool> isCellUsed(cellCount, false);
 
-    for (int i = 0; i < roomCountToUse; ++i)
+    for (int y = 0; y < roomsY * ROOM_ROWS; ++y)
     {
-        const int rx = i % roomsX;
-        const int ry = i / roomsX;
-
-        RoomData room{};
-        room.id = RoomIdFromGrid(rx, ry);
-
-        if (room.id == ROOM_NONE)
-            continue;
-
-        room.gridX = rx;
-        room.gridY = ry;
-
-        room.topRoom = RoomIdFromGrid(rx, ry + 1);
-        room.leftRoom = RoomIdFromGrid(rx - 1, ry);
-        room.bottomRoom = RoomIdFromGrid(rx, ry - 1);
-        room.rightRoom = RoomIdFromGrid(rx + 1, ry);
-
-        // Tiles
-        for (int y = 0; y < ROOM_ROWS; ++y)
+        for (int x = 0; x < roomsX * ROOM_COLS; ++x)
         {
-            for (int x = 0; x < ROOM_COLS; ++x)
-            {
-                const int globalX = rx * ROOM_COLS + x;
-                const int globalY = ry * ROOM_ROWS + y;
+            if (GetTile(lvl, x, y) != static_cast<int>(MapTile::Type::NONE))
+                isCellUsed[(y / ROOM_ROWS) * roomsX + x / ROOM_COLS] = true;
+        }
+    }
 
-                int v = static_cast<int>(MapTile::Type::NONE);
-                if (globalX >= 0 && globalX < lvl.cols &&
-                    globalY >= 0 && globalY < lvl.rows)
-                {
-                    v = lvl.tiles[static_cast<size_t>(globalY) * static_cast<size_t>(lvl.cols) +
-                        static_cast<size_t>(globalX)];
-                }
+    for (const auto& e : lvl.enemies)
+    {
+        const int cell = GetCellIndex(e.pos, roomsX, roomsY);
+        if (cell >= 0)
+            isCellUsed[cell] = true;
+    }
 
-                if (v < 0 || v >= MapTile::typeCount)
-                    v = static_cast<int>(MapTile::Type::NONE);
+    for (const auto& t : lvl.traps)
+    {
+        const int cell = GetCellIndex(t.pos, roomsX, roomsY);
+        if (cell >= 0)
+            isCellUsed[cell] = true;
+    }
 
-                room.tiles[y][x] = static_cast<MapTile::Type>(v);
-            }
-        }
+    // Rooms are numbered row by row
+    std::vector<RoomID> cellRooms(cellCount, ROOM_NONE);
+    for (size_t cell = 0; cell < cellCount; ++cell)
+    {
+        if (!isCellUsed[cell])
+            continue;
+
+        RoomData room{};
+        room.gridX = static_cast<int>(cell) % roomsX;
+        room.gridY = static_cast<int>(cell) / roomsX;
 
         // Default entry points
         room.entryFromLeft = { 3.0f, 3.0f };
@@ -104,60 +168,60 @@ void BuildRoomsFromLevelData(const LevelData& lvl, RoomManager& roomMgr, RoomID&
         // Default spawn
         room.startSpawn = { 2.5f, 3.0f };
 
-        // Player start room
-        if (PointInRoom(lvl.spawn, rx, ry))
-        {
-            room.startSpawn = {
-                lvl.spawn.x - rx * static_cast<float>(ROOM_COLS),
-                lvl.spawn.y - ry * static_cast<float>(ROOM_ROWS)
-            };
-            outStartRoom = room.id;
-        }
+        cellRooms[cell] = roomMgr.AddRoom(room);
+    }
 
-        // Enemies
-        for (const auto& e : lvl.enemies)
-        {
-            if (!PointInRoom(e.pos, rx, ry))
-                continue;
-
-            if (room.enemyCount >= MAX_ROOM_ENEMIES)
-                continue;
-
-            room.enemies[room.enemyCount].preset = e.preset;
-            room.enemies[room.enemyCount].pos = {
-                e.pos.x - rx * static_cast<float>(ROOM_COLS),
-                e.pos.y - ry * static_cast<float>(ROOM_ROWS)
-            };
-            ++room.enemyCount;
-        }
+    if (roomMgr.GetRoomCount() == 0)
+        return;
 
-        // Traps
-        for (const auto& t : lvl.traps)
-        {
-            if (!PointInRoom(t.pos, rx, ry))
-                continue;
-
-            if (room.trapCount >= MAX_ROOM_TRAPS)
-                continue;
-
-            RoomTrapSpawn& dst = room.traps[room.trapCount];
-            dst.id = t.id;                  // NEW
-            dst.type = t.type;
-            dst.pos = {
-                t.pos.x - rx * static_cast<float>(ROOM_COLS),
-                t.pos.y - ry * static_cast<float>(ROOM_ROWS)
-            };
-            dst.size = t.size;
-            dst.upTime = t.upTime;
-            dst.downTime = t.downTime;
-            dst.damageOnHit = t.damageOnHit;
-            dst.startDisabled = t.startDisabled;
-            dst.damagePerTick = t.damagePerTick;
-            dst.tickInterval = t.tickInterval;
-            dst.links = t.links;            // NEW
-            ++room.trapCount;
-        }
+    // Enemies
+    for (const auto& e : lvl.enemies)
+    {
+        const int cell = GetCellIndex(e.pos, roomsX, roomsY);
+        if (cell < 0)
+            continue;
+
+        RoomData& room = roomMgr.GetRoom(cellRooms[cell]);
+        RoomEnemySpawn& dst = room.enemies.emplace_back();
+        dst.preset = e.preset;
+        dst.pos = ToRoomSpace(e.pos, room);
 
-        roomMgr.SetRoom(room.id, room);
+        if (static_cast<EnemySpawnType>(e.preset) == EnemySpawnType::Boss)
+            room.hasBoss = true;
     }
-}
\ No newline at end of file
+
+    // Traps
+    for (const auto& t : lvl.traps)
+    {
+        const int cell = GetCellIndex(t.pos, roomsX, roomsY);
+        if (cell < 0)
+            continue;
+
+        RoomData& room = roomMgr.GetRoom(cellRooms[cell]);
+        RoomTrapSpawn& dst = room.traps.emplace_back();
+        dst.id = t.id;
+        dst.type = t.type;
+        dst.pos = ToRoomSpace(t.pos, room);
+        dst.size = t.size;
+        dst.upTime = t.upTime;
+        dst.downTime = t.downTime;
+        dst.damageOnHit = t.damageOnHit;
+        dst.startDisabled = t.startDisabled;
+        dst.damagePerTick = t.damagePerTick;
+        dst.tickInterval = t.tickInterval;
+        dst.links = t.links;
+    }
+
+    // Player start room, the first room if the spawn isn't in one
+    outStartRoom = 0;
+    const int spawnCell = GetCellIndex(lvl.spawn, roomsX, roomsY);
+    if (spawnCell >= 0 && cellRooms[spawnCell] != ROOM_NONE)
+    {
+        outStartRoom = cellRooms[spawnCell];
+        RoomData& startRoom = roomMgr.GetRoom(outStartRoom);
+        startRoom.startSpawn = ToRoomSpace(lvl.spawn, startRoom);
+    }
+
+    roomMgr.LinkNeighbors();
+    ComputeRoomDepths(lvl, roomMgr, outStartRoom);
+}
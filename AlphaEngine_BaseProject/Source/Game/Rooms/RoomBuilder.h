@@ -6,6 +6,6 @@
 struct LevelData;
 
 // Builds a room graph from a single full level layout.
-// The level is sliced into ROOM_COLS x ROOM_ROWS chunks.
-// outStartRoom is set to the room that contains lvl.spawn.
+// The level is sliced into ROOM_COLS x ROOM_ROWS chunks, every chunk with a tile or a spawn becomes a room.
+// outStartRoom is set to the room that contains lvl.spawn, ROOM_NONE if the level has no rooms.
 void BuildRoomsFromLevelData(const LevelData& lvl, RoomManager& roomMgr, RoomID& outStartRoom);
\ No newline at end of file
@@ -6,34 +6,10 @@
 
 static constexpr int ROOM_COLS = 25;
 static constexpr int ROOM_ROWS = 14;
-static constexpr int MAX_ROOM_ENEMIES = 32;
-static constexpr int MAX_ROOM_TRAPS = 32;
-static constexpr int ROOM_COUNT = 20;
 
-enum RoomID
-{
-	ROOM_NONE = -1,
-	ROOM_1 = 0,
-	ROOM_2,
-	ROOM_3,
-	ROOM_4,
-	ROOM_5,
-	ROOM_6,
-	ROOM_7,
-	ROOM_8,
-	ROOM_9,
-	ROOM_10,
-	ROOM_11,
-	ROOM_12,
-	ROOM_13,
-	ROOM_14,
-	ROOM_15,
-	ROOM_16,
-	ROOM_17,
-	ROOM_18,
-	ROOM_19, 
-	ROOM_20
-};
+// Index into RoomManager's room array. Rooms are numbered in the order they're built
+using RoomID = int;
+static constexpr RoomID ROOM_NONE = -1;
 
 enum RoomDirection
 {
@@ -41,7 +17,9 @@ enum RoomDirection
 	DIR_TOP,
 	DIR_LEFT,
 	DIR_BOTTOM,
-	DIR_RIGHT
+	DIR_RIGHT,
+
+	DIR_COUNT
 };
 
 struct RoomEnemySpawn
@@ -73,12 +51,13 @@ struct RoomData
 	RoomID id = ROOM_NONE;
 	int gridX = 0;
 	int gridY = 0;
-	MapTile::Type tiles[ROOM_ROWS][ROOM_COLS]{};
 
-	RoomID topRoom = ROOM_NONE;
-	RoomID leftRoom = ROOM_NONE;
-	RoomID bottomRoom = ROOM_NONE;
-	RoomID rightRoom = ROOM_NONE;
+	// Rooms to walk through from the start room, used to scale enemies
+	int depth = 0;
+	bool hasBoss = false;
+
+	// Indexed by RoomDirection, ROOM_NONE if there's no room that way
+	RoomID neighbors[DIR_COUNT]{ ROOM_NONE, ROOM_NONE, ROOM_NONE, ROOM_NONE, ROOM_NONE };
 
 	AEVec2 startSpawn{ 2.5f, 2.5f };
 	AEVec2 entryFromTop{ 12.5f, 11.5f };
@@ -86,11 +65,6 @@ struct RoomData
 	AEVec2 entryFromBottom{ 12.5f, 1.5f };
 	AEVec2 entryFromRight{ 23.5f, 7.5f };
 
-	RoomEnemySpawn enemies[MAX_ROOM_ENEMIES]{};
-	int enemyCount = 0;
-
-	RoomTrapSpawn traps[MAX_ROOM_TRAPS]{};
-	int trapCount = 0;
-
-
+	std::vector<RoomEnemySpawn> enemies;
+	std::vector<RoomTrapSpawn> traps;
 };
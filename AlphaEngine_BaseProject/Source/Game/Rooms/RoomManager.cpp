@@ -8,42 +8,64 @@ RoomManager::RoomManager()
 
 void RoomManager::Clear()
 {
-	for (int i = 0; i < ROOM_COUNT; ++i)
-	{
-		roomUsed[i] = false;
-		rooms[i] = RoomData{};
-	}
+	rooms.clear();
+	roomLookup.clear();
 	currentRoom = ROOM_NONE;
 }
 
-bool RoomManager::HasRoom(RoomID id) const
+RoomID RoomManager::AddRoom(const RoomData& data)
 {
-	if (id < ROOM_1 || (int)id >= ROOM_COUNT)
-		return false;
+	const RoomID id = static_cast<RoomID>(rooms.size());
+	if (!roomLookup.emplace(GetGridKey(data.gridX, data.gridY), id).second)
+		return ROOM_NONE;
 
-	return roomUsed[(int)id];
+	rooms.push_back(data);
+	rooms.back().id = id;
+	return id;
 }
 
-void RoomManager::SetRoom(RoomID id, const RoomData& data)
+void RoomManager::LinkNeighbors()
 {
-	if (id < ROOM_1 || (int)id >= ROOM_COUNT)
-		return;
+	for (RoomData& room : rooms)
+	{
+		room.neighbors[DIR_TOP] = FindRoomAt(room.gridX, room.gridY + 1);
+		room.neighbors[DIR_LEFT] = FindRoomAt(room.gridX - 1, room.gridY);
+		room.neighbors[DIR_BOTTOM] = FindRoomAt(room.gridX, room.gridY - 1);
+		room.neighbors[DIR_RIGHT] = FindRoomAt(room.gridX + 1, room.gridY);
+	}
+}
 
-	rooms[(int)id] = data;
-	rooms[(int)id].id = id;
-	roomUsed[(int)id] = true;
+int RoomManager::GetRoomCount() const
+{
+	return static_cast<int>(rooms.size());
+}
+
+RoomID RoomManager::FindRoomAt(int gridX, int gridY) const
+{
+	auto it = roomLookup.find(GetGridKey(gridX, gridY));
+	return it != roomLookup.end() ? it->second : ROOM_NONE;
+}
+
+bool RoomManager::HasRoom(RoomID id) const
+{
+	return id >= 0 && id < GetRoomCount();
 }
 
 RoomData& RoomManager::GetRoom(RoomID id)
 {
-	assert(id >= ROOM_1 && (int)id < ROOM_COUNT);
-	return rooms[(int)id];
+	assert(HasRoom(id));
+	return rooms[id];
 }
 
 const RoomData& RoomManager::GetRoom(RoomID id) const
 {
-	assert(id >= ROOM_1 && (int)id < ROOM_COUNT);
-	return rooms[(int)id];
+	assert(HasRoom(id));
+	return rooms[id];
+}
+
+bool RoomManager::IsBossRoom(RoomID id) const
+{
+	return HasRoom(id) && rooms[id].hasBoss;
 }
 
 void RoomManager::SetCurrentRoom(RoomID id)
@@ -61,14 +83,14 @@ RoomID RoomManager::GetCurrentRoomID() const
 
 RoomData& RoomManager::GetCurrentRoom()
 {
-	assert(currentRoom != ROOM_NONE);
-	return rooms[(int)currentRoom];
+	assert(HasRoom(currentRoom));
+	return rooms[currentRoom];
 }
 
 const RoomData& RoomManager::GetCurrentRoom() const
 {
-	assert(currentRoom != ROOM_NONE);
-	return rooms[(int)currentRoom];
+	assert(HasRoom(currentRoom));
+	return rooms[currentRoom];
 }
 
 RoomID RoomManager::GetNeighbor(RoomID id, RoomDirection dir) const
@@ -76,16 +98,10 @@ RoomID RoomManager::GetNeighbor(RoomID id, RoomDirection dir) const
 	if (!HasRoom(id))
 		return ROOM_NONE;
 
-	const RoomData& room = rooms[(int)id];
+	if (dir <= DIR_NONE || dir >= DIR_COUNT)
+		return ROOM_NONE;
 
-	switch (dir)
-	{
-	case DIR_TOP:    return room.topRoom;
-	case DIR_LEFT:   return room.leftRoom;
-	case DIR_BOTTOM: return room.bottomRoom;
-	case DIR_RIGHT:  return room.rightRoom;
-	default:         return ROOM_NONE;
-	}
+	return rooms[id].neighbors[dir];
 }
 
 bool RoomManager::ChangeRoom(RoomDirection dir)
@@ -106,7 +122,7 @@ AEVec2 RoomManager::GetEntrySpawn(RoomID room, RoomDirection cameFrom) const
 	if (!HasRoom(room))
 		return AEVec2{ 2.5f, 2.5f };
 
-	const RoomData& r = rooms[(int)room];
+	const RoomData& r = rooms[room];
 
 	switch (cameFrom)
 	{
@@ -116,4 +132,9 @@ AEVec2 RoomManager::GetEntrySpawn(RoomID room, RoomDirection cameFrom) const
 	case DIR_RIGHT:  return r.entryFromRight;
 	default:         return r.startSpawn;
 	}
-}
\ No newline at end of file
+}
+
+u64 RoomManager::GetGridKey(int gridX, int gridY)
+{
+	return (static_cast<u64>(static_cast<u32>(gridX)) << 32) | static_cast<u32>(gridY);
+}
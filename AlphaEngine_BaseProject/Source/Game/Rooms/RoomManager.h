@@ -1,7 +1,10 @@
 #pragma once
 
 #include "RoomData.h"
+#include <unordered_map>
 
+// Room graph of a level. Rooms are stored in 1 array indexed by RoomID,
+// looked up by grid cell through a hash map, and linked to their neighbors by ID.
 class RoomManager
 {
 public:
@@ -9,11 +12,22 @@ public:
 
 	void Clear();
 
+	// Adds a room at data.gridX / gridY and returns its ID.
+	// Returns ROOM_NONE if that cell already has a room.
+	RoomID AddRoom(const RoomData& data);
+
+	// Links every room to the rooms next to it on the grid. Call after adding all rooms
+	void LinkNeighbors();
+
+	int GetRoomCount() const;
+	RoomID FindRoomAt(int gridX, int gridY) const;
+
 	bool HasRoom(RoomID id) const;
-	void SetRoom(RoomID id, const RoomData& data);
 	RoomData& GetRoom(RoomID id);
 	const RoomData& GetRoom(RoomID id) const;
 
+	bool IsBossRoom(RoomID id) const;
+
 	void SetCurrentRoom(RoomID id);
 	RoomID GetCurrentRoomID() const;
 
@@ -26,7 +40,9 @@ public:
 	AEVec2 GetEntrySpawn(RoomID room, RoomDirection cameFrom) const;
 
 private:
-	RoomData rooms[ROOM_COUNT];
-	bool roomUsed[ROOM_COUNT];
+	static u64 GetGridKey(int gridX, int gridY);
+
+	std::vector<RoomData> rooms;
+	std::unordered_map<u64, RoomID> roomLookup; // Grid key -> room
 	RoomID currentRoom;
 };
@@ -1,8 +1,8 @@
-#pragma once
-
 #include "RoomSystem.h"
 
 #include "../UI.h"
+#include "../../Utils/FrameArena.h"
+#include "../../Utils/Profiler.h"
 #include <algorithm>
 
 RoomSystem::RoomSystem(
@@ -35,22 +35,98 @@ void RoomSystem::BuildCurrentRoom(RoomDirection cameFrom, const AEVec2* forcedSp
     // Do NOT rebuild the full level map here.
     // GameScene::Init() already rebuilds the full map once.
 
+    // Entering the scene / restarting starts every room from its RoomData again
+    if (cameFrom == DIR_NONE)
+        ClearVisitedRooms();
+    else
+        StashActiveRoom();
+
     ClearRuntimeRoomObjects();
 
+    auto visited = visitedRooms.find(room.id);
+    if (visited != visitedRooms.end())
+    {
+        ActivateRoom(visited->second, true);
+        visitedRooms.erase(visited);
+    }
+    else
+    {
+        // Entering from another room, it's usually prepared by UpdatePrefetch already
+        if (cameFrom == DIR_NONE || prepared.id != room.id)
+        {
+            PROFILE_SCOPE("RoomSystem::PrepareRoom");
+            PrepareRoom(room, prepared);
+        }
+
+        ActivateRoom(prepared, false);
+    }
+
+    AEVec2 spawn{
+        roomOrigin.x + room.startSpawn.x,
+        roomOrigin.y + room.startSpawn.y
+    };
+
+    if (forcedSpawn)
+    {
+        spawn = *forcedSpawn;
+    }
+    else if (cameFrom != DIR_NONE)
+    {
+        const AEVec2 roomMin{
+            roomOrigin.x + 0.35f,
+            roomOrigin.y + 0.35f
+        };
+        const AEVec2 roomMax{
+            roomOrigin.x + static_cast<float>(ROOM_COLS) - 0.35f,
+            roomOrigin.y + static_cast<float>(ROOM_ROWS) - 0.35f
+        };
+
+        spawn = AEVec2{
+            std::clamp(spawn.x, roomMin.x, roomMax.x),
+            std::clamp(spawn.y, roomMin.y, roomMax.y)
+        };
+    }
+
+    // First entry into the scene = full reset.
+    // Room-to-room transition = just reposition.
+   /* if (cameFrom == DIR_NONE && forcedSpawn == nullptr)
+        player.Reset(spawn);
+    else
+        player.SetPosition(spawn);
+        */
+
+    const bool snapCamera = (cameFrom == DIR_NONE);
+    camera.SetFollow(&player.GetPosition(), 0.f, 0.f, snapCamera);
+    if (snapCamera)
+        camera.Update();
+
+    ApplyBlockedReturnBarrier();
+
+    if (roomMgr.IsBossRoom(roomMgr.GetCurrentRoomID()))
+        UI::StartBossIntro();
+}
+
+void RoomSystem::PrepareRoom(const RoomData& room, RoomObjects& out) const
+{
+    const AEVec2 roomOrigin = GetRoomOrigin(room.id);
+
+    out = RoomObjects{};
+    out.id = room.id;
+
     struct PendingPlateBinding
     {
         PressurePlate* plate = nullptr;
         const RoomTrapSpawn* def = nullptr;
     };
 
-    std::vector<PendingPlateBinding> pendingPlates;
-    std::vector<std::pair<int, Trap*>> spawnedById;
-    std::vector<Trap*> spawnedSpikes;
+    // Only needed while building
+    auto pendingPlates = FrameArena::MakeVector<PendingPlateBinding>();
+    auto spawnedById = FrameArena::MakeVector<std::pair<int, Trap*>>();
+    auto spawnedSpikes = FrameArena::MakeVector<Trap*>();
     bool hasExplicitLinks = false;
 
-    for (int i = 0; i < room.trapCount; ++i)
+    for (const RoomTrapSpawn& td : room.traps)
     {
-        const RoomTrapSpawn& td = room.traps[i];
 
         Box box{};
         box.size = td.size;
@@ -65,14 +141,14 @@ void RoomSystem::BuildCurrentRoom(RoomDirection cameFrom, const AEVec2* forcedSp
         if (tt == Trap::Type::SpikePlate)
         {
             SpikePlate& spikeRef =
-                trapMgr.Spawn<SpikePlate>(box, td.upTime, td.downTime, td.damageOnHit, td.startDisabled);
+                out.trapMgr.Spawn<SpikePlate>(box, td.upTime, td.downTime, td.damageOnHit, td.startDisabled);
 
             spawnedTrap = &spikeRef;
             spawnedSpikes.push_back(&spikeRef);
         }
         else if (tt == Trap::Type::PressurePlate)
         {
-            PressurePlate& plateRef = trapMgr.Spawn<PressurePlate>(box);
+            PressurePlate& plateRef = out.trapMgr.Spawn<PressurePlate>(box);
             spawnedTrap = &plateRef;
 
             pendingPlates.push_back({ &plateRef, &td });
@@ -81,7 +157,7 @@ void RoomSystem::BuildCurrentRoom(RoomDirection cameFrom, const AEVec2* forcedSp
         }
         else if (tt == Trap::Type::LavaPool)
         {
-            LavaPool& lavaRef = trapMgr.Spawn<LavaPool>(box, td.damagePerTick, td.tickInterval);
+            LavaPool& lavaRef = out.trapMgr.Spawn<LavaPool>(box, td.damagePerTick, td.tickInterval);
             spawnedTrap = &lavaRef;
         }
 
@@ -129,80 +205,134 @@ void RoomSystem::BuildCurrentRoom(RoomDirection cameFrom, const AEVec2* forcedSp
         }
     }
 
-    std::vector<EnemyManager::SpawnInfo> spawns;
-    bool hasBoss = false;
+    auto spawns = FrameArena::MakeVector<EnemyManager::SpawnInfo>();
 
-    for (int i = 0; i < room.enemyCount; ++i)
+    for (const RoomEnemySpawn& es : room.enemies)
     {
-        EnemySpawnType type = static_cast<EnemySpawnType>(room.enemies[i].preset);
+        EnemySpawnType type = static_cast<EnemySpawnType>(es.preset);
 
         AEVec2 worldPos{
-            roomOrigin.x + room.enemies[i].pos.x,
-            roomOrigin.y + room.enemies[i].pos.y
+            roomOrigin.x + es.pos.x,
+            roomOrigin.y + es.pos.y
         };
 
         spawns.push_back({ type, worldPos });
 
         if (type == EnemySpawnType::Boss)
-            hasBoss = true;
+        {
+            out.hasBoss = true;
+            out.bossSpawn = worldPos;
+        }
     }
 
-    activeBoss = hasBoss ? &enemyBoss : nullptr;
+    // The boss is shared between rooms, only moved to its spawn when the room is activated
+    out.enemyMgr.SetBoss(nullptr);
+    out.enemyMgr.SetRoomDepth(room.depth);
+    out.enemyMgr.SetSpawns(spawns);
+    out.enemyMgr.SpawnAll();
+}
+
+void RoomSystem::ActivateRoom(RoomObjects& objects, bool isRestored)
+{
+    activeRoomId = objects.id;
+    trapMgr = std::move(objects.trapMgr);
+    enemyMgr = std::move(objects.enemyMgr);
 
+    activeBoss = objects.hasBoss ? &enemyBoss : nullptr;
     enemyMgr.SetBoss(activeBoss);
-    enemyMgr.SetCurrentRoomID(room.id);
-    enemyMgr.SetSpawns(spawns);
-    enemyMgr.SpawnAll();
+    if (activeBoss && !isRestored)
+        activeBoss->SetSpawnPosition(objects.bossSpawn);
 
-    AEVec2 spawn{
-        roomOrigin.x + room.startSpawn.x,
-        roomOrigin.y + room.startSpawn.y
+    // Might have been built / left a while ago, start spawning particles from now
+    enemyMgr.ForEachEnemy([](Enemy& enemy) { enemy.particleSystem.Init(); });
+
+    objects = RoomObjects{};
+}
+
+void RoomSystem::StashActiveRoom()
+{
+    if (activeRoomId == ROOM_NONE)
+        return;
+
+    RoomObjects& stash = visitedRooms[activeRoomId];
+    stash.id = activeRoomId;
+    stash.trapMgr = std::move(trapMgr);
+    stash.enemyMgr = std::move(enemyMgr);
+    stash.hasBoss = activeBoss != nullptr;
+    stash.enemyMgr.SetBoss(nullptr);
+
+    activeRoomId = ROOM_NONE;
+}
+
+bool RoomSystem::IsRoomVisited(RoomID id) const
+{
+    return visitedRooms.contains(id);
+}
+
+void RoomSystem::ClearVisitedRooms()
+{
+    visitedRooms.clear();
+}
+
+void RoomSystem::UpdatePrefetch()
+{
+    // Tiles from the edge to start preparing the next room
+    static constexpr float kPrefetchDistance = 4.f;
+    // Extra tiles before the prepared room is dropped for another one
+    static constexpr float kPrefetchKeepMargin = 2.f;
+
+    const RoomID currentId = roomMgr.GetCurrentRoomID();
+    if (currentId == ROOM_NONE)
+        return;
+
+    const AEVec2 p = player.GetPosition();
+    const AEVec2 origin = GetRoomOrigin(currentId);
+
+    const RoomDirection dirs[] = { DIR_BOTTOM, DIR_TOP, DIR_LEFT, DIR_RIGHT };
+    const float distances[] = {
+        p.y - origin.y,
+        origin.y + static_cast<float>(ROOM_ROWS) - p.y,
+        p.x - origin.x,
+        origin.x + static_cast<float>(ROOM_COLS) - p.x
     };
 
-    if (forcedSpawn)
-    {
-        spawn = *forcedSpawn;
-    }
-    else if (cameFrom != DIR_NONE)
+    // Closest edge that leads to a room
+    RoomID target = ROOM_NONE;
+    float closest = kPrefetchDistance;
+    for (int i = 0; i < 4; ++i)
     {
-        const AEVec2 roomMin{
-            roomOrigin.x + 0.35f,
-            roomOrigin.y + 0.35f
-        };
-        const AEVec2 roomMax{
-            roomOrigin.x + static_cast<float>(ROOM_COLS) - 0.35f,
-            roomOrigin.y + static_cast<float>(ROOM_ROWS) - 0.35f
-        };
+        if (dirs[i] == blockedReturnDir)
+            continue;
 
-        spawn = AEVec2{
-            std::clamp(spawn.x, roomMin.x, roomMax.x),
-            std::clamp(spawn.y, roomMin.y, roomMax.y)
-        };
-    }
+        const RoomID neighbor = roomMgr.GetNeighbor(currentId, dirs[i]);
+        if (!roomMgr.HasRoom(neighbor))
+            continue;
 
-    // First entry into the scene = full reset.
-    // Room-to-room transition = just reposition.
-   /* if (cameFrom == DIR_NONE && forcedSpawn == nullptr)
-        player.Reset(spawn);
-    else
-        player.SetPosition(spawn);
-        */
+        // Still close enough to the prepared room, keep it even if another edge is closer
+        if (neighbor == prepared.id && distances[i] <= kPrefetchDistance + kPrefetchKeepMargin)
+            return;
 
-    const bool snapCamera = (cameFrom == DIR_NONE);
-    camera.SetFollow(&player.GetPosition(), 0.f, 0.f, snapCamera);
-    if (snapCamera)
-        camera.Update();
+        if (distances[i] > closest)
+            continue;
 
-    ApplyBlockedReturnBarrier();
+        target = neighbor;
+        closest = distances[i];
+    }
 
-    if (roomMgr.GetCurrentRoomID() == ROOM_11)
-        UI::StartBossIntro();
+    // Visited rooms are restored instead
+    if (target == ROOM_NONE || target == prepared.id || IsRoomVisited(target))
+        return;
+
+    PROFILE_SCOPE("RoomSystem::PrefetchRoom");
+    PrepareRoom(roomMgr.GetRoom(target), prepared);
 }
+
 void RoomSystem::ClearRuntimeRoomObjects()
 {
     trapMgr = TrapManager{};
 
     enemyMgr = EnemyManager{};
+    activeRoomId = ROOM_NONE;
     activeBoss = nullptr;
     enemyMgr.SetBoss(nullptr);
 }
@@ -8,6 +8,7 @@
 #include "../Camera.h"
 #include "../enemy/EnemyManager.h"
 #include "../enemy/EnemyBoss.h"
+#include <unordered_map>
 
 class RoomSystem
 {
@@ -27,6 +28,18 @@ public:
 
     void ClearRuntimeRoomObjects();
 
+    // Call every tick after the room transition check.
+    // When the player is near an edge, builds the traps / enemies of the room past it,
+    // so BuildCurrentRoom only has to move them in when the player crosses.
+    // The prepared room is kept until the player is a margin past the prefetch distance,
+    // so walking around a corner between 2 neighbors doesn't keep rebuilding them.
+    void UpdatePrefetch();
+
+    // Rooms the player left keep their traps / enemies as they were (HP, positions, trap timers),
+    // and get them back when the player comes back. Cleared when the scene is entered / restarted.
+    bool IsRoomVisited(RoomID id) const;
+    void ClearVisitedRooms();
+
     RoomDirection CheckRoomExit() const;
     AEVec2 GetRoomOrigin(RoomID id) const;
     AEVec2 ComputeTransitionSpawn(RoomID previousRoom,
@@ -41,7 +54,23 @@ public:
     const EnemyBoss* GetActiveBoss() const;
 
 private:
+    // Runtime objects of a room that isn't active:
+    // built ahead of time by UpdatePrefetch, or kept from the last visit
+    struct RoomObjects
+    {
+        RoomID id = ROOM_NONE;
+        TrapManager trapMgr;
+        EnemyManager enemyMgr;
+        bool hasBoss = false;
+        AEVec2 bossSpawn{ 0.f, 0.f };
+    };
+
     void ApplyBlockedReturnBarrier();
+    void PrepareRoom(const RoomData& room, RoomObjects& out) const;
+    // Moves the objects into the active managers. Restored rooms keep the boss where it was
+    void ActivateRoom(RoomObjects& objects, bool isRestored);
+    // Moves the active managers into visitedRooms
+    void StashActiveRoom();
 
 private:
     MapGrid& map;
@@ -54,4 +83,8 @@ private:
 
     EnemyBoss* activeBoss = nullptr;
     RoomDirection blockedReturnDir = DIR_NONE;
+
+    RoomID activeRoomId = ROOM_NONE;
+    RoomObjects prepared;
+    std::unordered_map<RoomID, RoomObjects> visitedRooms;  // Only rooms the player has left
 };
\ No newline at end of file
@@ -10,7 +10,14 @@
 #include "LevelEditorScene.h"
 #include "../../Editor/Editor.h"
 #include "../../Utils/Event/EventSystem.h"
-
+#include "../../Utils/Profiler.h"
+#include "../../Utils/ResourceCache.h"
+#include "../../Utils/Renderer.h"
+#include "../../Utils/Animator.h"
+#include "../../Utils/FrameArena.h"
+#include "../../Utils/MemoryTracker.h"
+
+#include <iostream>
 #include <imgui.h>
 #include <imgui_impl_opengl3.h>
 #include <imgui_impl_win32.h>
@@ -44,9 +51,19 @@ void GSM::Init(SceneState type)
 
 void GSM::Update()
 {
+	// Memory in use before the scene loads, to find what it doesn't free
+	s64 liveBytesBeforeScene = 0;
+
 	// Similar to csd1130 GIT's game state manager
 	while (currentState != GS_QUIT)
 	{
+		// Restarting keeps the scene, so only measure when it's loaded
+		if (currentState != GS_RESTART)
+		{
+			liveBytesBeforeScene = MemoryTracker::GetTotalStats().liveBytes;
+			MemoryTracker::ResetPeaks();
+		}
+
 		// If restart,
 		if (currentState == GS_RESTART)
 			currentState = nextState = previousState;
@@ -69,8 +86,13 @@ void GSM::Update()
 
 		while (currentState == nextState)
 		{
+			PROFILE_SCOPE("GSM::Update");
+
 			// Informing the system about the loop's start
 			AESysFrameStart();
+			MemoryTracker::BeginFrame();
+			FrameArena::Reset();
+			Renderer::BeginFrame();
 
 			ImGui_ImplOpenGL3_NewFrame();
 			ImGui_ImplWin32_NewFrame();
@@ -89,12 +111,26 @@ void GSM::Update()
 			//if (AEInputCheckTriggered(AEVK_ESCAPE) || 0 == AESysDoesWindowExist())
 			//	nextState = GS_QUIT;
 
+			// Fixed step gameplay, runs as many ticks as the frame's time allows
+			Time& time = Time::GetInstance();
+			time.BeginFrame();
+			while (currentState == nextState && time.BeginTick())
+			{
+				currentScene->FixedUpdate();
+				// Sprites are played in FixedUpdate, so they step with the fixed delta
+				Animator::Update();
+				time.EndTick();
+			}
+
 			currentScene->Update();
+			// Events queued by the ticks and Update
+			EventSystem::FlushQueued();
 			Editor::Update();
 
 			currentScene->Render();
+			Editor::DrawDebugShapes();
 
-			Time::GetInstance().Update();
+			time.Update();
 			TimerSystem::GetInstance().Update();
 			
 			Editor::DrawInspectors();
@@ -107,7 +143,18 @@ void GSM::Update()
 
 		// Changing state
 		if (nextState != GS_RESTART)
+		{
 			delete currentScene;
+			// Free textures / sprites the next scene doesn't use
+			ResourceCache::FreeUnused();
+
+			if (MemoryTracker::IsEnabled())
+			{
+				const MemoryTracker::TagStats memory = MemoryTracker::GetTotalStats();
+				std::cout << "[Memory] Unloaded " << GetStateName(currentState) << ": peak " << memory.peakBytes / 1024
+						  << " KB, " << (memory.liveBytes - liveBytesBeforeScene) / 1024 << " KB more than before it loaded\n";
+			}
+		}
 
 		previousState = currentState;
 		currentState = nextState;
@@ -121,6 +168,9 @@ void GSM::Update()
 void GSM::Exit()
 {
 	QuickGraphics::Free();
+	Renderer::Free();
+	ResourceCache::Clear();
+	FrameArena::Clear();
 }
 
 void GSM::ChangeScene(SceneState state)
@@ -24,6 +24,9 @@ class BaseScene
 {
 public:
 	virtual void Init() = 0;
+	// Gameplay simulation. Called 0 or more times a frame, before Update, at Time's fixed tick rate
+	virtual void FixedUpdate() {}
+	// Called once a frame. Input that's only true for a frame (AEInputCheckTriggered) should be read here
 	virtual void Update() = 0;
 	virtual void Render() = 0;
 	virtual void Exit() = 0;
@@ -7,12 +7,13 @@
 #include "../BuffCards.h"
 #include "LevelIO.h"
 #include "../../Game/Timer.h"
-#include <iomanip>
-#include <sstream>
 #include <cmath>
 #include "../AudioManager.h"
 #include "../Rooms/RoomBuilder.h"
 #include "../enemy/AttackSystem.h"
+#include "../../Utils/Profiler.h"
+#include "../../Utils/TextureAtlas.h"
+#include "../../Utils/Renderer.h"
 #include <algorithm>
 
 std::string gPendingLevelPath = "Assets/Levels/gamescene.lvl";   // defined here, extern'd in MainMenuScene.cpp
@@ -67,34 +68,34 @@ GameScene::GameScene() :
 	AudioManager::Init();
 	// Init pause overlay resources 
 	pauseRectMesh = MeshGenerator::GetRectMesh(1.0f, 1.0f);
-	pauseCardBackTex = AEGfxTextureLoad("Assets/Art/0_CardBack.png");
+	pauseCardBackTex = TextureAtlas::Acquire("Assets/Art/0_CardBack.png");
 
 	// Load buff icon textures for pause overlay (same assets as BuffCardScreen)
-	for (int i = 0; i < kPauseBuffTexCount; ++i) pauseBuffTex[i] = nullptr;
+	for (int i = 0; i < kPauseBuffTexCount; ++i) pauseBuffTex[i] = {};
 
 	// NOTE: These indices assume CARD_TYPE enum values are 0..N in this order.
-	pauseBuffTex[(int)HERMES_FAVOR] = AEGfxTextureLoad("Assets/Art/Hermes_Favor.png");
-	pauseBuffTex[(int)IRON_DEFENCE] = AEGfxTextureLoad("Assets/Art/Iron_Defence.png");
-	pauseBuffTex[(int)SWITCH_IT_UP] = AEGfxTextureLoad("Assets/Art/Switch_It_Up.png");
-	pauseBuffTex[(int)REVITALIZE] = AEGfxTextureLoad("Assets/Art/Revitalize.png");
-	pauseBuffTex[(int)SHARPEN] = AEGfxTextureLoad("Assets/Art/Sharpen.png");
-	pauseBuffTex[(int)BERSERKER] = AEGfxTextureLoad("Assets/Art/Berserker.png");
-	pauseBuffTex[(int)FLEETING_STEP] = AEGfxTextureLoad("Assets/Art/Fleeting_Step.png");
-	pauseBuffTex[(int)SUREFOOTED] = AEGfxTextureLoad("Assets/Art/Surefooted.png");
-	pauseBuffTex[(int)DEEP_VITALITY] = AEGfxTextureLoad("Assets/Art/Deep_Vitality.png");
-	pauseBuffTex[(int)HAND_OF_FATE] = AEGfxTextureLoad("Assets/Art/Hand_Of_Fate.png");
-	pauseBuffTex[(int)SUNDERING_BLOW] = AEGfxTextureLoad("Assets/Art/Sundering_Blow.png");
+	pauseBuffTex[(int)HERMES_FAVOR] = TextureAtlas::Acquire("Assets/Art/Hermes_Favor.png");
+	pauseBuffTex[(int)IRON_DEFENCE] = TextureAtlas::Acquire("Assets/Art/Iron_Defence.png");
+	pauseBuffTex[(int)SWITCH_IT_UP] = TextureAtlas::Acquire("Assets/Art/Switch_It_Up.png");
+	pauseBuffTex[(int)REVITALIZE] = TextureAtlas::Acquire("Assets/Art/Revitalize.png");
+	pauseBuffTex[(int)SHARPEN] = TextureAtlas::Acquire("Assets/Art/Sharpen.png");
+	pauseBuffTex[(int)BERSERKER] = TextureAtlas::Acquire("Assets/Art/Berserker.png");
+	pauseBuffTex[(int)FLEETING_STEP] = TextureAtlas::Acquire("Assets/Art/Fleeting_Step.png");
+	pauseBuffTex[(int)SUREFOOTED] = TextureAtlas::Acquire("Assets/Art/Surefooted.png");
+	pauseBuffTex[(int)DEEP_VITALITY] = TextureAtlas::Acquire("Assets/Art/Deep_Vitality.png");
+	pauseBuffTex[(int)HAND_OF_FATE] = TextureAtlas::Acquire("Assets/Art/Hand_Of_Fate.png");
+	pauseBuffTex[(int)SUNDERING_BLOW] = TextureAtlas::Acquire("Assets/Art/Sundering_Blow.png");
 	// Fonts for pause overlay
 	pauseFontLarge = AEGfxCreateFont("Assets/m04.ttf", 55);
 	pauseFontSmall = AEGfxCreateFont("Assets/m04.ttf", 35);
 	pauseFontRuntime = AEGfxCreateFont("Assets/m04.ttf", 28);
 
 	// Glow / emission textures (same as BuffCardScreen)
-	for (int i = 0; i < kPauseRarityTexCount; ++i) pauseRarityTex[i] = nullptr;
-	pauseRarityTex[RARITY_UNCOMMON] = AEGfxTextureLoad("Assets/Art/Uncommon_Emission.png");
-	pauseRarityTex[RARITY_RARE] = AEGfxTextureLoad("Assets/Art/Rare_Emission.png");
-	pauseRarityTex[RARITY_EPIC] = AEGfxTextureLoad("Assets/Art/Epic_Emission.png");
-	pauseRarityTex[RARITY_LEGENDARY] = AEGfxTextureLoad("Assets/Art/Legendary_Emission.png");
+	for (int i = 0; i < kPauseRarityTexCount; ++i) pauseRarityTex[i] = {};
+	pauseRarityTex[RARITY_UNCOMMON] = TextureAtlas::Acquire("Assets/Art/Uncommon_Emission.png");
+	pauseRarityTex[RARITY_RARE] = TextureAtlas::Acquire("Assets/Art/Rare_Emission.png");
+	pauseRarityTex[RARITY_EPIC] = TextureAtlas::Acquire("Assets/Art/Epic_Emission.png");
+	pauseRarityTex[RARITY_LEGENDARY] = TextureAtlas::Acquire("Assets/Art/Legendary_Emission.png");
 
 	// Pixellari for description (match BuffCardScreen)
 	pauseFontDesc = AEGfxCreateFont("Assets/Pixellari.ttf", 30);
@@ -104,6 +105,7 @@ GameScene::~GameScene()
 {
 	UI::Exit();
 	Background::Exit();
+	SpikePlate::UnloadSharedRenderResources();
 
 	// Free pause overlay resources
 	if (pauseRectMesh)
@@ -111,10 +113,10 @@ GameScene::~GameScene()
 		AEGfxMeshFree(pauseRectMesh);
 		pauseRectMesh = nullptr;
 	}
-	if (pauseCardBackTex)
+	if (pauseCardBackTex.texture)
 	{
-		AEGfxTextureUnload(pauseCardBackTex);
-		pauseCardBackTex = nullptr;
+		TextureAtlas::Release(pauseCardBackTex);
+		pauseCardBackTex = {};
 	}
 	if (pauseFontLarge >= 0)
 	{
@@ -134,20 +136,20 @@ GameScene::~GameScene()
 	// Free buff icon textures for pause overlay
 	for (int i = 0; i < kPauseBuffTexCount; ++i)
 	{
-		if (pauseBuffTex[i])
+		if (pauseBuffTex[i].texture)
 		{
-			AEGfxTextureUnload(pauseBuffTex[i]);
-			pauseBuffTex[i] = nullptr;
+			TextureAtlas::Release(pauseBuffTex[i]);
+			pauseBuffTex[i] = {};
 		}
 	}
 
 	// Free rarity glow textures for pause overlay
 	for (int i = 0; i < kPauseRarityTexCount; ++i)
 	{
-		if (pauseRarityTex[i])
+		if (pauseRarityTex[i].texture)
 		{
-			AEGfxTextureUnload(pauseRarityTex[i]);
-			pauseRarityTex[i] = nullptr;
+			TextureAtlas::Release(pauseRarityTex[i]);
+			pauseRarityTex[i] = {};
 		}
 	}
 	if (pauseFontDesc >= 0)
@@ -165,20 +167,18 @@ void GameScene::Init()
 
 	bool loadedFromFile = false;
 	LevelData loadedLevel{};
-	RoomID startRoom = ROOM_1;
+	RoomID startRoom = ROOM_NONE;
 
 	if (!gPendingLevelPath.empty())
 	{
 		std::cout << "pending path: " << gPendingLevelPath << "\n";
 
-		LevelData lvl;
-		if (LoadLevelFromFile(gPendingLevelPath.c_str(), lvl))
+		if (LoadLevelFromFile(gPendingLevelPath.c_str(), loadedLevel))
 		{
 			std::cout << "load success\n";
-			std::cout << "loaded rows=" << lvl.rows << " cols=" << lvl.cols << "\n";
+			std::cout << "loaded rows=" << loadedLevel.rows << " cols=" << loadedLevel.cols << "\n";
 
 			loadedFromFile = true;
-			loadedLevel = lvl;
 			gLastLoadedLevelPath = gPendingLevelPath;
 			BuildRoomsFromLevelData(loadedLevel, roomMgr, startRoom);
 			gPendingLevelPath.clear();
@@ -240,10 +240,10 @@ void GameScene::Init()
 	roomMgr.SetCurrentRoom(startRoom);
 	const RoomData& r = roomMgr.GetCurrentRoom();
 	std::cout << "startRoom=" << (int)startRoom
-		<< " L=" << (int)r.leftRoom
-		<< " R=" << (int)r.rightRoom
-		<< " T=" << (int)r.topRoom
-		<< " B=" << (int)r.bottomRoom
+		<< " L=" << (int)r.neighbors[DIR_LEFT]
+		<< " R=" << (int)r.neighbors[DIR_RIGHT]
+		<< " T=" << (int)r.neighbors[DIR_TOP]
+		<< " B=" << (int)r.neighbors[DIR_BOTTOM]
 		<< "\n";
 	roomSystem.BuildCurrentRoom();
 	roomTransitionLocked = false;
@@ -252,7 +252,7 @@ void GameScene::Init()
 	std::cout << "lvl.cols=" << loadedLevel.cols
 		<< " lvl.rows=" << loadedLevel.rows
 		<< "\n";
-	if (roomMgr.GetCurrentRoomID() == ROOM_1) {
+	if (roomMgr.GetCurrentRoomID() == startRoom) {
 		if (AudioManager::gameMusic)   // make sure the pointer is initialized
 			AudioManager::gameMusic->Play(1.0f);  // pass volume
 	}
@@ -261,39 +261,16 @@ void GameScene::Init()
 	player.Reset({ 1, 7.5 });
 }
 
-void GameScene::Update()
+void GameScene::FixedUpdate()
 {
-	// Toggle pause with ESC (GameScene only)
-	if (AEInputCheckTriggered(AEVK_ESCAPE))
-	{
-		// If we are inside sub-pages, ESC returns to menu instead of unpausing
-		if (pausePage == PausePage::Settings || pausePage == PausePage::ConfirmQuit || pausePage == PausePage::ConfirmRestart) {
-			pausePage = PausePage::Menu;
-			AudioManager::UnmuffleGameMusic();
-		}
-		else
-		{
-			AudioManager::MuffleGameMusic();
-			TogglePause();
-		}
-	}
-
-	if (AEInputCheckTriggered(AEVK_9))
-	{
-		GSM::ChangeScene(SceneState::GS_LEVEL_EDITOR);
-		return;
-	}
+	PROFILE_SCOPE("GameScene::FixedUpdate");
 
-	// When paused, skip gameplay update and only handle pause input
+	// Paused, only the pause menu updates
 	if (IsPaused())
-	{
-		UpdatePauseInput();
 		return;
-	}
 
 	if (UI::IsBossIntroActive())
 	{
-		UI::Update();
 		camera.Update();
 		return;
 	}
@@ -354,30 +331,72 @@ void GameScene::Update()
 			}
 		}
 	}
+	roomSystem.UpdatePrefetch();
 	camera.Update();
 
 	AEVec2 p = player.GetPosition();
 	enemyMgr.UpdateAll(p, player.GetIsFacingRight(), map);
 
-	const AEVec2 pPos = player.GetPosition();
-	const AEVec2 pSize = player.GetStats().playerSize;
-
 	attackSystem.UpdateEnemyAttack(player, enemyMgr, roomSystem.GetActiveBoss(), map);
 
 	trapMgr.Update(dt, player);
 
 	testParticleSystem.SetSpawnRate(AEInputCheckCurr(AEVK_F) ? 2000.f : 0.f);
-	if (AEInputCheckTriggered(AEVK_G))
-		testParticleSystem.SpawnParticleBurst(300);
 	testParticleSystem.Update();
 
 	UI::GetDamageTextSpawner().Update();
+}
+
+void GameScene::Update()
+{
+	PROFILE_SCOPE("GameScene::Update");
+
+	// Toggle pause with ESC (GameScene only)
+	if (AEInputCheckTriggered(AEVK_ESCAPE))
+	{
+		// If we are inside sub-pages, ESC returns to menu instead of unpausing
+		if (pausePage == PausePage::Settings || pausePage == PausePage::ConfirmQuit || pausePage == PausePage::ConfirmRestart) {
+			pausePage = PausePage::Menu;
+			AudioManager::UnmuffleGameMusic();
+		}
+		else
+		{
+			AudioManager::MuffleGameMusic();
+			TogglePause();
+		}
+	}
+
+	if (AEInputCheckTriggered(AEVK_9))
+	{
+		GSM::ChangeScene(SceneState::GS_LEVEL_EDITOR);
+		return;
+	}
+
+	// When paused, skip gameplay update and only handle pause input
+	if (IsPaused())
+	{
+		UpdatePauseInput();
+		return;
+	}
+
+	if (UI::IsBossIntroActive())
+	{
+		UI::Update();
+		return;
+	}
+
+	// Gameplay already ran in FixedUpdate. Keep keys pressed on frames without a tick
+	player.LatchInput();
+
+	if (AEInputCheckTriggered(AEVK_G))
+		testParticleSystem.SpawnParticleBurst(300);
+
 	UI::Update();
 	//std::cout << "MASTER VOL : " << AudioManager::GetMasterVolume()
 	//		  << "BGM VOL : " << AudioManager::GetMusicVolume()
 	//		  << "SFX VOL : " << AudioManager::GetSFXVolume() << '\n';
 	//std::cout << "CURRENT ROOM : " << static_cast<int>(roomMgr.GetCurrentRoomID()) << '\n';
-	if (roomMgr.GetCurrentRoomID() == ROOM_11) { // To change to ROOM_10 after spawning is done
+	if (roomMgr.IsBossRoom(roomMgr.GetCurrentRoomID())) {
 		//std::cout << " IN BOSS ROOM !!!";
 		AudioManager::gameMusic->Stop();
 		AudioManager::PlayBossMusic(enemyBoss, roomMgr);
@@ -404,6 +423,8 @@ void GameScene::Update()
 
 void GameScene::Render()
 {
+	PROFILE_SCOPE("GameScene::Render");
+
 	AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
 	AEGfxSetBlendMode(AE_GFX_BM_BLEND);
 	AEGfxSetTransparency(1.f);
@@ -419,6 +440,8 @@ void GameScene::Render()
 		roomSystem.GetActiveBoss()->Render();
 	//enemyBoss.Render();
 	enemyMgr.RenderAll();
+	// Particles, traps and sprites, under the attacks and UI
+	Renderer::Flush();
 	attackSystem.Render();
 	UI::Render();
 
@@ -430,15 +453,15 @@ void GameScene::Render()
 #if _DEBUG
 	AEVec2 worldMousePos;
 	AEExtras::GetCursorWorldPosition(worldMousePos);
-	std::string str = "World Mouse Pos:" + std::to_string(worldMousePos.x) + ", " + std::to_string(worldMousePos.y);
+	FrameArena::String str = FrameArena::Format("World Mouse Pos:%f, %f", worldMousePos.x, worldMousePos.y);
 	QuickGraphics::PrintText(str.c_str(), -1, 0.95f, 0.3f, 0.5f, 0.5f, 0.5f, 1);
-	str = "FPS:" + std::to_string(AEFrameRateControllerGetFrameRate());
+	str = FrameArena::Format("FPS:%f", AEFrameRateControllerGetFrameRate());
 	QuickGraphics::PrintText(str.c_str(), -1, 0.90f, 0.3f, 0.5f, 0.5f, 0.5f, 1);
 
-	str = "Time:" + std::to_string(Time::GetInstance().GetScaledElapsedTime());
+	str = FrameArena::Format("Time:%f", Time::GetInstance().GetScaledElapsedTime());
 	QuickGraphics::PrintText(str.c_str(), -1, 0.85f, 0.3f, 0.5f, 0.5f, 0.5f, 1);
 
-	std::string ppos = "Player Pos: " + std::to_string(player.GetPosition().x) + ", " + std::to_string(player.GetPosition().y);
+	FrameArena::String ppos = FrameArena::Format("Player Pos: %f, %f", player.GetPosition().x, player.GetPosition().y);
 	QuickGraphics::PrintText(ppos.c_str(), -1, 0.80f, 0.3f, 0.5f, 0.5f, 0.5f, 1);
 
 	if (AEInputCheckTriggered(AEVK_R)) {
@@ -542,9 +565,9 @@ void GameScene::DrawSolidPanel(const UIRect& r, float alpha)
 	AEGfxMeshDraw(pauseRectMesh, AE_GFX_MDM_TRIANGLES);
 }
 
-void GameScene::DrawTexturePanel(AEGfxTexture* tex, const UIRect& r, float alpha)
+void GameScene::DrawTexturePanel(const TextureAtlas::Region& region, const UIRect& r, float alpha)
 {
-	if (!tex) return;
+	if (!region.texture) return;
 
 	AEMtx33 scale, rot, trans, transform;
 	AEMtx33Scale(&scale, r.size.x, r.size.y);
@@ -558,18 +581,22 @@ void GameScene::DrawTexturePanel(AEGfxTexture* tex, const UIRect& r, float alpha
 	AEMtx33Concat(&transform, &rot, &scale);
 	AEMtx33Concat(&transform, &trans, &transform);
 
-	AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
-	AEGfxSetColorToMultiply(1.f, 1.f, 1.f, 1.f);
-	AEGfxSetColorToAdd(0.f, 0.f, 0.f, 0.f);
-	AEGfxSetBlendMode(AE_GFX_BM_BLEND);
-	AEGfxSetTransparency(alpha);
-
-	AEGfxTextureSet(tex, 0, 0);
-	AEGfxSetTransform(transform.m);
-	AEGfxMeshDraw(pauseRectMesh, AE_GFX_MDM_TRIANGLES);
+	// Region can be part of an atlas, the renderer sets the UVs
+	Renderer::DrawCommand command;
+	command.texture = region.texture;
+	command.transform = transform;
+	command.color = Renderer::ToColor(1.f, 1.f, 1.f, alpha);
+	command.u0 = region.u0;
+	command.v0 = region.v0;
+	command.u1 = region.u1;
+	command.v1 = region.v1;
+	Renderer::Submit(command);
+
+	// Drawn in between text
+	Renderer::Flush();
 }
 
-void GameScene::DrawTextPx(s8 font, const std::string& text, float px, float py, float scale, float r, float g, float b, float a)
+void GameScene::DrawTextPx(s8 font, const char* text, float px, float py, float scale, float r, float g, float b, float a)
 {
 	float w = (float)AEGfxGetWindowWidth();
 	float h = (float)AEGfxGetWindowHeight();
@@ -577,7 +604,7 @@ void GameScene::DrawTextPx(s8 font, const std::string& text, float px, float py,
 	float xNdc = (px / w) * 2.0f - 1.0f;
 	float yNdc = 1.0f - (py / h) * 2.0f;
 
-	AEGfxPrint(font, text.c_str(), xNdc, yNdc, scale, r, g, b, a);
+	AEGfxPrint(font, text, xNdc, yNdc, scale, r, g, b, a);
 }
 
 bool GameScene::IsMouseOver(const UIRect& r) const
@@ -590,7 +617,7 @@ bool GameScene::IsClicked(const UIRect& r) const
 	return IsMouseOver(r) && AEInputCheckTriggered(AEVK_LBUTTON);
 }
 
-std::string GameScene::FormatRunTime() const
+FrameArena::String GameScene::FormatRunTime() const
 {
 	double t = Time::GetInstance().GetScaledElapsedTime();
 	int totalMs = (int)(t * 1000.0);
@@ -599,11 +626,7 @@ std::string GameScene::FormatRunTime() const
 	int ss = (totalMs / 1000) % 60;
 	int cs = (totalMs / 10) % 100;
 
-	std::ostringstream oss;
-	oss << std::setfill('0') << std::setw(2) << mm << ":"
-		<< std::setfill('0') << std::setw(2) << ss << ":"
-		<< std::setfill('0') << std::setw(2) << cs;
-	return oss.str();
+	return FrameArena::Format("%02d:%02d:%02d", mm, ss, cs);
 }
 
 void GameScene::UpdatePauseInput()
@@ -776,7 +799,7 @@ void GameScene::RenderPauseOverlay()
 	if (pausePage != PausePage::Settings)
 	{
 		DrawTextPx(pauseFontLarge, "PAUSED", 40, 100, 1.0f, 1, 1, 1, 1);
-		DrawTextPx(pauseFontRuntime, "Run Time : " + FormatRunTime(), 40, 150, 1.0f, 1, 1, 1, 1);
+		DrawTextPx(pauseFontRuntime, ("Run Time : " + FormatRunTime()).c_str(), 40, 150, 1.0f, 1, 1, 1, 1);
 	}
 
 	auto drawBtn = [&](const char* label, const UIRect& r)
@@ -834,7 +857,7 @@ void GameScene::RenderPauseOverlay()
 				UIRect knob{ { knobX, y }, { knobSz, knobSz } };
 				DrawSolidPanel(knob, dragging ? 0.60f : 0.36f);
 
-				DrawTextPx(pauseFontRuntime, std::to_string(percent), percentX, y - 18.0f, 1.0f, 1.0f, 0.95f, 0.35f, 1.0f);
+				DrawTextPx(pauseFontRuntime, FrameArena::Format("%d", percent).c_str(), percentX, y - 18.0f, 1.0f, 1.0f, 0.95f, 0.35f, 1.0f);
 			};
 		DrawSlider("Master Volume", AudioManager::GetMasterVolume(), masterY, draggingMasterSlider);
 		DrawSlider("BGM Volume", AudioManager::GetMusicVolume(), bgmY, draggingBgmSlider);
@@ -923,21 +946,21 @@ void GameScene::RenderPauseOverlay()
 			card.pos = { centerX, centerY };
 
 			// Pick buff front texture by card type; fallback to card back if missing
-			AEGfxTexture* tex = nullptr;
+			TextureAtlas::Region tex;
 			int typeIdx = (int)b.type;
 			if (typeIdx >= 0 && typeIdx < kPauseBuffTexCount)
 				tex = pauseBuffTex[typeIdx];
-			if (!tex)
+			if (!tex.texture)
 				tex = pauseCardBackTex;
 
 			DrawTexturePanel(tex, card, 1.0f);
 
 			// --- draw glow (rarity emission) ---
-			AEGfxTexture* glow = nullptr;
+			TextureAtlas::Region glow;
 			int r = (int)b.rarity;
 			if (r >= 0 && r < kPauseRarityTexCount) glow = pauseRarityTex[r];
 
-			if (glow)
+			if (glow.texture)
 			{
 				const float EMISSION_SCALE = 1.15f; // same as BuffCardScreen
 				UIRect glowRect = card;
@@ -980,17 +1003,17 @@ void GameScene::RenderPauseOverlay()
 				// Title (m04)
 				DrawTextPx(
 					pauseFontSmall,
-					b.cardName,
+					b.cardName.c_str(),
 					120.0f, h - 125.0f, 1.0f,
 					red, green, blue, 1
 				);
 
 				// Description/effect (Pixellari) - using cardEffect if available, otherwise fallback to cardDesc. 
-				const std::string desc = b.cardEffect.empty() ? b.cardDesc : b.cardEffect;
+				const std::string& desc = b.cardEffect.empty() ? b.cardDesc : b.cardEffect;
 
 				DrawTextPx(
 					pauseFontDesc,
-					desc,
+					desc.c_str(),
 					120.0f, h - 65.0f, 1.0f,
 					0.9f, 0.9f, 0.9f, 1.0f
 				);
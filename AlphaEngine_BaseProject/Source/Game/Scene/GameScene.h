@@ -12,6 +12,8 @@
 #include "../../Game/Rooms/RoomManager.h"
 #include "../Rooms/RoomBuilder.h"
 #include "../Rooms/RoomSystem.h"
+#include "../../Utils/TextureAtlas.h"
+#include "../../Utils/FrameArena.h"
 
 class GameScene : public BaseScene
 {
@@ -19,6 +21,7 @@ public:
 	GameScene();
 	~GameScene();
 	void Init() override;
+	void FixedUpdate() override;
 	void Update() override;
 	void Render() override;
 	void Exit() override;
@@ -34,9 +37,6 @@ private:
 	ParticleSystem testParticleSystem;
 	TrapManager trapMgr;
 
-	Enemy enemyA;
-	Enemy enemyB;
-
 	EnemyManager enemyMgr;
 	AttackSystem attackSystem;
 	RoomManager roomMgr;
@@ -60,7 +60,7 @@ private:
 
 	// UI resources
 	AEGfxVertexList* pauseRectMesh = nullptr;
-	AEGfxTexture* pauseCardBackTex = nullptr;
+	TextureAtlas::Region pauseCardBackTex;
 	s8 pauseFontLarge = -1;
 	s8 pauseFontSmall = -1;
 	s8 pauseFontRuntime = -1; // for dynamic text like run time
@@ -82,20 +82,20 @@ private:
 	// Draw helpers (no ImGui)
 	void DrawDimBackground(float alpha);
 	void DrawSolidPanel(const UIRect& r, float alpha);
-	void DrawTexturePanel(AEGfxTexture* tex, const UIRect& r, float alpha);
-	void DrawTextPx(s8 font, const std::string& text, float px, float py, float scale, float r, float g, float b, float a);
+	void DrawTexturePanel(const TextureAtlas::Region& region, const UIRect& r, float alpha);
+	void DrawTextPx(s8 font, const char* text, float px, float py, float scale, float r, float g, float b, float a);
 	bool IsMouseOver(const UIRect& r) const;
 	bool IsClicked(const UIRect& r) const;
 
 	// UI layout helpers
-	std::string FormatRunTime() const;
+	FrameArena::String FormatRunTime() const;
 	// ---- Pause overlay textures (buff icons) ----
 	static constexpr int kPauseBuffTexCount = 20; // enough for your CARD_TYPE values
-	AEGfxTexture* pauseBuffTex[kPauseBuffTexCount] = { nullptr };
+	TextureAtlas::Region pauseBuffTex[kPauseBuffTexCount];
 
 	// glowing rarity overlay textures for cards (same as BuffCardScreen)
 	static constexpr int kPauseRarityTexCount = 4; // UNCOMMON/RARE/EPIC/LEGENDARY
-	AEGfxTexture* pauseRarityTex[kPauseRarityTexCount] = { nullptr };
+	TextureAtlas::Region pauseRarityTex[kPauseRarityTexCount];
 	s8 pauseFontDesc = -1; // Pixellari
 
 	int mapCols = ROOM_COLS;
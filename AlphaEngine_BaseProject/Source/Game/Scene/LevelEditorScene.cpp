@@ -1,8 +1,10 @@
 #include "LevelEditorScene.h"
 #include "leveleditor.h"   // gamestate functions
+#include "../../Utils/MemoryTracker.h"
 
 LevelEditorScene::LevelEditorScene()
 {
+    MEMORY_SCOPE(Editor);
     GameState_LevelEditor_Load();
 }
 
@@ -13,16 +15,19 @@ LevelEditorScene::~LevelEditorScene()
 
 void LevelEditorScene::Init()
 {
+    MEMORY_SCOPE(Editor);
     GameState_LevelEditor_Init();
 }
 
 void LevelEditorScene::Update()
 {
+    MEMORY_SCOPE(Editor);
     GameState_LevelEditor_Update();
 }
 
 void LevelEditorScene::Render()
 {
+    MEMORY_SCOPE(Editor);
     GameState_LevelEditor_Draw();
 }
 
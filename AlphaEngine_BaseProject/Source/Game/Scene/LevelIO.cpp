@@ -3,10 +3,12 @@
 #include "../Environment/MapGrid.h"
 #include "../Environment/MapTile.h"
 #include "../Environment/traps.h" // Trap::Type
+#include "../../Utils/MappedFile.h"
 
 #include <fstream>
 #include <sstream>
 #include <cctype>
+#include <cstring>
 #include <filesystem>
 #include <system_error>
 
@@ -78,15 +80,153 @@ namespace
         while (i < s.size() && std::isspace((unsigned char)s[i])) ++i;
         s.erase(0, i);
     }
-}
 
-bool SaveLevelToFile(const char* filename, const LevelData& lvl)
-{
-    if (!filename) return false;
-    if (lvl.rows <= 0 || lvl.cols <= 0) return false;
-    if ((int)lvl.tiles.size() != lvl.rows * lvl.cols) return false;
+    // === Compiled level (.lvlb) layout ===
+    // Little endian, every table starts 4 byte aligned:
+    // [LevelBinaryHeader][s32 tiles, rows * cols][TrapRecord traps][s32 links][EnemyRecord enemies][VineRecord vines]
+    // Bump LEVEL_BINARY_VERSION when changing any of these structs.
+    constexpr char LEVEL_BINARY_MAGIC[4] = { 'L', 'V', 'L', 'B' };
+    constexpr u32 LEVEL_BINARY_VERSION = 2;
 
-    // ensure parent directory exists (if using folders)
+    struct LevelBinaryHeader
+    {
+        char magic[4];
+        u32 version;
+        u64 sourceSize;         // Size of the .lvl compiled from
+        s64 sourceWriteTime;    // Last write time of the .lvl compiled from, in std::filesystem::file_time_type ticks
+
+        s32 rows, cols;
+        f32 spawnX, spawnY;
+
+        u32 trapCount, linkCount, enemyCount, vineCount;
+        u32 tilesOffset, trapsOffset, linksOffset, enemiesOffset, vinesOffset;
+        u32 padding;
+    };
+
+    struct TrapRecord
+    {
+        s32 type;
+        f32 posX, posY, sizeX, sizeY;
+        f32 upTime, downTime;
+        s32 damageOnHit;
+        s32 startDisabled;
+        s32 damagePerTick;
+        f32 tickInterval;
+        s32 id;
+        u32 firstLink, linkCount;   // Range in the links table
+    };
+
+    struct EnemyRecord
+    {
+        s32 preset;
+        f32 posX, posY;
+    };
+
+    struct VineRecord
+    {
+        f32 x, y;
+    };
+
+    static_assert(sizeof(LevelBinaryHeader) == 80, "Update LEVEL_BINARY_VERSION when changing the layout");
+    static_assert(sizeof(TrapRecord) == 56, "Update LEVEL_BINARY_VERSION when changing the layout");
+    static_assert(sizeof(EnemyRecord) == 12, "Update LEVEL_BINARY_VERSION when changing the layout");
+    static_assert(sizeof(VineRecord) == 8, "Update LEVEL_BINARY_VERSION when changing the layout");
+
+    // Size and last write time of the .lvl, to check if a .lvlb was compiled from it without reading it
+    bool GetSourceStamp(const char* filename, u64& outSize, s64& outWriteTime)
+    {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(filename, ec);
+        if (ec) return false;
+
+        const auto writeTime = std::filesystem::last_write_time(filename, ec);
+        if (ec) return false;
+
+        outSize = (u64)size;
+        outWriteTime = (s64)writeTime.time_since_epoch().count();
+        return true;
+    }
+
+    // Checks the header and that every table is inside the file
+    const LevelBinaryHeader* GetValidHeader(const MappedFile& file)
+    {
+        if (file.GetSize() < sizeof(LevelBinaryHeader))
+            return nullptr;
+
+        const LevelBinaryHeader* header = reinterpret_cast<const LevelBinaryHeader*>(file.GetData());
+        if (std::memcmp(header->magic, LEVEL_BINARY_MAGIC, sizeof(LEVEL_BINARY_MAGIC)) != 0 ||
+            header->version != LEVEL_BINARY_VERSION ||
+            header->rows <= 0 || header->cols <= 0)
+            return nullptr;
+
+        auto isInFile = [&file](u32 offset, u64 count, size_t elementSize) {
+            return offset % 4 == 0 && (u64)offset + count * elementSize <= (u64)file.GetSize();
+        };
+
+        if (!isInFile(header->tilesOffset, (u64)header->rows * (u64)header->cols, sizeof(s32)) ||
+            !isInFile(header->trapsOffset, header->trapCount, sizeof(TrapRecord)) ||
+            !isInFile(header->linksOffset, header->linkCount, sizeof(s32)) ||
+            !isInFile(header->enemiesOffset, header->enemyCount, sizeof(EnemyRecord)) ||
+            !isInFile(header->vinesOffset, header->vineCount, sizeof(VineRecord)))
+            return nullptr;
+
+        return header;
+    }
+
+    template <typename T>
+    const T* GetTable(const MappedFile& file, u32 offset)
+    {
+        return reinterpret_cast<const T*>(file.GetData() + offset);
+    }
+
+    // Copies the compiled level into outLvl. header must be from GetValidHeader
+    bool ReadLevelBinary(const MappedFile& file, const LevelBinaryHeader& header, LevelData& outLvl)
+    {
+        outLvl = LevelData{};
+        outLvl.rows = header.rows;
+        outLvl.cols = header.cols;
+        outLvl.spawn = { header.spawnX, header.spawnY };
+
+        const s32* tiles = GetTable<s32>(file, header.tilesOffset);
+        outLvl.tiles.assign(tiles, tiles + (size_t)header.rows * (size_t)header.cols);
+
+        const s32* links = GetTable<s32>(file, header.linksOffset);
+        const TrapRecord* traps = GetTable<TrapRecord>(file, header.trapsOffset);
+        outLvl.traps.resize(header.trapCount);
+        for (u32 i = 0; i < header.trapCount; ++i)
+        {
+            const TrapRecord& r = traps[i];
+            if ((u64)r.firstLink + r.linkCount > header.linkCount)
+                return false;
+
+            TrapDefSimple& t = outLvl.traps[i];
+            t.type = r.type;
+            t.pos = { r.posX, r.posY };
+            t.size = { r.sizeX, r.sizeY };
+            t.upTime = r.upTime;
+            t.downTime = r.downTime;
+            t.damageOnHit = r.damageOnHit;
+            t.startDisabled = r.startDisabled != 0;
+            t.damagePerTick = r.damagePerTick;
+            t.tickInterval = r.tickInterval;
+            t.id = r.id;
+            t.links.assign(links + r.firstLink, links + r.firstLink + r.linkCount);
+        }
+
+        const EnemyRecord* enemies = GetTable<EnemyRecord>(file, header.enemiesOffset);
+        outLvl.enemies.resize(header.enemyCount);
+        for (u32 i = 0; i < header.enemyCount; ++i)
+            outLvl.enemies[i] = EnemyDefSimple{ enemies[i].preset, { enemies[i].posX, enemies[i].posY } };
+
+        const VineRecord* vines = GetTable<VineRecord>(file, header.vinesOffset);
+        outLvl.vines.resize(header.vineCount);
+        for (u32 i = 0; i < header.vineCount; ++i)
+            outLvl.vines[i] = { vines[i].x, vines[i].y };
+
+        return true;
+    }
+
+    bool CreateParentDirectories(const char* filename)
     {
         std::error_code ec;
         std::filesystem::path p(filename);
@@ -96,7 +236,18 @@ bool SaveLevelToFile(const char* filename, const LevelData& lvl)
             std::filesystem::create_directories(parent, ec);
             if (ec) return false;
         }
+        return true;
     }
+}
+
+bool SaveLevelToFile(const char* filename, const LevelData& lvl)
+{
+    if (!filename) return false;
+    if (lvl.rows <= 0 || lvl.cols <= 0) return false;
+    if ((int)lvl.tiles.size() != lvl.rows * lvl.cols) return false;
+
+    // ensure parent directory exists (if using folders)
+    if (!CreateParentDirectories(filename)) return false;
 
     std::ofstream out(filename, std::ios::out | std::ios::trunc);
     if (!out.is_open()) return false;
@@ -159,13 +310,59 @@ bool SaveLevelToFile(const char* filename, const LevelData& lvl)
         out << "vine " << v.x << ' ' << v.y << "\n";
 
     out.flush();
-    return out.good();
+    if (!out.good()) return false;
+    out.close();
+
+    // Keep the compiled level in sync so the game doesn't load an old one
+    const std::string compiledPath = GetCompiledLevelPath(filename);
+    if (!CompileLevelFile(filename, compiledPath.c_str()))
+    {
+        // Stale .lvlb would be ignored anyway (size / write time mismatch), remove it so it's obvious
+        std::error_code ec;
+        std::filesystem::remove(compiledPath, ec);
+    }
+    return true;
 }
 
 bool LoadLevelFromFile(const char* filename, LevelData& outLvl)
 {
     if (!filename) return false;
 
+    const std::string compiledPath = GetCompiledLevelPath(filename);
+    u64 sourceSize = 0;
+    s64 sourceWriteTime = 0;
+    const bool hasSource = GetSourceStamp(filename, sourceSize, sourceWriteTime);
+
+    {
+        MappedFile compiled;
+        if (compiled.Open(compiledPath))
+        {
+            const LevelBinaryHeader* header = GetValidHeader(compiled);
+
+            // Only use it if it was compiled from the current .lvl (or there's no .lvl)
+            const bool isUpToDate = header != nullptr &&
+                (!hasSource || (header->sourceSize == sourceSize && header->sourceWriteTime == sourceWriteTime));
+
+            if (isUpToDate && ReadLevelBinary(compiled, *header, outLvl))
+                return true;
+        }
+    }
+
+    if (!LoadLevelFromTextFile(filename, outLvl))
+        return false;
+
+    // Builds without the LevelCompiler step (e.g. Visual Studio) compile it here,
+    // so restarts and the next runs load the .lvlb. Fine if it fails, the .lvl is loaded again next time
+    if (hasSource)
+        SaveLevelToBinaryFile(compiledPath.c_str(), outLvl, sourceSize, sourceWriteTime);
+
+    return true;
+}
+
+bool LoadLevelFromTextFile(const char* filename, LevelData& outLvl)
+{
+    if (!filename) return false;
+
     std::ifstream in(filename);
     if (!in) return false;
 
@@ -391,6 +588,119 @@ bool LoadLevelFromFile(const char* filename, LevelData& outLvl)
     return true;
 }
 
+std::string GetCompiledLevelPath(const std::string& filename)
+{
+    std::filesystem::path p(filename);
+    p.replace_extension(".lvlb");
+    return p.generic_string();
+}
+
+bool SaveLevelToBinaryFile(const char* filename, const LevelData& lvl, u64 sourceSize, s64 sourceWriteTime)
+{
+    if (!filename) return false;
+    if (lvl.rows <= 0 || lvl.cols <= 0) return false;
+    if ((int)lvl.tiles.size() != lvl.rows * lvl.cols) return false;
+
+    std::vector<TrapRecord> traps;
+    std::vector<s32> links;
+    traps.reserve(lvl.traps.size());
+    for (const auto& t : lvl.traps)
+    {
+        TrapRecord r{};
+        r.type = t.type;
+        r.posX = t.pos.x;
+        r.posY = t.pos.y;
+        r.sizeX = t.size.x;
+        r.sizeY = t.size.y;
+        r.upTime = t.upTime;
+        r.downTime = t.downTime;
+        r.damageOnHit = t.damageOnHit;
+        r.startDisabled = t.startDisabled ? 1 : 0;
+        r.damagePerTick = t.damagePerTick;
+        r.tickInterval = t.tickInterval;
+        r.id = t.id;
+        r.firstLink = (u32)links.size();
+        r.linkCount = (u32)t.links.size();
+        links.insert(links.end(), t.links.begin(), t.links.end());
+        traps.push_back(r);
+    }
+
+    std::vector<EnemyRecord> enemies;
+    enemies.reserve(lvl.enemies.size());
+    for (const auto& e : lvl.enemies)
+        enemies.push_back({ e.preset, e.pos.x, e.pos.y });
+
+    std::vector<VineRecord> vines;
+    vines.reserve(lvl.vines.size());
+    for (const auto& v : lvl.vines)
+        vines.push_back({ v.x, v.y });
+
+    LevelBinaryHeader header{};
+    std::memcpy(header.magic, LEVEL_BINARY_MAGIC, sizeof(LEVEL_BINARY_MAGIC));
+    header.version = LEVEL_BINARY_VERSION;
+    header.sourceSize = sourceSize;
+    header.sourceWriteTime = sourceWriteTime;
+    header.rows = lvl.rows;
+    header.cols = lvl.cols;
+    header.spawnX = lvl.spawn.x;
+    header.spawnY = lvl.spawn.y;
+    header.trapCount = (u32)traps.size();
+    header.linkCount = (u32)links.size();
+    header.enemyCount = (u32)enemies.size();
+    header.vineCount = (u32)vines.size();
+
+    // Every record is a multiple of 4 bytes so the tables stay aligned
+    u32 offset = sizeof(LevelBinaryHeader);
+    header.tilesOffset = offset;   offset += (u32)(lvl.tiles.size() * sizeof(s32));
+    header.trapsOffset = offset;   offset += (u32)(traps.size() * sizeof(TrapRecord));
+    header.linksOffset = offset;   offset += (u32)(links.size() * sizeof(s32));
+    header.enemiesOffset = offset; offset += (u32)(enemies.size() * sizeof(EnemyRecord));
+    header.vinesOffset = offset;
+
+    if (!CreateParentDirectories(filename)) return false;
+
+    std::ofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    static_assert(sizeof(int) == sizeof(s32), "tiles are written as s32");
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(lvl.tiles.data()), lvl.tiles.size() * sizeof(s32));
+    out.write(reinterpret_cast<const char*>(traps.data()), traps.size() * sizeof(TrapRecord));
+    out.write(reinterpret_cast<const char*>(links.data()), links.size() * sizeof(s32));
+    out.write(reinterpret_cast<const char*>(enemies.data()), enemies.size() * sizeof(EnemyRecord));
+    out.write(reinterpret_cast<const char*>(vines.data()), vines.size() * sizeof(VineRecord));
+
+    out.flush();
+    return out.good();
+}
+
+bool LoadLevelFromBinaryFile(const char* filename, LevelData& outLvl)
+{
+    if (!filename) return false;
+
+    MappedFile file;
+    if (!file.Open(filename)) return false;
+
+    const LevelBinaryHeader* header = GetValidHeader(file);
+    if (!header) return false;
+
+    return ReadLevelBinary(file, *header, outLvl);
+}
+
+bool CompileLevelFile(const char* lvlFilename, const char* lvlbFilename)
+{
+    if (!lvlFilename || !lvlbFilename) return false;
+
+    LevelData lvl;
+    if (!LoadLevelFromTextFile(lvlFilename, lvl)) return false;
+
+    u64 sourceSize = 0;
+    s64 sourceWriteTime = 0;
+    if (!GetSourceStamp(lvlFilename, sourceSize, sourceWriteTime)) return false;
+
+    return SaveLevelToBinaryFile(lvlbFilename, lvl, sourceSize, sourceWriteTime);
+}
+
 void BuildLevelDataFromEditor(
     MapGrid& grid, int cols, int rows,
     const std::vector<TrapDefSimple>& traps,
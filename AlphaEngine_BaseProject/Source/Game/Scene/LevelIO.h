@@ -46,9 +46,31 @@ struct LevelData
     std::vector<AEVec2> vines;              // grid cell positions
 };
 
+// Writes the text .lvl and the compiled .lvlb next to it
 bool SaveLevelToFile(const char* filename, const LevelData& lvl);
+
+// Loads the compiled .lvlb next to the file if it's up to date with the .lvl,
+// else parses the text .lvl and writes the .lvlb for the next load
 bool LoadLevelFromFile(const char* filename, LevelData& out);
 
+// Only parses the text format
+bool LoadLevelFromTextFile(const char* filename, LevelData& out);
+
+// === Compiled levels (.lvlb) ===
+// Binary copy of a .lvl: header, raw tile array, trap / link / enemy / vine tables.
+// Memory mapped and copied straight into LevelData, no parsing.
+// Stores the size and last write time of the .lvl it was compiled from so a stale .lvlb is ignored.
+
+// "Assets/Levels/lv1.lvl" -> "Assets/Levels/lv1.lvlb"
+std::string GetCompiledLevelPath(const std::string& filename);
+
+// sourceSize / sourceWriteTime identify the .lvl it was compiled from (0 if none)
+bool SaveLevelToBinaryFile(const char* filename, const LevelData& lvl, u64 sourceSize = 0, s64 sourceWriteTime = 0);
+bool LoadLevelFromBinaryFile(const char* filename, LevelData& out);
+
+// Parses the .lvl and writes the .lvlb
+bool CompileLevelFile(const char* lvlFilename, const char* lvlbFilename);
+
 // NOTE: MapGrid::GetTile is often NON-const in your codebase,
 // so we take MapGrid& (not const MapGrid&).
 void BuildLevelDataFromEditor(
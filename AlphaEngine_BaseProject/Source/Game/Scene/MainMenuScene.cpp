@@ -8,6 +8,7 @@
 #include "../Time.h"
 #include "../UI.h"
 #include "../AudioManager.h"
+#include "../../Utils/Renderer.h"
 
 #include <Windows.h>
 #include <new>
@@ -242,6 +243,8 @@ void MainMenuScene::Render()
 
     player.Render();
     enemyMgr.RenderAll();
+    // Traps and sprites, under the text
+    Renderer::Flush();
 
     if (uiFont >= 0)
     {
@@ -15,8 +15,8 @@
 
 #include "../Time.h"
 #include "../UI.h"
-#include "../rooms/RoomManager.h"
-#include "../rooms/roomBuilder.h"
+#include "../Rooms/RoomManager.h"
+#include "../Rooms/RoomBuilder.h"
 
 #include <iostream>
 #include <vector>
@@ -45,7 +45,7 @@ static MapGrid* gMap = nullptr;
 static Camera* gCamera = nullptr;
 
 static RoomManager  gPlayRoomMgr;
-static RoomID       gPlayStartRoom = ROOM_1;
+static RoomID       gPlayStartRoom = ROOM_NONE;
 static bool         gPlayRoomTransitionLocked = false;
 
 static EditorUIState gUI{};
@@ -583,24 +583,15 @@ static void PlayMode_ClearRuntimeRoomObjects()
     }
 }
 
-static int PlayMode_GetRoomsPerRow()
-{
-    return max(1, GRID_COLS / ROOM_COLS);
-}
-
 static AEVec2 PlayMode_GetRoomOrigin(RoomID id)
 {
-    if (id == ROOM_NONE)
+    if (!gPlayRoomMgr.HasRoom(id))
         return AEVec2{ 0.f, 0.f };
 
-    const int roomsPerRow = PlayMode_GetRoomsPerRow();
-    const int idx = static_cast<int>(id);
-    const int rx = idx % roomsPerRow;
-    const int ry = idx / roomsPerRow;
-
+    const RoomData& room = gPlayRoomMgr.GetRoom(id);
     return AEVec2{
-        rx * static_cast<float>(ROOM_COLS),
-        ry * static_cast<float>(ROOM_ROWS)
+        room.gridX * static_cast<float>(ROOM_COLS),
+        room.gridY * static_cast<float>(ROOM_ROWS)
     };
 }
 
@@ -784,12 +775,12 @@ static void PlayMode_BuildCurrentRoom(RoomDirection cameFrom, const AEVec2* forc
 
     bool hasBoss = false;
     std::vector<EnemyManager::SpawnInfo> spawns;
-    for (int i = 0; i < room.enemyCount; ++i)
+    for (const RoomEnemySpawn& es : room.enemies)
     {
-        EnemySpawnType type = (EnemySpawnType)room.enemies[i].preset;
+        EnemySpawnType type = (EnemySpawnType)es.preset;
         AEVec2 worldPos{
-            roomOrigin.x + room.enemies[i].pos.x,
-            roomOrigin.y + room.enemies[i].pos.y
+            roomOrigin.x + es.pos.x,
+            roomOrigin.y + es.pos.y
         };
         spawns.push_back({ type, worldPos });
         if (type == EnemySpawnType::Boss)
@@ -808,7 +799,7 @@ static void PlayMode_BuildCurrentRoom(RoomDirection cameFrom, const AEVec2* forc
     }
 
     gPlayEnemies->SetBoss(gPlayBoss);
-    gPlayEnemies->SetCurrentRoomID(room.id);
+    gPlayEnemies->SetRoomDepth(room.depth);
     gPlayEnemies->SetSpawns(spawns);
     gPlayEnemies->SpawnAll();
 
@@ -900,10 +891,7 @@ static void PlayMode_Enter()
         gTrapDefs, gEnemyDefs, gVinePositions, gSpawn, lvl);
 
     gPlayRoomMgr.Clear();
-    gPlayStartRoom = ROOM_1;
     BuildRoomsFromLevelData(lvl, gPlayRoomMgr, gPlayStartRoom);
-    if (!gPlayRoomMgr.HasRoom(gPlayStartRoom))
-        gPlayStartRoom = ROOM_1;
 
     delete gPlayBoss;
     gPlayBoss = nullptr;
@@ -946,7 +934,7 @@ static void PlayMode_Exit()
 
     gPlayRoomMgr.Clear();
     gPlayRoomTransitionLocked = false;
-    gPlayStartRoom = ROOM_1;
+    gPlayStartRoom = ROOM_NONE;
 
     ApplyWorldCamera();
 }
@@ -1,21 +1,51 @@
 #include "Time.h"
+#include <cmath>
 #include <iostream>
 
-void Time::Update() {
-    deltaTime = AEFrameRateControllerGetFrameTime();
+void Time::BeginFrame() {
+    frameDeltaTime = AEFrameRateControllerGetFrameTime();
+    deltaTime = frameDeltaTime;
+    ticksThisFrame = 0;
+
+    // Paused time is never simulated
+    if (!isPaused) {
+        accumulator += frameDeltaTime;
+    }
+}
 
+void Time::Update() {
     // Always update real-time
-    elapsedTime += deltaTime;
+    elapsedTime += frameDeltaTime;
+}
 
-    // Update unpaused unscaled time
-    if (!isPaused) {
-        unpausedElapsedTime += deltaTime;
+bool Time::BeginTick() {
+    if (accumulator >= fixedDeltaTime && ticksThisFrame < maxTicksPerFrame) {
+        isInTick = true;
+        deltaTime = fixedDeltaTime;
+        return true;
     }
 
-    // Update scaled pausable time (game time)
-    if (!isPaused) {
-        scaledElapsedTime += deltaTime * timeScale;
+    // Rendering stalled. Drop the time instead of catching up, keeping the phase for interpolation
+    if (ticksThisFrame >= maxTicksPerFrame) {
+        accumulator = std::fmod(accumulator, fixedDeltaTime);
     }
+
+    return false;
+}
+
+void Time::EndTick() {
+    accumulator -= fixedDeltaTime;
+    ++ticksThisFrame;
+    isInTick = false;
+    deltaTime = frameDeltaTime;
+
+    // Game time moves in ticks so gameplay sees the same times at any frame rate
+    unpausedElapsedTime += fixedDeltaTime;
+    scaledElapsedTime += fixedDeltaTime * timeScale;
+}
+
+bool Time::IsInTick() const {
+    return isInTick;
 }
 
 f64 Time::GetElapsedTime() const {
@@ -39,6 +69,44 @@ f64 Time::GetScaledDeltaTime() const
     return deltaTime * timeScale;
 }
 
+f64 Time::GetFrameDeltaTime() const {
+    return frameDeltaTime;
+}
+
+void Time::SetTickRate(f64 ticksPerSecond) {
+    if (ticksPerSecond <= 0.0) {
+        std::cout << "Tick rate must be more than 0, got " << ticksPerSecond << std::endl;
+        return;
+    }
+
+    fixedDeltaTime = 1.0 / ticksPerSecond;
+}
+
+f64 Time::GetTickRate() const {
+    return 1.0 / fixedDeltaTime;
+}
+
+f64 Time::GetFixedDeltaTime() const {
+    return fixedDeltaTime;
+}
+
+void Time::SetMaxTicksPerFrame(int maxTicks) {
+    maxTicksPerFrame = maxTicks < 1 ? 1 : maxTicks;
+}
+
+int Time::GetMaxTicksPerFrame() const {
+    return maxTicksPerFrame;
+}
+
+int Time::GetTicksThisFrame() const {
+    return ticksThisFrame;
+}
+
+f32 Time::GetInterpolationAlpha() const {
+    const f64 alpha = accumulator / fixedDeltaTime;
+    return static_cast<f32>(alpha < 0.0 ? 0.0 : (alpha > 1.0 ? 1.0 : alpha));
+}
+
 void Time::SetTimeScale(f32 scale) {
     // Clamp to reasonable values
     if (scale < 0.0f) scale = 0.0f;
@@ -71,5 +139,6 @@ void Time::ResetElapsedTime()
     scaledElapsedTime = 0.0;
     unpausedElapsedTime = 0.0;
     deltaTime = 0.0;
+    accumulator = 0.0;
     isPaused = false;
 }
\ No newline at end of file
@@ -11,14 +11,35 @@ public:
         return instance;
     }
 
+    // Call at the start of the frame. Adds the frame's time to the fixed step accumulator
+    void BeginFrame();
+    // Call at the end of the frame. Updates real-time
     void Update();
 
+    // Fixed step loop. Game time only moves forward in ticks:
+    //  while (time.BeginTick()) { scene->FixedUpdate(); time.EndTick(); }
+    bool BeginTick();                     // True if there's enough time in the accumulator for another tick
+    void EndTick();
+    bool IsInTick() const;
+
     // Time getters
     f64 GetElapsedTime() const;           // Real-time
     f64 GetScaledElapsedTime() const;     // Game time
     f64 GetUnpausedElapsedTime() const;   // Unscaled but pausable
-    f64 GetDeltaTime() const;             // Last frame delta
-    f64 GetScaledDeltaTime() const;       // Last frame scaled delta
+    f64 GetDeltaTime() const;             // Fixed delta inside a tick, this frame's delta outside
+    f64 GetScaledDeltaTime() const;       // Scaled GetDeltaTime
+    f64 GetFrameDeltaTime() const;        // This frame's delta, even inside a tick
+
+    // Fixed step settings
+    void SetTickRate(f64 ticksPerSecond);
+    f64 GetTickRate() const;
+    f64 GetFixedDeltaTime() const;
+    void SetMaxTicksPerFrame(int maxTicks);
+    int GetMaxTicksPerFrame() const;
+    int GetTicksThisFrame() const;
+
+    // How far the accumulator is into the next tick [0, 1). For interpolating positions when rendering
+    f32 GetInterpolationAlpha() const;
 
     // Time scale control
     void SetTimeScale(f32 scale);
@@ -39,6 +60,12 @@ private:
         scaledElapsedTime(0.0),
         unpausedElapsedTime(0.0),
         deltaTime(0.0),
+        frameDeltaTime(0.0),
+        fixedDeltaTime(1.0 / 120.0),
+        accumulator(0.0),
+        maxTicksPerFrame(8),
+        ticksThisFrame(0),
+        isInTick(false),
         timeScale(1.0f),
         isPaused(false) {
     }
@@ -46,7 +73,14 @@ private:
     f64 elapsedTime;           // Real-time (never pauses, never scales)
     f64 scaledElapsedTime;     // Game time (pauses and scales)
     f64 unpausedElapsedTime;   // Unscaled but pausable
-    f64 deltaTime;             // Last frame's delta time
+    f64 deltaTime;             // Fixed delta inside a tick, frame delta outside
+    f64 frameDeltaTime;        // This frame's delta time
+
+    f64 fixedDeltaTime;
+    f64 accumulator;           // Time that hasn't been simulated yet
+    int maxTicksPerFrame;      // Time past this is dropped, so a long frame doesn't make the next one longer
+    int ticksThisFrame;
+    bool isInTick;
 
     f32 timeScale;
     bool isPaused;
@@ -1,239 +1,248 @@
 #include "Timer.h"
 #include "Time.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 void TimerSystem::Update() {
-	CheckTimerCompletion();
+	for (int clock = 0; clock < Timer::CLOCK_COUNT; ++clock)
+		CheckTimerCompletion(static_cast<Timer::Clock>(clock));
 }
 
 void TimerSystem::Clear() {
 	std::cout << "Clearing all timers from TimerSystem." << std::endl;
-	timers.clear();
-	timerMap.clear();
-	anonymousTimerMap.clear();
+	timers.Clear();
+	for (Schedule& schedule : schedules) {
+		schedule.heap.clear();
+		schedule.removedCount = 0;
+	}
+	std::fill(namedTimers.begin(), namedTimers.end(), TimerHandle{});
 	ResetActiveTimerCount();
 }
 
-void TimerSystem::AddTimer(const std::string& name, f64 duration, bool autoRemove,
+TimerNameId TimerSystem::InternName(const std::string& name) {
+	auto it = nameIds.find(name);
+	if (it != nameIds.end())
+		return it->second;
+
+	TimerNameId nameId = static_cast<TimerNameId>(names.size());
+	names.push_back(name);
+	nameIds.emplace(name, nameId);
+	namedTimers.emplace_back();
+	return nameId;
+}
+
+const std::string& TimerSystem::GetName(TimerNameId nameId) const {
+	static const std::string anonymousName = "";
+	return nameId < names.size() ? names[nameId] : anonymousName;
+}
+
+void TimerSystem::AddTimer(TimerNameId nameId, f64 duration, bool autoRemove,
 	bool ignoreTimeScale, bool ignorePause, bool loopable, u32 loopCount) {
-	Timer timer;
-	if ((TimerSystem::GetTimerByName(name)) != nullptr) {
-		//std::cout << "Timer \"" << name << "\" already exists. Skipping addition." << std::endl;
+	if (nameId >= namedTimers.size()) {
+		std::cout << "TimerSystem::AddTimer - Name ID " << nameId << " wasn't interned" << std::endl;
+		return;
+	}
+	if (timers.IsValid(namedTimers[nameId])) {
+		//std::cout << "Timer \"" << GetName(nameId) << "\" already exists. Skipping addition." << std::endl;
 		return;
 	}
-	timer.name = name;
-	timer.isAnonymous = false;
-	timer.id = 0;
-	timer.ignoreTimeScale = ignoreTimeScale;
-	timer.ignorePause = ignorePause;
 
-	// Use correct time based on timer settings
-	f64 currentTime = GetTimeForTimer(timer);
+	namedTimers[nameId] = CreateTimer(nameId, duration, autoRemove, ignoreTimeScale, ignorePause, loopable, loopCount);
+}
 
-	timer.startTime = currentTime;
-	timer.endTime = timer.startTime + duration;
-	timer.duration = duration;
-	timer.percentage = 0.0f;
-	timer.completed = false;
-	timer.autoRemove = autoRemove;
-	timer.completedCount = 0;
-	timer.loopable = loopable;
-	timer.loopCount = loopCount;
+void TimerSystem::AddTimer(const std::string& name, f64 duration, bool autoRemove,
+	bool ignoreTimeScale, bool ignorePause, bool loopable, u32 loopCount) {
+	AddTimer(InternName(name), duration, autoRemove, ignoreTimeScale, ignorePause, loopable, loopCount);
+}
 
-	timers.push_back(timer);
-	timerMap[name] = timers.size() - 1;
-	activeTimerCount++;
+void TimerSystem::RemoveTimer(TimerNameId nameId) {
+	if (nameId >= namedTimers.size())
+		return;
 
-	//std::cout << "Initialized Timer \"" << timer.name << "\" for " << timer.duration
-	//	<< " seconds (ignoreScale=" << ignoreTimeScale
-	//	<< ", ignorePause=" << ignorePause << ")" << std::endl;
+	DestroyTimer(namedTimers[nameId]);
+	namedTimers[nameId] = {};
 }
-void TimerSystem::RemoveTimer(const std::string& name) {
-	auto it = timerMap.find(name);
-	if (it != timerMap.end()) {
-		size_t index = it->second;
-		timers.erase(timers.begin() + index);
-		timerMap.erase(it);
-
-		for (auto& pair : timerMap) {
-			if (pair.second > index) {
-				pair.second--;
-			}
-		}
-		for (auto& pair : anonymousTimerMap) {
-			if (pair.second > index) {
-				pair.second--;
-			}
-		}
 
-		activeTimerCount--;
-		//std::cout << "Removed Timer \"" << name << "\"." << std::endl;
-	}
+void TimerSystem::RemoveTimer(const std::string& name) {
+	auto it = nameIds.find(name);
+	if (it != nameIds.end())
+		RemoveTimer(it->second);
 }
 
+const Timer* TimerSystem::GetTimerByName(TimerNameId nameId) const {
+	return nameId < namedTimers.size() ? timers.Find(namedTimers[nameId]) : nullptr;
+}
 
 const Timer* TimerSystem::GetTimerByName(const std::string& name) const {
-	auto it = timerMap.find(name);
-	if (it != timerMap.end()) {
-		return &timers[it->second];
-	}
-	return nullptr; // Return nullptr if timer not found
+	auto it = nameIds.find(name);
+	return it != nameIds.end() ? GetTimerByName(it->second) : nullptr;
+}
+
+f32 TimerSystem::GetTimerPercentage(TimerNameId nameId) const {
+	const Timer* timer = GetTimerByName(nameId);
+	return timer ? GetTimerPercentage(*timer) : 0.0f;
 }
 
-u32 TimerSystem::AddAnonymousTimer(f64 duration, bool autoRemove,
+TimerHandle TimerSystem::AddAnonymousTimer(f64 duration, bool autoRemove,
+	bool ignoreTimeScale, bool ignorePause, bool loopable, u32 loopCount) {
+	return CreateTimer(INVALID_TIMER_NAME, duration, autoRemove, ignoreTimeScale, ignorePause, loopable, loopCount);
+}
+
+void TimerSystem::RemoveAnonymousTimer(TimerHandle handle) {
+	const Timer* timer = timers.Find(handle);
+	if (timer && timer->IsAnonymous())
+		DestroyTimer(handle);
+}
+
+const Timer* TimerSystem::GetTimerById(TimerHandle handle) const {
+	return timers.Find(handle);
+}
+
+bool TimerSystem::IsTimerComplete(TimerHandle handle) const {
+	const Timer* timer = GetTimerById(handle);
+	return timer ? timer->completed : false;
+}
+
+f32 TimerSystem::GetTimerPercentage(TimerHandle handle) const {
+	const Timer* timer = GetTimerById(handle);
+	return timer ? GetTimerPercentage(*timer) : 0.0f;
+}
+
+f32 TimerSystem::GetTimerPercentage(const Timer& timer) const {
+	if (timer.completed || timer.duration <= 0.0)
+		return 1.0f;
+
+	// Uses the time of the last Update, same as the completed flag
+	f64 percentage = (schedules[timer.clock].lastUpdateTime - timer.startTime) / timer.duration;
+	return static_cast<f32>(std::clamp(percentage, 0.0, 1.0));
+}
+
+TimerHandle TimerSystem::CreateTimer(TimerNameId nameId, f64 duration, bool autoRemove,
 	bool ignoreTimeScale, bool ignorePause, bool loopable, u32 loopCount) {
 	Timer timer;
-	timer.id = nextTimerId++;
-	timer.name = "";
-	timer.isAnonymous = true;
+	timer.nameId = nameId;
 	timer.ignoreTimeScale = ignoreTimeScale;
 	timer.ignorePause = ignorePause;
+	if (ignorePause && ignoreTimeScale)
+		timer.clock = Timer::CLOCK_REAL;
+	else if (ignoreTimeScale)
+		timer.clock = Timer::CLOCK_UNPAUSED;
+	else
+		timer.clock = Timer::CLOCK_SCALED;
 
-	// Use appropriate time base from Time system
-	f64 currentTime = GetTimeForTimer(timer);
-
-	timer.startTime = currentTime;
+	// Use correct time based on timer settings
+	timer.startTime = GetClockTime(timer.clock);
 	timer.endTime = timer.startTime + duration;
 	timer.duration = duration;
-	timer.percentage = 0.0f;
 	timer.completed = false;
 	timer.autoRemove = autoRemove;
 	timer.completedCount = 0;
 	timer.loopable = loopable;
 	timer.loopCount = loopCount;
 
-	timers.push_back(timer);
-	anonymousTimerMap[timer.id] = timers.size() - 1;
+	TimerHandle handle = timers.Get(timer);
+	Schedule& schedule = schedules[timer.clock];
+	schedule.heap.push_back({ timer.endTime, handle });
+	std::push_heap(schedule.heap.begin(), schedule.heap.end());
+
 	activeTimerCount++;
 
-	/*std::cout << "Initialized Anonymous Timer ID:" << timer.id
-		<< " for " << timer.duration << " seconds"
-		<< " (ignoreScale=" << ignoreTimeScale
-		<< ", ignorePause=" << ignorePause << ")" << std::endl;*/
+	//std::cout << "Initialized Timer \"" << GetName(nameId) << "\" for " << duration
+	//	<< " seconds (ignoreScale=" << ignoreTimeScale
+	//	<< ", ignorePause=" << ignorePause << ")" << std::endl;
 
-	return timer.id;
+	return handle;
 }
 
-void TimerSystem::RemoveAnonymousTimer(u32 timerId) {
-	auto it = anonymousTimerMap.find(timerId);
-	if (it != anonymousTimerMap.end()) {
-		size_t index = it->second;
-		timers.erase(timers.begin() + index);
-		anonymousTimerMap.erase(it);
+void TimerSystem::DestroyTimer(TimerHandle handle) {
+	const Timer* timer = timers.Find(handle);
+	if (!timer)
+		return;
 
-		// Update all indices after the erased element
-		for (auto& pair : anonymousTimerMap) {
-			if (pair.second > index) {
-				pair.second--;
-			}
-		}
-		// Also update named timer map
-		for (auto& pair : timerMap) {
-			if (pair.second > index) {
-				pair.second--;
-			}
-		}
+	// Completed timers were already popped from the heap
+	bool isScheduled = !timer->completed;
+	Schedule& schedule = schedules[timer->clock];
+
+	timers.Release(handle);
+	activeTimerCount--;
 
-		activeTimerCount--;
-		//std::cout << "Removed Anonymous Timer ID:" << timerId << std::endl;
+	if (isScheduled) {
+		schedule.removedCount++;
+		CompactSchedule(schedule);
 	}
 }
 
-const Timer* TimerSystem::GetTimerById(u32 timerId) const {
-	auto it = anonymousTimerMap.find(timerId);
-	if (it != anonymousTimerMap.end()) {
-		return &timers[it->second];
+void TimerSystem::CheckTimerCompletion(Timer::Clock clock) {
+	Schedule& schedule = schedules[clock];
+	f64 currentTime = GetClockTime(clock);
+	schedule.lastUpdateTime = currentTime;
+
+	std::vector<ScheduledTimer>& heap = schedule.heap;
+	while (!heap.empty() && heap.front().endTime <= currentTime) {
+		std::pop_heap(heap.begin(), heap.end());
+		TimerHandle handle = heap.back().handle;
+		heap.pop_back();
+
+		Timer* timer = timers.Find(handle);
+		if (!timer) {
+			// Removed before it ended
+			schedule.removedCount--;
+			continue;
+		}
+
+		timer->completed = true;
+		/*std::cout << "Timer ";
+		if (timer->IsAnonymous()) {
+			std::cout << "ID:" << handle.index;
+		}
+		else {
+			std::cout << "\"" << GetName(timer->nameId) << "\"";
+		}
+		std::cout << " completed!" << std::endl;*/
+
+		if (timer->autoRemove) {
+			if (!timer->IsAnonymous())
+				namedTimers[timer->nameId] = {};
+			timers.Release(handle);
+			activeTimerCount--;
+		}
+		// Handle looping timers, loopCount is reduced by 1 to account for initial completion
+		else if (timer->loopable && timer->completedCount < timer->loopCount - 1) {
+			// Loop timer - restart with current time
+			timer->startTime = currentTime;
+			timer->endTime = timer->startTime + timer->duration;
+			timer->completed = false;
+			timer->completedCount++;
+
+			// Ends next Update at the earliest, even with a duration of 0
+			heap.push_back({ (std::max)(timer->endTime, std::nextafter(currentTime, currentTime + 1.0)), handle });
+			std::push_heap(heap.begin(), heap.end());
+		}
 	}
-	return nullptr;
 }
 
-bool TimerSystem::IsTimerComplete(u32 timerId) const {
-	const Timer* timer = GetTimerById(timerId);
-	return timer ? timer->completed : false;
-}
+void TimerSystem::CompactSchedule(Schedule& schedule) {
+	constexpr u32 MIN_REMOVED = 64;
+	if (schedule.removedCount < MIN_REMOVED || schedule.removedCount * 2 < schedule.heap.size())
+		return;
 
-f32 TimerSystem::GetTimerPercentage(u32 timerId) const {
-	const Timer* timer = GetTimerById(timerId);
-	return timer ? (static_cast<f32>(timer->percentage)) : 0.0f;
+	std::erase_if(schedule.heap, [this](const ScheduledTimer& entry) { return !timers.IsValid(entry.handle); });
+	std::make_heap(schedule.heap.begin(), schedule.heap.end());
+	schedule.removedCount = 0;
 }
 
-// Helper to get the right time counter for a timer
-f64 TimerSystem::GetTimeForTimer(const Timer& timer) const {
-	if (timer.ignorePause && timer.ignoreTimeScale) {
+// Helper to get the right time counter for a clock
+f64 TimerSystem::GetClockTime(Timer::Clock clock) {
+	switch (clock) {
+	case Timer::CLOCK_REAL:
 		// Real-time: never pauses, never scales
 		return Time::GetInstance().GetElapsedTime();
-	}
-	else if (!timer.ignorePause && timer.ignoreTimeScale) {
+	case Timer::CLOCK_UNPAUSED:
 		// Pauses but doesn't scale
 		return Time::GetInstance().GetUnpausedElapsedTime();
-	}
-	else {
+	default:
 		// Normal timer: pauses and scales
 		return Time::GetInstance().GetScaledElapsedTime();
 	}
 }
-
-void TimerSystem::CheckTimerCompletion() {
-	for (auto it = timers.begin(); it != timers.end(); ) {
-		// Get the appropriate time counter for this timer
-		f64 currentTime = GetTimeForTimer(*it);
-
-		// Calculate percentage
-		it->percentage = (currentTime - it->startTime) / it->duration;
-		if (it->percentage > 1.0f) {
-			it->percentage = 1.0f;
-		}
-
-		// Check completion
-		if (currentTime >= it->endTime) {
-			it->completed = true;
-			/*std::cout << "Timer ";
-			if (it->isAnonymous) {
-				std::cout << "ID:" << it->id;
-			}
-			else {
-				std::cout << "\"" << it->name << "\"";
-			}
-			std::cout << " completed!" << std::endl;*/
-
-			if (it->autoRemove) {
-				activeTimerCount--;
-				size_t index = std::distance(timers.begin(), it);
-
-				if (it->isAnonymous) {
-					anonymousTimerMap.erase(it->id);
-				}
-				else {
-					//std::cout << "Removed Timer \"" << it->name << "\"." << std::endl;
-					timerMap.erase(it->name);
-				}
-
-				it = timers.erase(it);
-
-				// Update both maps
-				for (auto& pair : timerMap) {
-					if (pair.second > index) {
-						pair.second--;
-					}
-				}
-				for (auto& pair : anonymousTimerMap) {
-					if (pair.second > index) {
-						pair.second--;
-					}
-				}
-				continue;
-			}
-			// Handle looping timers, loopCount is reduced by 1 to account for initial completion
-			else if (it->loopable && it->completedCount < it->loopCount - 1){
-				// Loop timer - restart with current time
-				it->startTime = currentTime;
-				it->endTime = it->startTime + it->duration;
-				it->percentage = 0.0f;
-				it->completed = false;
-				it->completedCount++;
-			}
-		}
-		++it;
-	}
-}
-
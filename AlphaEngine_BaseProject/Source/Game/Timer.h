@@ -3,23 +3,44 @@
 #include <vector>
 #include <unordered_map>
 #include <AEEngine.h>
+#include "../Utils/ObjectPool.h"
+
+// Interned timer name, see TimerSystem::InternName. Stays valid after TimerSystem::Clear.
+using TimerNameId = u32;
+static constexpr TimerNameId INVALID_TIMER_NAME = static_cast<TimerNameId>(-1);
 
 struct Timer {
-	std::string name = ""; // Name of this timer.
+	// Time counter the timer runs on, based on ignoreTimeScale / ignorePause.
+	enum Clock : u8 {
+		CLOCK_SCALED,	// Pauses and scales
+		CLOCK_UNPAUSED,	// Pauses but doesn't scale
+		CLOCK_REAL,		// Never pauses, never scales
+
+		CLOCK_COUNT
+	};
+
+	TimerNameId nameId = INVALID_TIMER_NAME; // Name of this timer. INVALID_TIMER_NAME if anonymous.
 	f64 startTime = 0.0f; // Start time in seconds. Will automatically be set to reference elapsed time on creation.
 	f64 endTime = 0.0f; // End time in seconds. Will automatically be set to reference start time + elapsed time on creation.
 	f64 duration = 0.0f; // Duration of timer in seconds.
-	f64 percentage = 0.0f; // Percentage of timer completed (0.0 to 1.0).
 	bool completed = false; // Whether the timer has completed.
 	bool autoRemove = true; // Whether to automatically remove the timer on completion. True by default.
 	u32 completedCount = 0; // Number of times this timer has completed (for recurring timers).
-	u32 id = 0; // Unique identifier for the timer.
-	bool isAnonymous = false; // Whether the timer is anonymous (no name).
 	bool ignoreTimeScale = false; // Whether the timer ignores time scale.
 	bool ignorePause = false; // Whether the timer ignores pause state.
 	bool loopable = false; // Whether the timer loops upon completion.
 	u32 loopCount = 0; // Number of times the timer has looped.
+	Clock clock = CLOCK_SCALED; // Set from ignoreTimeScale / ignorePause on creation.
+
+	bool IsAnonymous() const { return nameId == INVALID_TIMER_NAME; }
 };
+
+// Refers to a timer. Stops finding it once the timer is removed, even if the slot is reused.
+using TimerHandle = ObjectPool<Timer>::Handle;
+
+// Timers are stored in an ObjectPool and scheduled in a min-heap per clock, keyed by endTime.
+// Update only pops the timers that end this frame, so waiting timers cost nothing per frame.
+// Adding and removing don't move other timers, removed timers are skipped when their heap entry comes up.
 class TimerSystem {
 public:
 	TimerSystem(const TimerSystem&) = delete;
@@ -31,48 +52,61 @@ public:
 		return instance;
 	}
 
-	// Returns total elapsed time in seconds.
-	//f64 GetElapsedTime() const;
-
 	// Updates the timer system, should be called once per frame.
 	void Update();
 
-	// Clears all timers from the system.
+	// Clears all timers from the system. Interned names are kept.
 	void Clear();
 
+	// ========= NAMES ========= //
+
+	// Returns the ID of a name, adding it if it's new. Cache the result (e.g. in a static) to skip hashing the string every call.
+	TimerNameId InternName(const std::string& name);
+
+	// Returns the name of an interned ID.
+	const std::string& GetName(TimerNameId nameId) const;
+
 	// ========= NAMED TIMERS ========= //
-	
-	// Adds a new timer to the system.
+	// The string versions intern the name, then call the TimerNameId versions.
+
+	// Adds a new timer to the system. Does nothing if a timer with the same name exists.
+	void AddTimer(TimerNameId nameId, f64 duration, bool autoRemove = true,
+		bool ignoreTimeScale = false, bool ignorePause = false, bool loopable = false, u32 loopCount = 0);
 	void AddTimer(const std::string& name, f64 duration, bool autoRemove = true,
 		bool ignoreTimeScale = false, bool ignorePause = false, bool loopable = false, u32 loopCount = 0);
 
 	// Removes a timer from the system by name.
+	void RemoveTimer(TimerNameId nameId);
 	void RemoveTimer(const std::string& name);
 
 	// Returns a pointer to a timer by name, or nullptr if not found.
+	const Timer* GetTimerByName(TimerNameId nameId) const;
 	const Timer* GetTimerByName(const std::string& name) const;
 
-	// Returns a const reference to the list of timers.
-	//const std::vector<Timer>& GetTimers() const { return timers; }
+	// Get percentage of named timer (0.0 to 1.0), as of the last Update.
+	f32 GetTimerPercentage(TimerNameId nameId) const;
 
 	// ========= ANONYMOUS TIMERS ========= //
 
-	// Add anonymous timer - returns handle/ID
-	u32 AddAnonymousTimer(f64 duration, bool autoRemove = true,
+	// Add anonymous timer - returns handle
+	TimerHandle AddAnonymousTimer(f64 duration, bool autoRemove = true,
 		bool ignoreTimeScale = false, bool ignorePause = false, bool loopable = false, u32 loopCount = 0);
 
-	// Remove anonymous timer by ID
-	void RemoveAnonymousTimer(u32 timerId);
+	// Remove anonymous timer by handle
+	void RemoveAnonymousTimer(TimerHandle handle);
 
-	// Get anonymous timer by ID
-	const Timer* GetTimerById(u32 timerId) const;
+	// Get anonymous timer by handle
+	const Timer* GetTimerById(TimerHandle handle) const;
 
 	// Check if anonymous timer is complete
-	bool IsTimerComplete(u32 timerId) const;
+	bool IsTimerComplete(TimerHandle handle) const;
 
 	// Get percentage of anonymous timer
-	f32 GetTimerPercentage(u32 timerId) const;
-	
+	f32 GetTimerPercentage(TimerHandle handle) const;
+
+	// Percentage of timer completed (0.0 to 1.0), as of the last Update.
+	f32 GetTimerPercentage(const Timer& timer) const;
+
 	// ========= TIMER MANAGEMENT ========= //
 
 	// Returns the count of active timers.
@@ -83,19 +117,45 @@ public:
 /*_______________________________________________________________________________________*/
 private:
 	// Private constructor to prevent direct instantiation
-	TimerSystem() : elapsedTime(0.0), activeTimerCount(0), nextTimerId(1) {}
+	TimerSystem() = default;
+
+	struct ScheduledTimer {
+		f64 endTime;
+		TimerHandle handle;
+
+		// Reversed so the std heap functions keep the earliest endTime at the front
+		bool operator<(const ScheduledTimer& other) const { return endTime > other.endTime; }
+	};
+
+	struct Schedule {
+		std::vector<ScheduledTimer> heap;
+		u32 removedCount = 0; // Entries in heap whose timer was removed before ending.
+		f64 lastUpdateTime = 0.0; // Clock time of the last Update, for percentages.
+	};
 
 	// Member variables
-	std::vector <Timer> timers; // Vector to store a list of timers.
-	std::unordered_map<std::string, size_t> timerMap;  // Name -> index mapping to vector.
-	std::unordered_map<u32, size_t> anonymousTimerMap; // For anonymous timers
-	f64 elapsedTime = 0.0f; // Total elapsed time in seconds.
+	ObjectPool<Timer> timers; // Every timer, named or anonymous.
+	Schedule schedules[Timer::CLOCK_COUNT];
+
+	std::vector<std::string> names; // Name ID -> name
+	std::unordered_map<std::string, TimerNameId> nameIds; // Name -> name ID
+	std::vector<TimerHandle> namedTimers; // Name ID -> timer. Invalid handle if there's no timer with that name.
+
 	int activeTimerCount = 0; // Count of active timers.
-	u32 nextTimerId = 1; // Auto-incrementing ID for anonymous timers
 
-	// Checks for completed timers and handles them.
-	void CheckTimerCompletion();
+	// Creates and schedules a timer.
+	TimerHandle CreateTimer(TimerNameId nameId, f64 duration, bool autoRemove,
+		bool ignoreTimeScale, bool ignorePause, bool loopable, u32 loopCount);
+
+	// Releases the timer and leaves its heap entry to be skipped.
+	void DestroyTimer(TimerHandle handle);
+
+	// Pops and handles the timers of 1 clock that ended.
+	void CheckTimerCompletion(Timer::Clock clock);
+
+	// Rebuilds the heap without removed timers once they're most of it.
+	void CompactSchedule(Schedule& schedule);
 
 	// Helper to get appropriate time for timer.
-	f64 GetTimeForTimer(const Timer& timer) const;
+	static f64 GetClockTime(Timer::Clock clock);
 };
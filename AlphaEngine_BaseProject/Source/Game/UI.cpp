@@ -1,6 +1,8 @@
 #include "UI.h"
 #include "../Utils/ObjectPool.h"
 #include <string>
+#include <cstring>
+#include <cstdio>
 #include "../Game/BuffCards.h"
 #include "../Utils/AEExtras.h"
 #include "Player/Player.h"
@@ -8,6 +10,7 @@
 #include "../Game/Time.h"
 #include "../Game/Timer.h"
 #include "../Game/GameOver.h"
+#include "../Utils/MemoryTracker.h"
 #include <iostream>
 #include "../Game/AudioManager.h"
 #include "../Game/enemy/BossIntroOverlay.h"
@@ -23,12 +26,18 @@ namespace {
 		sprintf_s(buffer, "%02d:%02d:%02d", minutes, seconds, milliseconds);
 		return std::string(buffer);
 	}
+
+	TimerNameId GetDeathAnimTimerName() {
+		static TimerNameId name = TimerSystem::GetInstance().InternName("DeathAnim");
+		return name;
+	}
 }
 
 /*--------------------------------------------
 			 General UI Functions
 ---------------------------------------------*/
 void UI::Init(Player* _player) {
+	MEMORY_SCOPE(UI);
 	damageTextFont = AEGfxCreateFont("Assets/m04.ttf", DAMAGE_TEXT_FONT_SIZE);
 	gameOverFont = AEGfxCreateFont("Assets/Pixellari.ttf", GAME_OVER_TEXT_SIZE);
 	healthVignette = AEGfxTextureLoad("Assets/Art/Health_Vignette.png");
@@ -41,6 +50,7 @@ void UI::Init(Player* _player) {
 	BossIntroOverlay::Init();
 }
 void UI::Update() {
+	MEMORY_SCOPE(UI);
 	BuffCardManager::Update();
 	BuffCardScreen::Update();
 
@@ -58,6 +68,7 @@ void UI::Update() {
 	}
 }
 void UI::Render() {
+	MEMORY_SCOPE(UI);
 	DrawPlayerCooldownMeter();
 	DrawHealthVignette();
 	damageTextSpawner.Render();
@@ -221,16 +232,16 @@ void UI::UpdateGameOverStatus() {
 		ResetEyelid();
 		return;
 	}
-	if (deadTimerAdded && !TimerSystem::GetInstance().GetTimerByName("DeathAnim")) {
+	if (deadTimerAdded && !TimerSystem::GetInstance().GetTimerByName(GetDeathAnimTimerName())) {
 		deadTimerAdded = false;
 	}
 	if (!deadTimerAdded) {
-		TimerSystem::GetInstance().AddTimer("DeathAnim", 2.5f, false);
+		TimerSystem::GetInstance().AddTimer(GetDeathAnimTimerName(), 2.5f, false);
 		deadTimerAdded = true;
 		ResetEyelid();
 		
 	}
-	auto* timer = TimerSystem::GetInstance().GetTimerByName("DeathAnim");
+	auto* timer = TimerSystem::GetInstance().GetTimerByName(GetDeathAnimTimerName());
 
 	if (timer && timer->completed) {
 		UpdateEyelid(static_cast<float>(Time::GetInstance().GetDeltaTime()));
@@ -346,14 +357,6 @@ void UI::DrawGameOverText() {
 /*--------------------------------------
 		  Damage Text Functions
 ---------------------------------------*/
-void DamageText::Init() {}
-void DamageText::OnGet() {
-	neutralTime = 0.35f; // Neutral state of damage numbers before effects.
-	lifetime = 0.75f; // Lifetime of text with effects.
-	maxLifetime = lifetime; // Maximum lifetime for percentage computation.
-}
-void DamageText::OnRelease() {}
-void DamageText::Exit() {}
 void DamageText::Render()
 {
 	// Get window dimensions
@@ -362,8 +365,8 @@ void DamageText::Render()
 
 	// Calculate text width in pixels (approximate)
 	// Each character is roughly fontsize * 0.6 pixels wide
-	f32 numberPixelWidth = damageNumber.length() * UI::GetDamageTextFontSize() * 0.6f;
-	f32 typePixelWidth = damageType.length() * UI::GetDamageTextFontSize() * 0.6f;
+	f32 numberPixelWidth = strlen(damageNumber) * UI::GetDamageTextFontSize() * 0.6f;
+	f32 typePixelWidth = strlen(damageType) * UI::GetDamageTextFontSize() * 0.6f;
 
 	// Convert pixel offset to normalized coordinates [-1, 1]
 	// Divide by window width and multiply by 2 (since range is -1 to 1, total span of 2)
@@ -381,14 +384,14 @@ void DamageText::Render()
 
 	// Print Damage Type.
 	AEGfxPrint(font,
-		damageType.c_str(),
+		damageType,
 		viewportPos.x - typeOffsetX * 0.5f,
 		viewportPos.y + verticalSpacing * 0.5f,
 		scale,
 		r, g, b, alpha);
 	// Print Damage Number.
 	AEGfxPrint(font,
-		damageNumber.c_str(),
+		damageNumber,
 		viewportPos.x - numberOffsetX * 0.5f,
 		viewportPos.y - verticalSpacing * 0.5f,
 		scale,
@@ -404,7 +407,7 @@ void DamageTextSpawner::Update()
 {
 	for (int i = static_cast<int>(damageTextPool.GetSize()) - 1; i >= 0; --i)
 	{
-		DamageText& text = damageTextPool.pool[i];
+		DamageText& text = damageTextPool.At(i);
 
 		text.position.x += text.velocity.x * static_cast<f32>(Time::GetInstance().GetScaledDeltaTime());
 		text.position.y += text.velocity.y * static_cast<f32>(Time::GetInstance().GetScaledDeltaTime());
@@ -416,23 +419,23 @@ void DamageTextSpawner::Update()
 
 		text.velocity.x *= 0.95f; // Slight slow in movement
 
-		text.neutralTime -= AEFrameRateControllerGetFrameTime();
+		text.neutralTime -= Time::GetInstance().GetDeltaTime();
 		if (text.neutralTime <= 0.f) {
-			text.lifetime -= AEFrameRateControllerGetFrameTime();
+			text.lifetime -= Time::GetInstance().GetDeltaTime();
 			f32 lifeRatio = static_cast<f32>(text.lifetime / text.maxLifetime);
 			text.alpha = lifeRatio;
 			text.scale = text.initialScale * lifeRatio;
 		}
 		if (text.lifetime <= 0.f)
 		{
-			damageTextPool.Release(text);
+			damageTextPool.Release(damageTextPool.GetHandle(i));
 		}
 	}
 }
 void DamageTextSpawner::Render() {
-	for (size_t i = 0; i < damageTextPool.GetSize(); ++i)
+	for (DamageText& text : damageTextPool)
 	{
-		damageTextPool.pool[i].Render();
+		text.Render();
 	}
 }
 void DamageTextSpawner::SpawnDamageText(int damage, DAMAGE_TYPE type, const AEVec2& position, const AEVec2& velocity) {
@@ -459,8 +462,8 @@ void DamageTextSpawner::SpawnDamageText(int damage, DAMAGE_TYPE type, const AEVe
 	float speed = static_cast<float>(AEExtras::RandomRange({ 5, 10 })); // Variation in dmg text speed.
 
 
-	DamageText& text = damageTextPool.Get();
-	text.damageNumber = std::to_string(damage);
+	DamageText& text = *damageTextPool.Find(damageTextPool.Get()); // Constructed with the default lifetimes
+	snprintf(text.damageNumber, sizeof(text.damageNumber), "%d", damage);
 	text.damageType = "";
 	AEVec2 damageRange = { 1, 100 };
 	AEVec2 scaleRange{};
@@ -496,7 +499,7 @@ void DamageTextSpawner::SpawnDamageText(int damage, DAMAGE_TYPE type, const AEVe
 			text.r = 0.85f, text.g = 0.85f, text.b = 0.85f;
 			text.scale = 0.75f;
 			text.damageType = "MISS!";
-			text.damageNumber = "";
+			text.damageNumber[0] = '\0';
 			break;
 		case DAMAGE_TYPE_ENEMY_ATTACK:
 			text.r = 1.0f, text.g = 0.2f, text.b = 0.85f;
@@ -508,14 +511,13 @@ void DamageTextSpawner::SpawnDamageText(int damage, DAMAGE_TYPE type, const AEVe
 			text.r = 0.8f, text.g = 0.35f, text.b = 0.65f;
 			text.scale = 0.75f;
 			text.damageType = "MISS!";
-			text.damageNumber = "";
+			text.damageNumber[0] = '\0';
 			break;
 	}
 	text.velocity = { direction.x * speed, direction.y * speed * 1.25f }; // Add a multiplier to y so it rises up more.
 	text.initialScale = text.scale;
 	text.position = position;
 	text.alpha = 1.0f;
-	text.OnGet();
 }
 /*--------------------------------------
 		  Boss Intro functions
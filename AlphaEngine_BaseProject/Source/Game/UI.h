@@ -4,21 +4,17 @@
 #include "../Utils/ObjectPool.h"
 #include "Player/Player.h"
 #include "../CommonTypes.h"
-struct DamageText : public ObjectPoolItem {
-	std::string damageType{}; // Type of damage to be printed. Crit, resist, normal etc.
-	std::string damageNumber{}; // Numerical value of damage to be printed.
+struct DamageText {
+	const char* damageType{ "" }; // Type of damage to be printed. Crit, resist, normal etc. Points to a string literal.
+	char damageNumber[12]{}; // Numerical value of damage to be printed. Fixed size so spawning doesn't allocate.
 	f32 r{}, g{}, b{}; // RGB values of text.
 	AEVec2 position{}; // Position of text.
 	AEVec2 velocity{}; // Velocity of the text.
 	f32 alpha{}, scale{}, initialScale{}; // Alpha and scale values of text.
-	f64 lifetime{}; // Lifetime of text, excluding neutral time.
-	f64 maxLifetime{}; // Maximum lifetime of text to compute percentage of completion.
-	f64 neutralTime{}; // Neutral time of the text before effects (scaling down and fading out).
+	f64 lifetime{ 0.75 }; // Lifetime of text, excluding neutral time.
+	f64 maxLifetime{ lifetime }; // Maximum lifetime of text to compute percentage of completion.
+	f64 neutralTime{ 0.35 }; // Neutral time of the text before effects (scaling down and fading out).
 
-	virtual void Init() override;
-	virtual void OnGet() override;
-	virtual void OnRelease() override;
-	virtual void Exit() override;
 	void Render();
 };
 
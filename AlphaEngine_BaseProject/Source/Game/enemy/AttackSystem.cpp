@@ -3,9 +3,12 @@
 #include "../enemy/Enemy.h"
 #include "../enemy/EnemyBoss.h"
 #include "../Player/Player.h"
+#include "../Time.h"
 #include "../../Utils/PhysicsUtils.h"
 #include <utility>
 #include "../../Utils/QuickGraphics.h"
+#include "../../Utils/Renderer.h"
+#include "../../Utils/MemoryTracker.h"
 
 
 //HELPERS
@@ -18,17 +21,16 @@ static float GetAnimDurationSec(const Sprite& sprite, int stateIndex)
     return static_cast<float>(s.frameCount) * static_cast<float>(s.timePerFrame);
 }
 
-static bool FindGroundBelowPlayer(MapGrid& map, float x, float startY, float minY, float step, float& outGroundY)
+// outGroundY = top of the first solid tile within maxDist below (x, startY)
+static bool FindGroundBelowPlayer(MapGrid& map, float x, float startY, float maxDist, float& outGroundY)
 {
-    for (float y = startY; y >= minY; y -= step)
-    {
-        if (map.CheckPointCollision(x, y))
-        {
-            outGroundY = y;
-            return true;
-        }
-    }
-    return false;
+    // Raycast returns the ray length if nothing was hit
+    const float dist = map.Raycast({ x, startY }, { x, startY - maxDist });
+    if (dist >= maxDist)
+        return false;
+
+    outGroundY = startY - dist;
+    return true;
 }
 
 
@@ -36,6 +38,7 @@ static bool FindGroundBelowPlayer(MapGrid& map, float x, float startY, float min
 
 void AttackSystem::UpdateEnemyAttack(Player& player, EnemyManager& enemies, EnemyBoss* boss, MapGrid& map)
 {
+	MEMORY_SCOPE(Enemies);
 	ApplyEnemyAttacksToPlayer(player, enemies, boss, map);
     Render();
 
@@ -44,7 +47,7 @@ void AttackSystem::UpdateEnemyAttack(Player& player, EnemyManager& enemies, Enem
 // This is the main function that applies all enemy attacks to the player each frame.
 void AttackSystem::ApplyEnemyAttacksToPlayer(Player& player, EnemyManager& enemies, EnemyBoss* boss, MapGrid& map)
 {
-    const float dt = (float)AEFrameRateControllerGetFrameTime();
+    const float dt = static_cast<float>(Time::GetInstance().GetDeltaTime());
 
     const AEVec2 pPos = player.GetPosition();
     const AEVec2 pSize = player.GetStats().playerSize;
@@ -65,6 +68,13 @@ void AttackSystem::ApplyEnemyAttacksToPlayer(Player& player, EnemyManager& enemi
         }
     }
 
+    // Keep the sprites of expired hitboxes for the next spell
+    for (auto& hb : enemyHitboxes)
+    {
+        if (hb.lifetime <= 0.f && hb.sprite)
+            freeSpellSprites.push_back(std::move(hb.sprite));
+    }
+
     enemyHitboxes.erase(
         std::remove_if(enemyHitboxes.begin(), enemyHitboxes.end(),
             [](const EnemySpawnedHitbox& hb)
@@ -74,6 +84,11 @@ void AttackSystem::ApplyEnemyAttacksToPlayer(Player& player, EnemyManager& enemi
         enemyHitboxes.end()
     );
 
+    // Ground below the player for druid spells. Every druid targets the player,
+    // so only cast once even if multiple druids attack this frame
+    bool isGroundProbed = false, hasGround = false;
+    float groundY = 0.0f;
+
     // 2) Process enemy hit events
     enemies.ForEachEnemy([&](Enemy& e)
         {
@@ -86,13 +101,17 @@ void AttackSystem::ApplyEnemyAttacksToPlayer(Player& player, EnemyManager& enemi
                 hb.position.x = pPos.x;
                 hb.faceRight = (pPos.x >= e.GetPosition().x);
 
-                float groundY = 0.0f;
+                if (!isGroundProbed)
+                {
+                    // start search from player's feet
+                    const float feetY = pPos.y - (pSize.y * 0.5f);
 
-                // start search from player's feet
-                const float feetY = pPos.y - (pSize.y * 0.5f);
+                    // search downward for solid ground
+                    hasGround = FindGroundBelowPlayer(map, pPos.x, feetY, 5.0f, groundY);
+                    isGroundProbed = true;
+                }
 
-                // search downward for solid ground
-                if (FindGroundBelowPlayer(map, pPos.x, feetY, feetY - 5.0f, 0.1f, groundY))
+                if (hasGround)
                 {
                     // place spell on top of ground
                     hb.position.y = groundY + (hb.size.y * 0.5f);
@@ -106,12 +125,18 @@ void AttackSystem::ApplyEnemyAttacksToPlayer(Player& player, EnemyManager& enemi
                 hb.damage = e.GetAttackDamage();
                 hb.alreadyHit = false;
 
-                hb.sprite = std::make_unique<Sprite>("Assets/Craftpix/DruidEarth.png");
                 constexpr int SPELL_STATE = 0;
+                if (freeSpellSprites.empty())
+                    hb.sprite = std::make_unique<Sprite>("Assets/Craftpix/DruidEarth.png");
+                else
+                {
+                    hb.sprite = std::move(freeSpellSprites.back());
+                    freeSpellSprites.pop_back();
+                }
 
                 if (hb.sprite && SPELL_STATE >= 0 && SPELL_STATE < hb.sprite->metadata.rows)
                 {
-                    hb.sprite->SetState(SPELL_STATE, false, nullptr);
+                    hb.sprite->Restart(SPELL_STATE);
                     hb.lifetime = GetAnimDurationSec(*hb.sprite, SPELL_STATE);
                     if (hb.lifetime <= 0.f)
                         hb.lifetime = 0.5f;
@@ -171,10 +196,6 @@ void AttackSystem::ApplyEnemyAttacksToPlayer(Player& player, EnemyManager& enemi
 
 void AttackSystem::Render()
 {
-    AEMtx33 world;
-    AEMtx33Scale(&world, Camera::scale, Camera::scale);
-    AEGfxSetTransform(world.m);
-
     for (auto& hb : enemyHitboxes)
     {
         // draw sprite if present
@@ -189,30 +210,32 @@ void AttackSystem::Render()
                 hb.position.y - (- hb.sprite->metadata.pivot.y)
             );
             AEMtx33ScaleApply(&m, &m, Camera::scale, Camera::scale);
-            AEGfxSetTransform(m.m);
-
-            hb.sprite->Render();
 
-            // restore world transform before drawing debug rect
-            AEGfxSetTransform(world.m);
+            hb.sprite->Render(m);
         }
-        // debug rect
-        if (debug)
-        {
-            QuickGraphics::DrawRect(
-                hb.position.x, hb.position.y,
-                hb.size.x, hb.size.y,
-                0xFFFFFF00, // yellow
-                AE_GFX_MDM_LINES_STRIP
-            );
+    }
 
-            // optional center marker
-            QuickGraphics::DrawRect(
-                hb.position.x, hb.position.y,
-                0.05f, 0.05f,
-                0xFFFF0000,
-                AE_GFX_MDM_LINES_STRIP
-            );
-        }
+    // Before the debug rects so they're on top
+    Renderer::Flush();
+
+    if (!debug)
+        return;
+
+    for (auto& hb : enemyHitboxes)
+    {
+        QuickGraphics::DrawRect(
+            hb.position.x, hb.position.y,
+            hb.size.x, hb.size.y,
+            0xFFFFFF00, // yellow
+            AE_GFX_MDM_LINES_STRIP
+        );
+
+        // optional center marker
+        QuickGraphics::DrawRect(
+            hb.position.x, hb.position.y,
+            0.05f, 0.05f,
+            0xFFFF0000,
+            AE_GFX_MDM_LINES_STRIP
+        );
     }
 }
\ No newline at end of file
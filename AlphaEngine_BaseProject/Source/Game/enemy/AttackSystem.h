@@ -36,6 +36,8 @@ private:
     };
 
     std::vector<EnemySpawnedHitbox> enemyHitboxes;
+    // Sprites of expired hitboxes, reused by the next spell instead of allocating a new one
+    std::vector<std::unique_ptr<Sprite>> freeSpellSprites;
     bool debug = false;
 
    
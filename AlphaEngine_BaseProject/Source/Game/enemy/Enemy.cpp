@@ -2,7 +2,10 @@
 
 #include <cmath>
 #include "../../Utils/QuickGraphics.h"
+#include "../../Utils/Renderer.h"
 #include "../Camera.h"
+#include "../Time.h"
+#include "../../Utils/AEExtras.h"
 #include <imgui.h>
 #include "../UI.h"
 #include "../Environment/MapGrid.h"
@@ -19,36 +22,6 @@ float Enemy::GetAnimDurationSec(const Sprite& sprite, int stateIndex)
 }
 
 
-bool Enemy::HasGroundAhead(MapGrid& map, float dirX) const
-{
-    const AEVec2 hbPos = GetHurtboxPos();   // center
-    const AEVec2 hbSize = GetHurtboxSize();  // full size
-
-    const float eps = 0.05f;
-
-    // Probe a point just in front of the feet
-    const float probeX = hbPos.x + dirX * (hbSize.x * 0.5f + eps);
-    const float probeY = hbPos.y - hbSize.y * 0.5f - eps;
-
-    // MapGrid already treats "not NONE" as solid
-    return map.CheckPointCollision(probeX, probeY);
-}
-
-bool Enemy::HasWallAhead(MapGrid& map, float dirX) const
-{
-    const AEVec2 hbPos = GetHurtboxPos();    // center
-    const AEVec2 hbSize = GetHurtboxSize();  // full size
-
-    const float eps = 0.05f;
-
-    // check just in front of the body
-    const float probeX = hbPos.x + dirX * (hbSize.x * 0.5f + eps);
-    const float probeY = hbPos.y; // middle height
-
-    return map.CheckPointCollision(probeX, probeY);
-}
-
-
 Enemy::Config Enemy::MakePreset(Preset preset)
 {
     Config c{};
@@ -96,31 +69,44 @@ Enemy::Config Enemy::MakePreset(Preset preset)
 }
 
 // ---- Ctors ----
-Enemy::Enemy(Preset preset, float initialPosX, float initialPosY)
-    : Enemy(MakePreset(preset), initialPosX, initialPosY)
+Enemy::Enemy(EnemyTable& tableRef, Preset preset, float initialPosX, float initialPosY)
+    : Enemy(tableRef, MakePreset(preset), initialPosX, initialPosY)
 {
      presetType = preset;
 }
 
-Enemy::Enemy(const Config& cfgIn, float initialPosX, float initialPosY)
-    : cfg(cfgIn)
+Enemy::Enemy(EnemyTable& tableRef, const Config& cfg, float initialPosX, float initialPosY)
+    : table(tableRef)
     , sprite(cfg.spritePath)
 {
-    position = AEVec2{ initialPosX, initialPosY };
-    homePos = position;
-    velocity = AEVec2{ 0.f, 0.f };
+    Transform transform;
+    transform.position = AEVec2{ initialPosX, initialPosY };
+    transform.size = AEVec2{ 0.8f, 0.8f };
+    transform.previousPosition = transform.position;
 
-    size = AEVec2{ 0.8f, 0.8f };
-    facingDirection = AEVec2{ 1.f, 0.f };
-    chasing = false;
+    EnemyBrain brain;
+    brain.homePos = transform.position;
 
     // Attack component setup (same as your old EnemyA/B)
+    EnemyAttack attack;
     attack.startRange = cfg.attackStartRange;
     attack.hitRange = cfg.attackHitRange;
     attack.cooldown = cfg.attackCooldown;
     attack.hitTimeNormalized = cfg.attackHitTimeNormalized;
     attack.breakRange = cfg.attackBreakRange;
 
+    //enemy life system
+    Health health;
+    health.maxHp = cfg.maxHp;
+    health.hp = cfg.maxHp;
+    health.dead = false;
+
+    EnemyAnimation animation;
+    animation.attackDuration = GetAnimDurationSec(sprite, cfg.animAttack);
+    animation.deathTimePerFrame = sprite.metadata.stateInfoRows[cfg.animDeath].timePerFrame;
+
+    entity = table.Create(transform, Motion{}, health, brain, attack, cfg, animation, this);
+
 	//enemy particle system setup
     particleSystem.Init();
     particleSystem.SetSpawnRate(0.f); // IMPORTANT: no continuous spawning by default
@@ -132,378 +118,91 @@ Enemy::Enemy(const Config& cfgIn, float initialPosX, float initialPosY)
 
 
     particleSystem.emitter.tint = { 0.8f, 0.8f, 0.8f, 1.f };
-
-    //enemy life system
-    hp = cfg.maxHp;
-    dead = false;
-
 }
 
-// ---- Update ----
-void Enemy::Update(const AEVec2& playerPos, MapGrid& map)
+Enemy::~Enemy()
 {
+    table.Destroy(entity);
+}
 
+// ---- Visuals ----
+void Enemy::UpdateVisuals(const EnemyAnimation& animation, const Transform& transform, const Motion& motion)
+{
+    if (animation.nextState != EnemyAnimation::KEEP_STATE)
+        sprite.SetState(animation.nextState);
 
-
-    const float dt = (float)AEFrameRateControllerGetFrameTime();
-    auto UpdateEnemyParticles = [&]()
-        {
-            // Trail only when moving; still updates existing particles either way
-            const float speed = std::fabs(velocity.x);
-
-            // If your system treats 0 as "no spawn", this is fine
-            particleSystem.SetSpawnRate(speed > 0.1f ? 30.f : 0.f);
-
-            const float trailLen = 0.5f;     // how far behind to spawn
-            const float x = position.x + 0.5f;
-
-            // decide facing: if moving use velocity, else use facingDirection
-            const bool faceRight =
-                (velocity.x != 0.f) ? (velocity.x > 0.f) : (facingDirection.x > 0.f);
-
-            
-
-            if (faceRight)
-            {
-                // moving right 
-                AEVec2Set(&particleSystem.emitter.spawnPosRangeX, x, x - trailLen);
-            }
-            else
-            {
-                // moving left 
-                AEVec2Set(&particleSystem.emitter.spawnPosRangeX, x, x + trailLen);
-            }
-            AEVec2Set(&particleSystem.emitter.spawnPosRangeY, position.y + 0.2f, position.y + 0.8f);
-
-            particleSystem.Update();
-        };
-    if (dead)
-    {
-        // Advance animation until the final frame starts, then stop updating so it doesn't loop.
-        if (deathTimeLeft > 0.f)
-        {
-            float tpf = sprite.metadata.stateInfoRows[cfg.animDeath].timePerFrame;
-            if (tpf <= 0.f) tpf = 0.1f;
-
-            // Only update while we're not yet in the "last frame window"
-            if (deathTimeLeft > tpf)
-                sprite.Update();
-
-            deathTimeLeft -= dt;
-            if (deathTimeLeft < 0.f) deathTimeLeft = 0.f;
-        }
-        if (deathTimeLeft <= 0.f && cfg.hideAfterDeath)
-            hidden = true;
-
-        return;
-    }
-
-    // Hurt lock: keep the HURT row visible long enough to notice (play full row once)
-    if (hurtTimeLeft > 0.f)
-    {
-        hurtTimeLeft -= dt;
-
-        // While hurt, stop attacking / moving and just play the hurt animation
-        attack.Reset();
-        velocity = AEVec2{ 0.f, 0.f };
-        chasing = false;
-
-        // Force hurt state while timer is active (prevents any override)
-        sprite.SetState(cfg.animHurt);
-
- 
+    if (animation.play)
         sprite.Update();
-        return;
-    }
-
-    const float desiredStopDist =
-        (attack.startRange > 0.05f) ? (attack.startRange - 0.05f) : attack.startRange;
 
-    const float dx = playerPos.x - position.x;
-    const float absDx = std::fabs(dx);
+    if (!animation.emitParticles)
+        return;
 
-    const float dy = std::fabs(playerPos.y - position.y);
-    const bool yAggroOk = (dy <= cfg.aggroYRange);
-    const bool yAttackOk = (dy <= cfg.attackYRange);
+    // Trail only when moving; still updates existing particles either way
+    const float speed = std::fabs(motion.velocity.x);
 
-    // --- Guard/leash ---
-    const float playerFromHome = std::fabs(playerPos.x - homePos.x);
-    const float enemyFromHome = std::fabs(position.x - homePos.x);
+    // If your system treats 0 as "no spawn", this is fine
+    particleSystem.SetSpawnRate(speed > 0.1f ? 30.f : 0.f);
 
-    const bool inAggroRange = (absDx <= cfg.aggroRange) && yAggroOk;
+    const float trailLen = 0.5f;     // how far behind to spawn
+    const float x = transform.position.x + 0.5f;
 
-    // Hysteresis so we don't spam switch at the boundary
-    const float leashEnter = cfg.leashRange + 0.01f;  // when to START returning
-    const float leashExit = cfg.leashRange - 0.25f;  // when returning can be CANCELLED
+    // decide facing: if moving use velocity, else use facingDirection
+    const bool faceRight =
+        (motion.velocity.x != 0.f) ? (motion.velocity.x > 0.f) : (motion.facing.x > 0.f);
 
-    if (inAggroRange)
-        hadAggro = true;
+    
 
-     
-    if (!returningHome)
+    if (faceRight)
     {
-        //  Always return home if walked out of leash
-        if (enemyFromHome > leashEnter)
-            returningHome = true;
-
-        // Only consider playerFromHome when we are actually engaged
-        // (prevents "player far away" from freezing idle wandering)
-        if (inAggroRange && playerFromHome > leashEnter)
-            returningHome = true;
-
-        // If we were engaged and now lost aggro , than enemy will go home first
-        if (!inAggroRange && hadAggro)
-            returningHome = true;
+        // moving right 
+        AEVec2Set(&particleSystem.emitter.spawnPosRangeX, x, x - trailLen);
     }
     else
     {
-        // Cancel returning only if player is back in range and both are within leash
-        if (inAggroRange && playerFromHome <= cfg.leashRange && enemyFromHome <= leashExit)
-            returningHome = false;
-    }
-
-    //verical checck
-    const float attackDur = GetAnimDurationSec(sprite, cfg.animAttack);
-    const float effectiveDist = yAttackOk ? absDx : 9999.0f;
-  
-    if (returningHome)
-    {
-        // Allow attacks while returning home (no chasing)
-        if (inAggroRange)
-        {
-            if (dx != 0.f)
-                facingDirection = AEVec2{ (dx > 0.f) ? 1.f : -1.f, 0.f };
-
-           
-           
-            attack.Update(dt, effectiveDist, attackDur);
-
-            if (attack.IsAttacking())
-            {
-                velocity = AEVec2{ 0.f, 0.f };
-                UpdateAnimation();
-                sprite.Update();
-                return;
-            }
-        }
-        else
-        {
-            attack.Reset();
-        }
-
-        chasing = false;
-
-        const float eps = 0.05f;
-        const float dh = homePos.x - position.x;
-        const float absDh = std::fabs(dh);
-
-        velocity.y = 0.f;
-
-        if (absDh <= eps)
-        {
-            position.x = homePos.x;
-            velocity.x = 0.f;
-            returningHome = false;
-
-            hadAggro = false;    
-            idleWalkLeft = 0.f;
-            idlePauseLeft = 0.2f;
-        }
-        else
-        {
-            const float dirX = (dh > 0.f) ? 1.f : -1.f;
-            facingDirection = AEVec2{ dirX, 0.f };
-            velocity.x = dirX * cfg.moveSpeed;
-
-            AEVec2 displacement;
-            AEVec2Scale(&displacement, &velocity, dt);
-
-            AEVec2 nextPos = position;
-            AEVec2Add(&nextPos, &position, &displacement);
-
-            if (dirX > 0.f && nextPos.x > homePos.x) { nextPos.x = homePos.x; velocity.x = 0.f; }
-            if (dirX < 0.f && nextPos.x < homePos.x) { nextPos.x = homePos.x; velocity.x = 0.f; }
-
-            if (!HasGroundAhead(map, dirX) || HasWallAhead(map, dirX))
-            {
-                nextPos.x = position.x;
-                velocity.x = 0.f;
-            }
-            position = nextPos;
-        }
-
-        UpdateAnimation();
-        sprite.Update();
-        UpdateEnemyParticles();
-        return;
+        // moving left 
+        AEVec2Set(&particleSystem.emitter.spawnPosRangeX, x, x + trailLen);
     }
+    AEVec2Set(&particleSystem.emitter.spawnPosRangeY, transform.position.y + 0.2f, transform.position.y + 0.8f);
 
-    // Update attack component (needs attack anim duration)
-    attack.Update(dt, effectiveDist, attackDur);
-
-    // If attacking, stop movement
-    if (attack.IsAttacking())
-    {
-        velocity.x = 0.f;
-        velocity.y = 0.f;
-        chasing = false;
-    }
-    else
-    {
-        if (inAggroRange)
-        {
-            chasing = (absDx > desiredStopDist);
-
-            if (dx != 0.f)
-                facingDirection = AEVec2{ (dx > 0.f) ? 1.f : -1.f, 0.f };
-
-            if (chasing)
-            {
-                const float dirX = (dx > 0.f) ? 1.f : -1.f;
-                velocity.x = dirX * cfg.moveSpeed;
-            }
-            else
-            {
-                velocity.x = 0.f;
-            }
-
-            velocity.y = 0.f;
-
-            AEVec2 displacement;
-            AEVec2Scale(&displacement, &velocity, dt);
-            AEVec2 nextPos = position;
-            AEVec2Add(&nextPos, &position, &displacement);
-
-            if (chasing)
-            {
-                const float dirX = (dx > 0.f) ? 1.f : -1.f;
-                if (!HasGroundAhead(map, dirX) || HasWallAhead(map, dirX))
-                {
-                    nextPos.x = position.x;
-                    velocity.x = 0.f;
-                    chasing = false;
-                }
-                const float targetX = playerPos.x - dirX * desiredStopDist;
-
-                if (dirX > 0.f && nextPos.x > targetX) { nextPos.x = targetX; velocity.x = 0.f; }
-                if (dirX < 0.f && nextPos.x < targetX) { nextPos.x = targetX; velocity.x = 0.f; }
-            }
-
-            const float minX = homePos.x - cfg.leashRange;
-            const float maxX = homePos.x + cfg.leashRange;
-
-            if (nextPos.x < minX) { nextPos.x = minX; velocity.x = 0.f; }
-            if (nextPos.x > maxX) { nextPos.x = maxX; velocity.x = 0.f; }
-
-            position = nextPos;
-
-        }
-        else
-        {
-            chasing = false;
-            velocity.y = 0.f;
-
-            const float minX = homePos.x - cfg.leashRange;
-            const float maxX = homePos.x + cfg.leashRange;
-
-            // Pause phase
-            if (idlePauseLeft > 0.f)
-            {
-                idlePauseLeft -= dt;
-                velocity.x = 0.f;
-            }
-            else
-            {
-                // Choose / refresh a walk segment
-                if (idleWalkLeft <= 0.f)
-                {
-                    idleWalkLeft = 1.2f;           // how long to walk before pausing (tune)
-                    idlePauseLeft = 0.25f;         // pause after walk (tune)
-                    idleDirX = -idleDirX;          // simple back-and-forth
-                }
-
-                const float dirX = (idleDirX >= 0.f) ? 1.f : -1.f;
-                facingDirection = AEVec2{ dirX, 0.f };
-
-                // slower than chase looks more natural
-                velocity.x = dirX * cfg.moveSpeed * 0.35f;
-
-                AEVec2 displacement;
-                AEVec2Scale(&displacement, &velocity, dt);
-
-                AEVec2 nextPos = position;
-                AEVec2Add(&nextPos, &position, &displacement);
-
-                // Don’t walk off ledges
-                if (!HasGroundAhead(map, dirX) || HasWallAhead(map, dirX))
-                {
-                    nextPos.x = position.x;
-                    velocity.x = 0.f;
-                    idleDirX = -idleDirX;
-                    facingDirection = AEVec2{ idleDirX >= 0.f ? 1.f : -1.f, 0.f };
-                    idleWalkLeft = 0.f;
-                    idlePauseLeft = 0.35f;
-                }
-
-                // Clamp to leash range
-                if (nextPos.x < minX)
-                {
-                    nextPos.x = minX;
-                    velocity.x = 0.f;
-                    idleDirX = 1.f;
-                    idleWalkLeft = 0.f;
-                    idlePauseLeft = 0.35f;
-                }
-                else if (nextPos.x > maxX)
-                {
-                    nextPos.x = maxX;
-                    velocity.x = 0.f;
-                    idleDirX = -1.f;
-                    idleWalkLeft = 0.f;
-                    idlePauseLeft = 0.35f;
-                }
-
-                position = nextPos;
-                idleWalkLeft -= dt;
-            }
-        }
-    }
-  
-    UpdateAnimation();
-    sprite.Update();
-    UpdateEnemyParticles();
+    particleSystem.Update();
 }
 
 bool Enemy::TryTakeDamage(int dmg, const AEVec2& hitOrigin, DAMAGE_TYPE type)
 {
-    if (dead || dmg <= 0 ) return false;
+    Health& health = GetComponent<Health>();
+    if (health.dead || dmg <= 0 ) return false;
 
     // --- The rest is your existing ApplyDamage logic ---
-    hp -= dmg;
+    health.hp -= dmg;
 
+    const AEVec2& position = GetPosition();
     UI::GetDamageTextSpawner().SpawnDamageText(dmg, type, position, position - hitOrigin);
 
-    if (hp <= 0)
+    const Config& cfg = GetComponent<Config>();
+    EnemyBrain& brain = GetComponent<EnemyBrain>();
+    EnemyAttack& attack = GetComponent<EnemyAttack>();
+
+    if (health.hp <= 0)
     {
-        hp = 0;
-        dead = true;
-        hidden = false;
+        health.hp = 0;
+        health.dead = true;
+        brain.hidden = false;
 
         attack.Reset();
-        chasing = false;
-        returningHome = false;
-        velocity = AEVec2{ 0.f, 0.f };
-
-        sprite.SetState(cfg.animDeath, false, nullptr);
-        deathTimeLeft = GetAnimDurationSec(sprite, cfg.animDeath);
-        if (deathTimeLeft <= 0.f)
-            deathTimeLeft = 0.5f;
+        brain.chasing = false;
+        brain.returningHome = false;
+        GetComponent<Motion>().velocity = AEVec2{ 0.f, 0.f };
+
+        sprite.SetState(cfg.animDeath);
+        brain.deathTimeLeft = GetAnimDurationSec(sprite, cfg.animDeath);
+        if (brain.deathTimeLeft <= 0.f)
+            brain.deathTimeLeft = 0.5f;
     }
-    else if (hurtTimeLeft <= 0.f)
+    else if (brain.hurtTimeLeft <= 0.f)
     {
-        hurtTimeLeft = GetAnimDurationSec(sprite, cfg.animHurt);
-        if (hurtTimeLeft <= 0.3f)
-            hurtTimeLeft = 0.3f;
+        brain.hurtTimeLeft = GetAnimDurationSec(sprite, cfg.animHurt);
+        if (brain.hurtTimeLeft <= 0.3f)
+            brain.hurtTimeLeft = 0.3f;
 
         attack.Reset();
         sprite.SetState(cfg.animHurt);
@@ -518,50 +217,28 @@ bool Enemy::TryTakeDamage(int dmg, const AEVec2& hitOrigin, DAMAGE_TYPE type)
 }*/
 
 
-// ---- Animation selection ----
-void Enemy::UpdateAnimation()
-{
-    if (dead)
-    {
-       
-        return;
-    }
-
-    if (hurtTimeLeft > 0.f)
-    {
-        sprite.SetState(cfg.animHurt);
-        return;
-    }
-
-    if (attack.IsAttacking())
-    {
-        sprite.SetState(cfg.animAttack);
-        return;
-    }
-
-    if (std::fabs(velocity.x) > cfg.runVelThreshold)
-        sprite.SetState(cfg.animRun);
-    else
-        sprite.SetState(cfg.animIdle);
-}
-
-
 
 void Enemy::DrawInspector()
 {
     ImGui::Begin("Enemy", &isInspectorOpen);
 
+    Transform& transform = GetComponent<Transform>();
+    Motion& motion = GetComponent<Motion>();
+    Health& health = GetComponent<Health>();
+    EnemyBrain& brain = GetComponent<EnemyBrain>();
+    Config& cfg = GetComponent<Config>();
+
     if (ImGui::CollapsingHeader("Runtime"))
     {
-        ImGui::DragFloat2("Position", &position.x, 0.1f);
-        ImGui::DragFloat2("Velocity", &velocity.x, 0.1f);
-        ImGui::Checkbox("Chasing", &chasing);
-        ImGui::Checkbox("ReturningHome", &returningHome);
-        ImGui::Checkbox("Dead", &dead);
+        ImGui::DragFloat2("Position", &transform.position.x, 0.1f);
+        ImGui::DragFloat2("Velocity", &motion.velocity.x, 0.1f);
+        ImGui::Checkbox("Chasing", &brain.chasing);
+        ImGui::Checkbox("ReturningHome", &brain.returningHome);
+        ImGui::Checkbox("Dead", &health.dead);
 
         ImGui::SeparatorText("HP");
-        ImGui::SliderInt("HP", &hp, 0, cfg.maxHp);
-        ImGui::Text("MaxHP: %d", cfg.maxHp);
+        ImGui::SliderInt("HP", &health.hp, 0, health.maxHp);
+        ImGui::Text("MaxHP: %d", health.maxHp);
     }
 
     if (ImGui::CollapsingHeader("Config"))
@@ -584,20 +261,23 @@ void Enemy::DrawInspector()
 
 bool Enemy::CheckIfClicked(const AEVec2& mousePos)
 {
-    return fabsf(position.x - mousePos.x) < size.x &&
-    fabsf(position.y - mousePos.y) < size.y;
+    const Transform& transform = GetComponent<Transform>();
+    return fabsf(transform.position.x - mousePos.x) < transform.size.x &&
+    fabsf(transform.position.y - mousePos.y) < transform.size.y;
 
 }
 
 void Enemy::ApplyRoomScaling(int extraHp, int extraDamage)
 {
-    cfg.maxHp += extraHp;
-    if (cfg.maxHp < 1) cfg.maxHp = 1;
+    Health& health = GetComponent<Health>();
+    health.maxHp += extraHp;
+    if (health.maxHp < 1) health.maxHp = 1;
 
-    hp += extraHp;
-    if (hp > cfg.maxHp) hp = cfg.maxHp;
-    if (hp < 1) hp = 1;
+    health.hp += extraHp;
+    if (health.hp > health.maxHp) health.hp = health.maxHp;
+    if (health.hp < 1) health.hp = 1;
 
+    Config& cfg = GetComponent<Config>();
     cfg.attackDamage += extraDamage;
     if (cfg.attackDamage < 1) cfg.attackDamage = 1;
 }
@@ -605,14 +285,22 @@ void Enemy::ApplyRoomScaling(int extraHp, int extraDamage)
 // ---- Render ----
 void Enemy::Render()
 {
-    if (hidden) return;
+    if (GetComponent<EnemyBrain>().hidden) return;
 
     particleSystem.Render();
 
+    const Transform& transformComponent = GetComponent<Transform>();
+    const Motion& motion = GetComponent<Motion>();
+    const Config& cfg = GetComponent<Config>();
+
     AEMtx33 transform;
 
     const bool faceRight =
-        (velocity.x != 0.f) ? (velocity.x > 0.f) : (facingDirection.x > 0.f);
+        (motion.velocity.x != 0.f) ? (motion.velocity.x > 0.f) : (motion.facing.x > 0.f);
+
+    // Between the last 2 ticks' positions
+    const AEVec2 renderPosition = AEExtras::Lerp(
+        transformComponent.previousPosition, transformComponent.position, Time::GetInstance().GetInterpolationAlpha());
 
     // Scale (flip X if facing left)
     AEMtx33Scale(&transform, faceRight ? cfg.renderScale : -cfg.renderScale, cfg.renderScale);
@@ -621,24 +309,26 @@ void Enemy::Render()
     AEMtx33TransApply(
         &transform,
         &transform,
-        position.x - (0.5f - sprite.metadata.pivot.x),
-        position.y - (0 - sprite.metadata.pivot.y)
+        renderPosition.x - (0.5f - sprite.metadata.pivot.x),
+        renderPosition.y - (0 - sprite.metadata.pivot.y)
     );
 
     // Camera scale
     AEMtx33ScaleApply(&transform, &transform, Camera::scale, Camera::scale);
-    AEGfxSetTransform(transform.m);
 
-    sprite.Render();
+    sprite.Render(transform);
 
   
 
     if (debugDraw)
 
     {
+        // On top of the sprite
+        Renderer::Flush();
+
         //const float boxYOffset = -0.25f; // negative = draw LOWER (
-        const u32 color = chasing ? 0xFFFF4040 : 0xFFB0B0B0;
+        const u32 color = GetComponent<EnemyBrain>().chasing ? 0xFFFF4040 : 0xFFB0B0B0;
         const AEVec2 hb = GetHurtboxPos();
-        QuickGraphics::DrawRect(hb.x, hb.y, size.x, size.y, color, AE_GFX_MDM_LINES_STRIP);
+        QuickGraphics::DrawRect(hb.x, hb.y, transformComponent.size.x, transformComponent.size.y, color, AE_GFX_MDM_LINES_STRIP);
     }
 }
@@ -2,6 +2,7 @@
 
 #include "../../Utils/Sprite.h"
 #include "EnemyAttack.h"
+#include "EnemyComponents.h"
 #include <AEVec2.h>
 #include "IDamageable.h"
 #include "../../Editor/EditorUtils.h"
@@ -9,6 +10,11 @@
 
 class MapGrid; // forward declaration to avoid circular dependency
 
+/**
+ * @brief	Regular enemy (druid / skeleton). The simulation data (position, health, AI state...) is a row in
+ *			EnemyManager's EnemyTable and updated for every enemy at once by EnemySystems.
+ *			This only keeps the entity, the sprite and the particles, and is what the damage / editor code gets.
+ */
 class Enemy : public IDamageable, Inspectable
 {
 public:
@@ -19,59 +25,25 @@ public:
         Skeleton
     };
 
-    struct Config
-    {
-        const char* spritePath = nullptr;
-
-        int maxHp = 10;   // basic life system
-        int attackDamage = 1;
-        bool hideAfterDeath = false;
-
-
-        // Render
-        float renderScale = 2.f;
-
-        // Movement / AI
-        float moveSpeed = 2.0f;
-        float aggroRange = 5.0f;
-        float leashRange = 8.0f;
-
-        // Vertical gating (in world/tile units)
-        float aggroYRange = 1.0f; // start chasing only if player within this Y diff
-        float attackYRange = 1.0f; // allow attacking only if within this Y diff
-
-        // Animation selection
-        float runVelThreshold = 0.1f; // when to play RUN instead of IDLE
-
-        // Attack tuning
-        float attackStartRange = 1.1f;
-        float attackHitRange = 1.5f;
-        float attackCooldown = 0.8f;
-        float attackHitTimeNormalized = 0.5f; // 0..1
-        float attackBreakRange = 100.0f;
-
-        // Row indices in the sprite meta (IMPORTANT if your meta order differs)
-        int animAttack = 0;
-        int animRun = 2;
-        int animIdle = 3;
-        int animHurt = 4;
-        int animDeath = 1;
-
-    };
+    using Config = EnemyConfig;
 
 public:
-    Enemy(Preset preset = Preset::Druid, float initialPosX = 0.f, float initialPosY = 0.f);
-    Enemy(const Config& cfg, float initialPosX, float initialPosY);
+    // Adds a row to the table, removed in the destructor
+    Enemy(EnemyTable& table, Preset preset = Preset::Druid, float initialPosX = 0.f, float initialPosY = 0.f);
+    Enemy(EnemyTable& table, const Config& cfg, float initialPosX, float initialPosY);
  
     static Config MakePreset(Preset preset);
-    ~Enemy() = default;
+    ~Enemy();
 
-    int GetMaxHp() const { return cfg.maxHp; }
-    int GetCurrentHp() const { return hp; }
+    Enemy(const Enemy&) = delete;
+    Enemy& operator=(const Enemy&) = delete;
 
-    void SetMaxHp(int value) { cfg.maxHp = value; }
-    void SetCurrentHp(int value) { hp = value; }
-    void SetAttackDamage(int value) { cfg.attackDamage = value; }
+    int GetMaxHp() const { return GetComponent<Health>().maxHp; }
+    int GetCurrentHp() const { return GetComponent<Health>().hp; }
+
+    void SetMaxHp(int value) { GetComponent<Health>().maxHp = value; }
+    void SetCurrentHp(int value) { GetComponent<Health>().hp = value; }
+    void SetAttackDamage(int value) { GetComponent<Config>().attackDamage = value; }
 
     void ApplyRoomScaling(int extraHp, int extraDamage);
    
@@ -85,19 +57,22 @@ public:
     void DrawInspector() override;
     bool CheckIfClicked(const AEVec2& mousePos) override;
 
-    void Update(const AEVec2& playerPos, MapGrid& map);
+    /**
+     * @brief   Applies what EnemySystems::UpdateBrains decided for the sprite and particles this frame
+     */
+    void UpdateVisuals(const EnemyAnimation& animation, const Transform& transform, const Motion& motion);
     
     void Render();
 
     // For GameScene to apply damage later
-    bool PollAttackHit() { return !dead && attack.PollHit(); }
+    bool PollAttackHit() { return !IsDead() && GetComponent<EnemyAttack>().PollHit(); }
 
     Preset GetPreset() const { return presetType; }
     bool IsDruid() const { return presetType == Preset::Druid; }
 
     //For enemy life system
-    bool IsDead() const { return dead; }
-    int  GetHP() const { return hp; }
+    bool IsDead() const override { return GetComponent<Health>().dead; }
+    int  GetHP() const { return GetComponent<Health>().hp; }
 
     // Returns true if damage was actually applied.
     bool TryTakeDamage(int dmg, const AEVec2& hitOrigin, DAMAGE_TYPE type = DAMAGE_TYPE_NORMAL) override;
@@ -107,14 +82,16 @@ public:
 
 
     // Useful getters for combat / debugging
-    const AEVec2& GetPosition() const { return position; }
-    const AEVec2& GetSize() const { return size; }
-    bool   IsChasing() const { return chasing; }
-    bool   IsReturningHome() const { return returningHome; }
+    const AEVec2& GetPosition() const { return GetComponent<Transform>().position; }
+    const AEVec2& GetSize() const { return GetComponent<Transform>().size; }
+    bool   IsChasing() const { return GetComponent<EnemyBrain>().chasing; }
+    bool   IsReturningHome() const { return GetComponent<EnemyBrain>().returningHome; }
+
 
+    float GetAttackHitRange() const { return GetComponent<EnemyAttack>().hitRange; }   // mid/close range
+    int   GetAttackDamage() const { return GetComponent<Config>().attackDamage; }  
 
-    float GetAttackHitRange() const { return attack.hitRange; }   // mid/close range
-    int   GetAttackDamage() const { return cfg.attackDamage; }  
+    EnemyTable::Entity GetEntity() const { return entity; }
 
 
 
@@ -126,45 +103,19 @@ public:
     ParticleSystem particleSystem{ 30, {} }; // pool size 30 is enough for small bursts
 
 private:
-    void UpdateAnimation();
     static float GetAnimDurationSec(const Sprite& sprite, int stateIndex);
     Preset presetType = Preset::Skeleton;
 
-
+    template <typename T>
+    T& GetComponent() { return table.Get<T>(entity); }
+    template <typename T>
+    const T& GetComponent() const { return table.Get<T>(entity); }
 
 private:
-    Config cfg;
+    EnemyTable& table;
+    EnemyTable::Entity entity;
 
     Sprite sprite;
-    EnemyAttack attack;
 
-    AEVec2 position{ 0.f, 0.f };
-    AEVec2 homePos{ 0.f, 0.f };
-    AEVec2 velocity{ 0.f, 0.f };
-    AEVec2 size{ 0.8f, 0.8f };
-    AEVec2 facingDirection{ 1.f, 0.f };
-
-    bool chasing{ false };
-    bool returningHome{ false };
-    bool hadAggro = false;
     bool debugDraw{ false };
-
-    float idleWalkLeft = 0.f;     // seconds left to keep walking
-    float idlePauseLeft = 0.f;    // seconds left to pause
-    float idleDirX = 1.f;         // +1 or -1
-
-    int  hp{ 1 };
-    bool dead{ false };
-
-    // Hurt lock: keeps the hurt animation visible long enough to notice
-    float hurtTimeLeft{ 1.0f };
-    float deathTimeLeft{ 0.5f };
-    bool hidden = false;
-    int lastHitAttackId{ -1 };
-  // NEW internal helper
-    bool HasGroundAhead(MapGrid& map, float dirX) const;
-    bool HasWallAhead(MapGrid& map, float dirX) const;
-
-
-
 };
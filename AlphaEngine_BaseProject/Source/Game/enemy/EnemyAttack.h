@@ -23,7 +23,7 @@ public:
         justStarted = false;
 
         // Tick cooldown
-        if (cooldownTimer > 0.f) cooldownTimer = max(0.f, cooldownTimer - dt);
+        if (cooldownTimer > 0.f) cooldownTimer = (std::max)(0.f, cooldownTimer - dt);
 
         const float dur = (attackAnimDurationSec > 0.f) ? attackAnimDurationSec : fallbackAnimDuration;
 
@@ -1,13 +1,16 @@
 #include "EnemyBoss.h"
 #include <cmath>
 #include "../../Utils/QuickGraphics.h"
+#include "../../Utils/Renderer.h"
 #include <AEVec2.h>
 #include <Windows.h>
 #include <vector>
 #include <algorithm>
 #include <imgui.h>
 #include "../../Utils/AEExtras.h"
+#include "../../Utils/MemoryTracker.h"
 #include "../Environment/MapGrid.h"
+#include "../Time.h"
 
 
 static inline u32 ScaleAlpha(u32 argb, float alphaMul)
@@ -16,7 +19,7 @@ static inline u32 ScaleAlpha(u32 argb, float alphaMul)
     unsigned rgb = argb & 0x00FFFFFF;
 
     float af = (a / 255.0f) * alphaMul;
-    af = max(0.0f, min(1.0f, af));
+    af = (std::max)(0.0f, (std::min)(1.0f, af));
 
     unsigned anew = (unsigned)(af * 255.0f + 0.5f);
     return (anew << 24) | rgb;
@@ -85,7 +88,7 @@ bool EnemyBoss::TryTakeDamage(int dmg, const AEVec2&, DAMAGE_TYPE )
     {
         hp = 0; 
         isDead = true;
-        sprite.SetState(DEATH, false, nullptr);
+        sprite.SetState(DEATH);
         deathTimeLeft = GetAnimDurationSec(sprite, DEATH);
         if (deathTimeLeft <= 0.f)
             deathTimeLeft = 0.5f; // fallback
@@ -149,6 +152,7 @@ EnemyBoss::EnemyBoss()
     , specialAttackVfx("Assets/Craftpix/Bringer_of_Death3.png")
     , bossFont(AEGfxCreateFont("Assets/m04.ttf", 36))
 {
+    MEMORY_SCOPE(Enemies);
     //position = AEVec2{ initialPosX, initialPosY };
     velocity = AEVec2{ 0.f, 0.f };
     specialAttackVfx.SetState(SPELL1);
@@ -187,6 +191,7 @@ EnemyBoss::EnemyBoss(float initialPosX, float initialPosY) : EnemyBoss()
 {
 
     position = AEVec2{ initialPosX, initialPosY };
+    previousPosition = position;
     RebuildTeleportBounds();
   
   
@@ -201,6 +206,7 @@ EnemyBoss::~EnemyBoss()
 void EnemyBoss::SetSpawnPosition(const AEVec2& spawnPos)
 {
     position = spawnPos;
+    previousPosition = position;
     RebuildTeleportBounds();
 
     teleportActive = false;
@@ -212,7 +218,7 @@ void EnemyBoss::SetSpawnPosition(const AEVec2& spawnPos)
     chasing = false;
     facingDirection = AEVec2{ 1.f, 0.f };
 
-    sprite.SetState(IDLE, false, nullptr);
+    sprite.SetState(IDLE);
 }
 
 // Spawns "charge" particles around the boss that drift inward.
@@ -294,25 +300,37 @@ bool EnemyBoss::IsTeleportXValid(float targetX,
     MapGrid& map,
     bool allowOnPlayer) const
 {
-    if (targetX < teleportMinX || targetX > teleportMaxX)
-        return false;
-
-    if (!allowOnPlayer && std::fabs(targetX - playerPos.x) < teleportMinPlayerGap)
+    if (!IsTeleportXInRange(targetX, playerPos, allowOnPlayer))
         return false;
 
     AEVec2 testPos = position;
     testPos.x = targetX;
 
-    AEVec2 testSize = size;
-    testSize.x = max(0.05f, testSize.x - teleportWallPadding);
-    testSize.y = max(0.05f, testSize.y - teleportWallPadding);
+    if (map.CheckBoxCollision(testPos, GetTeleportTestSize()))
+        return false;
+
+    return true;
+}
 
-    if (map.CheckBoxCollision(testPos, testSize))
+bool EnemyBoss::IsTeleportXInRange(float targetX, const AEVec2& playerPos, bool allowOnPlayer) const
+{
+    if (targetX < teleportMinX || targetX > teleportMaxX)
+        return false;
+
+    if (!allowOnPlayer && std::fabs(targetX - playerPos.x) < teleportMinPlayerGap)
         return false;
 
     return true;
 }
 
+AEVec2 EnemyBoss::GetTeleportTestSize() const
+{
+    AEVec2 testSize = size;
+    testSize.x = (std::max)(0.05f, testSize.x - teleportWallPadding);
+    testSize.y = (std::max)(0.05f, testSize.y - teleportWallPadding);
+    return testSize;
+}
+
 float EnemyBoss::FindTeleportTarget(const AEVec2& playerPos,
     bool playerFacingRight,
     MapGrid& map) const
@@ -323,41 +341,55 @@ float EnemyBoss::FindTeleportTarget(const AEVec2& playerPos,
     const float d2 = teleportBehindOffset * 0.75f;
     const float d3 = teleportBehindOffset * 0.50f;
 
-    const float behindCandidates[] =
+    // Then try a clamped behind position, still behind-only
+    const float clampedBehind =
+        std::clamp(playerPos.x + behindDir * d1, teleportMinX, teleportMaxX);
+
+    // In order of preference. Prefer valid positions behind the player only
+    // Final fallback: teleport on the player if behind is blocked by wall/space
+    const float candidates[] =
     {
         playerPos.x + behindDir * d1,
         playerPos.x + behindDir * d2,
-        playerPos.x + behindDir * d3
+        playerPos.x + behindDir * d3,
+        clampedBehind,
+        playerPos.x
     };
+    constexpr int candidateCount = sizeof(candidates) / sizeof(candidates[0]);
 
-    // Prefer valid positions behind the player only
-    for (float x : behindCandidates)
+    // Filter by range first, then check the rest against the map in one batch
+    AEVec2 testPositions[candidateCount];
+    int testCandidates[candidateCount];
+    int testCount = 0;
+    for (int i = 0; i < candidateCount; ++i)
     {
-        if (IsTeleportXValid(x, playerPos, map))
-            return x;
-    }
+        const bool allowOnPlayer = (i == candidateCount - 1);
+        if (!IsTeleportXInRange(candidates[i], playerPos, allowOnPlayer))
+            continue;
 
-    // Then try a clamped behind position, still behind-only
-    const float clampedBehind =
-        std::clamp(playerPos.x + behindDir * d1, teleportMinX, teleportMaxX);
-
-    if (IsTeleportXValid(clampedBehind, playerPos, map))
-        return clampedBehind;
+        testPositions[testCount] = AEVec2{ candidates[i], position.y };
+        testCandidates[testCount] = i;
+        ++testCount;
+    }
 
-    // Final fallback: teleport on the player if behind is blocked by wall/space
-    /*const float onPlayerX =
-        std::clamp(playerPos.x, teleportMinX, teleportMaxX);*/
+    bool isBlocked[candidateCount];
+    map.CheckBoxCollisionBatch(testPositions, testCount, GetTeleportTestSize(), isBlocked);
 
-    if (IsTeleportXValid(playerPos.x, playerPos, map, true))
-        return playerPos.x;
+    for (int i = 0; i < testCount; ++i)
+    {
+        if (!isBlocked[i])
+            return candidates[testCandidates[i]];
+    }
 
     return position.x;
 }
 
 void EnemyBoss::Update(const AEVec2& playerPos, bool playerFacingRight, MapGrid& map)
 {
+	MEMORY_SCOPE(Enemies);
 
-	float dt = (float)AEFrameRateControllerGetFrameTime();
+	float dt = static_cast<float>(Time::GetInstance().GetDeltaTime());
+	previousPosition = position;
 
     auto UpdateBossParticles = [&]()
         {
@@ -403,7 +435,7 @@ void EnemyBoss::Update(const AEVec2& playerPos, bool playerFacingRight, MapGrid&
 
 
     float hpTarget = (maxHP > 0) ? (float)hp / (float)maxHP : 0.f;
-    hpTarget = max(0.f, min(1.f, hpTarget));
+    hpTarget = (std::max)(0.f, (std::min)(1.f, hpTarget));
 
     const float hpRatio = hpTarget;          // 1.0 at full HP, 0.0 at death
 
@@ -438,7 +470,7 @@ void EnemyBoss::Update(const AEVec2& playerPos, bool playerFacingRight, MapGrid&
     hpBarFront += (hpTarget - hpBarFront) * (1.0f - expf(-18.0f * dt));
 
     // Delay countdown
-    hpChipDelay = max(0.f, hpChipDelay - dt);
+    hpChipDelay = (std::max)(0.f, hpChipDelay - dt);
 
     // Chip follows slow AFTER delay
     if (hpChipDelay <= 0.f)
@@ -580,6 +612,7 @@ void EnemyBoss::Update(const AEVec2& playerPos, bool playerFacingRight, MapGrid&
             const float targetX = FindTeleportTarget(playerPos, playerFacingRight, map);
 
             position.x = targetX;
+            previousPosition = position;    // Don't interpolate the teleport
 
             facingDirection = AEVec2{ (playerPos.x >= position.x) ? 1.f : -1.f, 0.f };
 
@@ -730,7 +763,7 @@ void EnemyBoss::Update(const AEVec2& playerPos, bool playerFacingRight, MapGrid&
                 // Start spawning on the *last frame start* of SPELLCAST so there's no visible "dead gap"
                 const float castDur = GetAnimDurationSec(sprite, SPELLCAST);
                 const float tpf = GetAnimTimePerFrame(sprite, SPELLCAST);
-                specialSpawnTimer = ((castDur > 0.f) ? max(0.0f, castDur - tpf) : 0.0f) + kChargeUpExtra;
+                specialSpawnTimer = ((castDur > 0.f) ? (std::max)(0.0f, castDur - tpf) : 0.0f) + kChargeUpExtra;
             }
         }
     }
@@ -1031,6 +1064,7 @@ void EnemyBoss::Render()
         (velocity.x != 0.f) ? (velocity.x > 0.f) : (facingDirection.x > 0.f);
 
     const float bossScale = 3.5f;
+    const AEVec2 renderPosition = AEExtras::Lerp(previousPosition, position, Time::GetInstance().GetInterpolationAlpha());
 
     AEMtx33Scale(&m, faceRight ? bossScale : -bossScale, bossScale);
 
@@ -1042,14 +1076,19 @@ void EnemyBoss::Render()
 
     AEMtx33TransApply(
         &m, &m,
-        position.x - (0.5f - px),
-        position.y - (0.75f - py)
+        renderPosition.x - (0.5f - px),
+        renderPosition.y - (0.75f - py)
     );
 
     AEMtx33ScaleApply(&m, &m, Camera::scale, Camera::scale);
-    AEGfxSetTransform(m.m);
 
-    sprite.Render();
+    sprite.Render(m);
+
+    for (const auto& specialAttack : g_specialAttacks)
+        specialAttack.Render(specialAttackVfx, 10.0f, 3.0f);
+
+    // The debug shapes and health bar are drawn straight away, on top of the sprites
+    Renderer::Flush();
 
     // Reset transform for world-space debug / effects
     AEMtx33 world;
@@ -1058,10 +1097,6 @@ void EnemyBoss::Render()
 
     for (const auto& specialAttack : g_specialAttacks)
     {
-        specialAttack.Render(specialAttackVfx, 10.0f, 3.0f);
-
-        AEGfxSetTransform(world.m);
-
         if (debugDraw)
         {
             QuickGraphics::DrawRect(
@@ -1106,6 +1141,7 @@ void EnemyBoss::Render()
 void EnemyBoss::Reset(const AEVec2& spawnPos)
 {
     position = spawnPos;
+    previousPosition = position;
     RebuildTeleportBounds();
     velocity = AEVec2{ 0.f, 0.f };
     facingDirection = AEVec2{ 1.f, 0.f };
@@ -1149,7 +1185,7 @@ void EnemyBoss::Reset(const AEVec2& spawnPos)
     prevHpTarget = 1.f;
     hpChipDelay = 0.f;
 
-    sprite.SetState(IDLE, false, nullptr);
+    sprite.SetState(IDLE);
     specialAttackVfx.SetState(SPELL1);
 
     particleSystem.SetSpawnRate(0.f);
@@ -1218,10 +1254,10 @@ void EnemyBoss::RenderHealthbar() const
     float t = hudIntroStarted ? hudIntroTimer : 999.0f;
 
     float nameAlpha = t / nameFadeDuration;
-    nameAlpha = max(0.0f, min(1.0f, nameAlpha));
+    nameAlpha = (std::max)(0.0f, (std::min)(1.0f, nameAlpha));
 
     float barReveal = (t - barStartDelay) / barFillDuration;
-    barReveal = max(0.0f, min(1.0f, barReveal));
+    barReveal = (std::max)(0.0f, (std::min)(1.0f, barReveal));
       
     AEMtx33 ui;
     AEMtx33Scale(&ui, 1.f, 1.f);
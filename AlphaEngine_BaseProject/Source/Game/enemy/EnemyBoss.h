@@ -52,11 +52,8 @@ struct SpecialAttack
         );
 
         AEMtx33ScaleApply(&m, &m, Camera::scale, Camera::scale);
-        AEGfxSetTransform(m.m);
 
-        AEGfxSetBlendMode(AE_GFX_BM_ADD);
-        vfx.Render();
-        AEGfxSetBlendMode(AE_GFX_BM_BLEND);
+        vfx.Render(m, 0xFFFFFFFF, AE_GFX_BM_ADD);
     }
 };
 
@@ -75,6 +72,7 @@ public:
     void Render();
     
     AEVec2 position{};
+    AEVec2 previousPosition{};  // Position before the last tick, for render interpolation
 
 
     bool isDead = false;
@@ -150,6 +148,10 @@ public:
         MapGrid& map) const;
 
 private:
+    // Teleport checks that don't need the map
+    bool IsTeleportXInRange(float targetX, const AEVec2& playerPos, bool allowOnPlayer) const;
+    // Box tested against the map at the teleport target
+    AEVec2 GetTeleportTestSize() const;
 
     enum AnimState
     {
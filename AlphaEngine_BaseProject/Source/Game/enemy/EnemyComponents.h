@@ -0,0 +1,93 @@
+#pragma once
+#include "AEEngine.h"
+#include "EnemyAttack.h"
+#include "../ActorComponents.h"
+#include "../../Utils/ComponentTable.h"
+
+class Enemy;
+
+/**
+ * @brief	Tuning of an enemy. Set from Enemy::MakePreset
+ */
+struct EnemyConfig
+{
+    const char* spritePath = nullptr;
+
+    int maxHp = 10;   // basic life system
+    int attackDamage = 1;
+    bool hideAfterDeath = false;
+
+
+    // Render
+    float renderScale = 2.f;
+
+    // Movement / AI
+    float moveSpeed = 2.0f;
+    float aggroRange = 5.0f;
+    float leashRange = 8.0f;
+
+    // Vertical gating (in world/tile units)
+    float aggroYRange = 1.0f; // start chasing only if player within this Y diff
+    float attackYRange = 1.0f; // allow attacking only if within this Y diff
+
+    // Animation selection
+    float runVelThreshold = 0.1f; // when to play RUN instead of IDLE
+
+    // Attack tuning
+    float attackStartRange = 1.1f;
+    float attackHitRange = 1.5f;
+    float attackCooldown = 0.8f;
+    float attackHitTimeNormalized = 0.5f; // 0..1
+    float attackBreakRange = 100.0f;
+
+    // Row indices in the sprite meta (IMPORTANT if your meta order differs)
+    int animAttack = 0;
+    int animRun = 2;
+    int animIdle = 3;
+    int animHurt = 4;
+    int animDeath = 1;
+
+};
+
+/**
+ * @brief	AI state: guarding home, chasing, returning home, idle wandering, hurt / death timers
+ */
+struct EnemyBrain
+{
+    AEVec2 homePos{ 0.f, 0.f };
+
+    bool chasing{ false };
+    bool returningHome{ false };
+    bool hadAggro = false;
+
+    float idleWalkLeft = 0.f;     // seconds left to keep walking
+    float idlePauseLeft = 0.f;    // seconds left to pause
+    float idleDirX = 1.f;         // +1 or -1
+
+    // Hurt lock: keeps the hurt animation visible long enough to notice
+    float hurtTimeLeft{ 1.0f };
+    float deathTimeLeft{ 0.5f };
+    bool hidden = false;
+};
+
+/**
+ * @brief	What the enemy's sprite / particles should do this frame. Written by EnemySystems::UpdateBrains,
+ *			applied by EnemySystems::UpdateVisuals so the AI pass doesn't touch the sprites
+ */
+struct EnemyAnimation
+{
+    static constexpr int KEEP_STATE = -1;
+
+    int nextState = KEEP_STATE;     // Sprite state to set, KEEP_STATE to leave it
+    bool play = false;              // Advance the sprite this frame
+    bool emitParticles = false;     // Update the trail particles this frame
+
+    // From the sprite metadata, so the AI doesn't need the sprite
+    float attackDuration = 0.f;
+    float deathTimePerFrame = 0.f;
+};
+
+/**
+ * @brief	Every regular enemy's components, owned by EnemyManager. Last column is the Enemy the row belongs to
+ */
+using EnemyTable = ComponentTable<Transform, Motion, Health, EnemyBrain, EnemyAttack, EnemyConfig, EnemyAnimation, Enemy*>;
@@ -4,10 +4,17 @@
 #include <memory>
 #include <functional>
 #include <algorithm>
+#include <span>
 #include "Enemy.h"     
-#include "Enemyboss.h"
+#include "EnemyBoss.h"
+#include "EnemySystems.h"
 #include "IDamageable.h"
 #include "../Rooms/RoomData.h"
+#include "../Time.h"
+#include "../../Utils/Profiler.h"
+#include "../../Utils/MemoryTracker.h"
+#include "../../Utils/ObjectPool.h"
+#include "../../Utils/SpatialHash.h"
 
 enum class EnemySpawnType
 {
@@ -37,6 +44,7 @@ public:
       
         bossDamageable = b;
         boss = b;
+        spatialIndexDirty = true;
        
     }
 
@@ -44,9 +52,9 @@ public:
     EnemyManager() = default;
 
     // --- Data-driven spawning (use this for editor / level load) ---
-    void SetSpawns(const std::vector<SpawnInfo>& newSpawns)
+    void SetSpawns(std::span<const SpawnInfo> newSpawns)
     {
-        spawns = newSpawns;
+        spawns.assign(newSpawns.begin(), newSpawns.end());
     }
 
     void ClearSpawns()
@@ -56,8 +64,10 @@ public:
 
     void SpawnAll()
     {
-        enemies.clear();
-        enemies.reserve(spawns.size());
+        MEMORY_SCOPE(Enemies);
+        spatialIndexDirty = true;
+        storage->enemies.Clear();
+        storage->table.Reserve(spawns.size());
 
        /* for (const auto& s : spawns)
             enemies.emplace_back(std::make_unique<Enemy>(s.preset, s.pos.x, s.pos.y));*/
@@ -67,27 +77,21 @@ public:
         {
         case EnemySpawnType::Druid:
         {
-            auto e = std::make_unique<Enemy>(Enemy::Preset::Druid, s.pos.x, s.pos.y);
+            Enemy& e = SpawnEnemy(Enemy::Preset::Druid, s.pos);
             //DEPTH IS USE TO SCALE THE HEALTH AND DAMAGE OR REGULAR ENEMY
-            int depth = 0;
-            if (currentRoomId != ROOM_NONE)
-                depth = static_cast<int>(currentRoomId) - static_cast<int>(ROOM_1);
+            const int depth = roomDepth;
 
-            e->ApplyRoomScaling(depth * 10, depth * 1);
-            enemies.emplace_back(std::move(e));
+            e.ApplyRoomScaling(depth * 10, depth * 1);
         }
         break;
 
         case EnemySpawnType::Skeleton:
         {
-            auto e = std::make_unique<Enemy>(Enemy::Preset::Skeleton, s.pos.x, s.pos.y);
+            Enemy& e = SpawnEnemy(Enemy::Preset::Skeleton, s.pos);
             
-            int depth = 0;
-            if (currentRoomId != ROOM_NONE)
-                depth = static_cast<int>(currentRoomId) - static_cast<int>(ROOM_1);
+            const int depth = roomDepth;
 
-            e->ApplyRoomScaling(depth * 10, depth * 1);
-            enemies.emplace_back(std::move(e));
+            e.ApplyRoomScaling(depth * 10, depth * 1);
         }
         break;
     
@@ -103,29 +107,38 @@ public:
     // --- Manual spawn (optional) ---
     Enemy& Spawn(Enemy::Preset preset, const AEVec2& pos)
     {
-        enemies.emplace_back(std::make_unique<Enemy>(preset, pos.x, pos.y));
-        return *enemies.back();
+        spatialIndexDirty = true;
+        return SpawnEnemy(preset, pos);
     }
 
     // --- Despawn ---
     void DespawnAll()
     {
-        enemies.clear();
+        spatialIndexDirty = true;
+        storage->enemies.Clear();
     }
 
     // Optional helper: remove enemies that match a predicate
     template<typename Pred>
     void DespawnWhere(Pred&& pred)
     {
-        enemies.erase(
-            std::remove_if(enemies.begin(), enemies.end(),
-                [&](const std::unique_ptr<Enemy>& e) { return pred(*e); }),
-            enemies.end());
+        spatialIndexDirty = true;
+
+        // From the back, releasing moves the last enemy into the released one's place
+        ObjectPool<Enemy>& enemies = storage->enemies;
+        for (int i = static_cast<int>(enemies.GetSize()) - 1; i >= 0; --i)
+        {
+            if (pred(enemies.At(i)))
+                enemies.Release(enemies.GetHandle(i));
+        }
     }
 
     // --- Update/Render ---
     void UpdateAll(const AEVec2& playerpos, bool playerFacingRight, MapGrid& map)
     {
+        PROFILE_SCOPE("EnemyManager::UpdateAll");
+        MEMORY_SCOPE(Enemies);
+
         // update regular enemies
         UpdateAll(playerpos, map);
 
@@ -136,14 +149,22 @@ public:
 
     void UpdateAll(const AEVec2& playerPos, MapGrid& map)
     {
-        for (auto& e : enemies)
-            e->Update(playerPos, map);
+        PROFILE_SCOPE("EnemyManager::UpdateEnemies");
+        MEMORY_SCOPE(Enemies);
+
+        const float dt = static_cast<float>(Time::GetInstance().GetDeltaTime());
+        EnemySystems::UpdateBrains(storage->table, playerPos, map, dt);
+        EnemySystems::UpdateVisuals(storage->table);
+
+        // Enemies moved
+        spatialIndexDirty = true;
     }
 
     void ResetAll()
     {
-        enemies.clear();
-        enemies.reserve(spawns.size());
+        spatialIndexDirty = true;
+        storage->enemies.Clear();
+        storage->table.Reserve(spawns.size());
 
         for (const auto& s : spawns)
         {
@@ -151,27 +172,21 @@ public:
             {
             case EnemySpawnType::Druid:
             {
-                auto e = std::make_unique<Enemy>(Enemy::Preset::Druid, s.pos.x, s.pos.y);
+                Enemy& e = SpawnEnemy(Enemy::Preset::Druid, s.pos);
                 //DEPTH IS USE TO SCALE THE HEALTH AND DAMAGE OR REGULAR ENEMY
-                int depth = 0;
-                if (currentRoomId != ROOM_NONE)
-                    depth = static_cast<int>(currentRoomId) - static_cast<int>(ROOM_1);
+                const int depth = roomDepth;
 
-                e->ApplyRoomScaling(depth * 10, depth * 1);
-                enemies.emplace_back(std::move(e));
+                e.ApplyRoomScaling(depth * 10, depth * 1);
             }
             break;
 
             case EnemySpawnType::Skeleton:
             {
-                auto e = std::make_unique<Enemy>(Enemy::Preset::Skeleton, s.pos.x, s.pos.y);
+                Enemy& e = SpawnEnemy(Enemy::Preset::Skeleton, s.pos);
 
-                int depth = 0;
-                if (currentRoomId != ROOM_NONE)
-                    depth = static_cast<int>(currentRoomId) - static_cast<int>(ROOM_1);
+                const int depth = roomDepth;
 
-                e->ApplyRoomScaling(depth * 10, depth * 1);
-                enemies.emplace_back(std::move(e));
+                e.ApplyRoomScaling(depth * 10, depth * 1);
             }
             break;
 
@@ -186,8 +201,8 @@ public:
   
     void RenderAll()
     {
-        for (auto& e : enemies)
-            e->Render();
+        for (Enemy& e : storage->enemies)
+            e.Render();
 
     }
 
@@ -195,41 +210,99 @@ public:
     template<typename Fn>
     void ForEachEnemy(Fn&& fn)
     {
-        for (auto& e : enemies)
-            fn(*e);
+        for (Enemy& e : storage->enemies)
+            fn(e);
     }
 
     template<typename Fn>
     void ForEachDamageable(Fn&& fn)
     {
-        for (auto& e : enemies) fn(static_cast<IDamageable&>(*e));
+        for (Enemy& e : storage->enemies) fn(static_cast<IDamageable&>(e));
         if (bossDamageable) fn(*bossDamageable);
     }
 
-    int Count() const { return (int)enemies.size(); }
+    // Same as ForEachDamageable but only the ones whose hurtbox overlaps the box (center / full size).
+    // Uses the broadphase so it only tests the damageables near the box.
+    template<typename Fn>
+    void ForEachDamageableInBox(const AEVec2& pos, const AEVec2& size, Fn&& fn)
+    {
+        UpdateSpatialIndex();
+        damageableIndex.QueryBox(pos, size, [&](IDamageable* obj) { fn(*obj); });
+    }
+
+    template<typename Fn>
+    void ForEachDamageableInRadius(const AEVec2& center, float radius, Fn&& fn)
+    {
+        UpdateSpatialIndex();
+        damageableIndex.QueryRadius(center, radius, [&](IDamageable* obj) { fn(*obj); });
+    }
+
+    // Call if enemies are moved outside of UpdateAll (e.g. editor). Rebuilt every frame anyway
+    void MarkSpatialIndexDirty() { spatialIndexDirty = true; }
+
+    int Count() const { return (int)storage->enemies.GetSize(); }
 
-    void SetCurrentRoomID(RoomID id)
+    // Rooms between the start room and this one, scales the health / damage of spawned enemies
+    void SetRoomDepth(int depth)
     {
-        currentRoomId = id;
+        roomDepth = depth;
     }
 
 
 
 private:
     std::vector<SpawnInfo> spawns;                     // editor/level data
-    std::vector<std::unique_ptr<Enemy>> enemies;       // runtime instances
+
+    // Components of every enemy + the Enemy objects (stable addresses, the damageable index points to them).
+    // In a unique_ptr so moving the manager doesn't move the table the enemies point to
+    struct Storage
+    {
+        EnemyTable table;
+        ObjectPool<Enemy> enemies;     // Destroyed before the table, each Enemy removes its row
+    };
+    std::unique_ptr<Storage> storage = std::make_unique<Storage>();
     IDamageable* bossDamageable = nullptr;
 	EnemyBoss* boss = nullptr; // optional direct pointer if you need boss-specific logic
     
-    RoomID currentRoomId = ROOM_1;
+    int roomDepth = 0;
+
+    // Broadphase for the hurtboxes of enemies + boss. Rebuilt on the first query after they move
+    SpatialHash<IDamageable*> damageableIndex;
+    bool spatialIndexDirty = true;
+    u32 spatialIndexFrame = 0;
+
+    Enemy& SpawnEnemy(Enemy::Preset preset, const AEVec2& pos)
+    {
+        ObjectPool<Enemy>& enemies = storage->enemies;
+        return *enemies.Find(enemies.Get(storage->table, preset, pos.x, pos.y));
+    }
+
+    void UpdateSpatialIndex()
+    {
+        const u32 frame = AEFrameRateControllerGetFrameCount();
+        if (!spatialIndexDirty && frame == spatialIndexFrame)
+            return;
+
+        damageableIndex.Clear();
+
+        // Straight from the table instead of going through every Enemy
+        storage->table.ForEach<Transform, Enemy*>([this](const Transform& transform, Enemy* enemy) {
+            damageableIndex.Insert(enemy, transform.position, transform.size);
+        });
+        if (bossDamageable)
+            damageableIndex.Insert(bossDamageable, bossDamageable->GetHurtboxPos(), bossDamageable->GetHurtboxSize());
+
+        damageableIndex.Build();
+
+        spatialIndexDirty = false;
+        spatialIndexFrame = frame;
+    }
     /*
     Enemy::Config BuildScaledConfig(Enemy::Preset preset) const
     {
         Enemy::Config cfg = Enemy::MakePreset(preset);
 
-        int depth = 0;
-        if (currentRoomId != ROOM_NONE)
-            depth = static_cast<int>(currentRoomId) - static_cast<int>(ROOM_1);
+        const int depth = roomDepth;
 
         cfg.maxHp += depth * 10;          // example: +10 hp per deeper room
         cfg.attackDamage += depth * 1;    // example: +1 damage per deeper room
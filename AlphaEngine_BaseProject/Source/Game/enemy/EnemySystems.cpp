@@ -0,0 +1,385 @@
+#include "EnemySystems.h"
+
+#include <cmath>
+#include "Enemy.h"
+#include "../Environment/MapGrid.h"
+#include "../../Utils/Profiler.h"
+
+namespace
+{
+    bool HasGroundAhead(MapGrid& map, const Transform& transform, float dirX)
+    {
+        const AEVec2 hbPos = transform.position;   // center
+        const AEVec2 hbSize = transform.size;      // full size
+
+        const float eps = 0.05f;
+
+        // Probe a point just in front of the feet
+        const float probeX = hbPos.x + dirX * (hbSize.x * 0.5f + eps);
+        const float probeY = hbPos.y - hbSize.y * 0.5f - eps;
+
+        // MapGrid already treats "not NONE" as solid
+        return map.CheckPointCollision(probeX, probeY);
+    }
+
+    bool HasWallAhead(MapGrid& map, const Transform& transform, float dirX)
+    {
+        const AEVec2 hbPos = transform.position;    // center
+        const AEVec2 hbSize = transform.size;       // full size
+
+        const float eps = 0.05f;
+
+        // check just in front of the body
+        const float probeX = hbPos.x + dirX * (hbSize.x * 0.5f + eps);
+        const float probeY = hbPos.y; // middle height
+
+        return map.CheckPointCollision(probeX, probeY);
+    }
+
+    // ---- Animation selection ----
+    int SelectAnimState(const Motion& motion, const Health& health, const EnemyBrain& brain,
+                        const EnemyAttack& attack, const EnemyConfig& cfg)
+    {
+        if (health.dead)
+            return EnemyAnimation::KEEP_STATE;
+
+        if (brain.hurtTimeLeft > 0.f)
+            return cfg.animHurt;
+
+        if (attack.IsAttacking())
+            return cfg.animAttack;
+
+        if (std::fabs(motion.velocity.x) > cfg.runVelThreshold)
+            return cfg.animRun;
+        else
+            return cfg.animIdle;
+    }
+
+    void UpdateBrain(Transform& transform, Motion& motion, Health& health, EnemyBrain& brain, EnemyAttack& attack,
+                     const EnemyConfig& cfg, EnemyAnimation& animation, const AEVec2& playerPos, MapGrid& map, float dt)
+    {
+        if (health.dead)
+        {
+            // Advance animation until the final frame starts, then stop updating so it doesn't loop.
+            if (brain.deathTimeLeft > 0.f)
+            {
+                float tpf = animation.deathTimePerFrame;
+                if (tpf <= 0.f) tpf = 0.1f;
+
+                // Only update while we're not yet in the "last frame window"
+                if (brain.deathTimeLeft > tpf)
+                    animation.play = true;
+
+                brain.deathTimeLeft -= dt;
+                if (brain.deathTimeLeft < 0.f) brain.deathTimeLeft = 0.f;
+            }
+            if (brain.deathTimeLeft <= 0.f && cfg.hideAfterDeath)
+                brain.hidden = true;
+
+            return;
+        }
+
+        // Hurt lock: keep the HURT row visible long enough to notice (play full row once)
+        if (brain.hurtTimeLeft > 0.f)
+        {
+            brain.hurtTimeLeft -= dt;
+
+            // While hurt, stop attacking / moving and just play the hurt animation
+            attack.Reset();
+            motion.velocity = AEVec2{ 0.f, 0.f };
+            brain.chasing = false;
+
+            // Force hurt state while timer is active (prevents any override)
+            animation.nextState = cfg.animHurt;
+
+ 
+            animation.play = true;
+            return;
+        }
+
+        const float desiredStopDist =
+            (attack.startRange > 0.05f) ? (attack.startRange - 0.05f) : attack.startRange;
+
+        const float dx = playerPos.x - transform.position.x;
+        const float absDx = std::fabs(dx);
+
+        const float dy = std::fabs(playerPos.y - transform.position.y);
+        const bool yAggroOk = (dy <= cfg.aggroYRange);
+        const bool yAttackOk = (dy <= cfg.attackYRange);
+
+        // --- Guard/leash ---
+        const float playerFromHome = std::fabs(playerPos.x - brain.homePos.x);
+        const float enemyFromHome = std::fabs(transform.position.x - brain.homePos.x);
+
+        const bool inAggroRange = (absDx <= cfg.aggroRange) && yAggroOk;
+
+        // Hysteresis so we don't spam switch at the boundary
+        const float leashEnter = cfg.leashRange + 0.01f;  // when to START returning
+        const float leashExit = cfg.leashRange - 0.25f;  // when returning can be CANCELLED
+
+        if (inAggroRange)
+            brain.hadAggro = true;
+
+     
+        if (!brain.returningHome)
+        {
+            //  Always return home if walked out of leash
+            if (enemyFromHome > leashEnter)
+                brain.returningHome = true;
+
+            // Only consider playerFromHome when we are actually engaged
+            // (prevents "player far away" from freezing idle wandering)
+            if (inAggroRange && playerFromHome > leashEnter)
+                brain.returningHome = true;
+
+            // If we were engaged and now lost aggro , than enemy will go home first
+            if (!inAggroRange && brain.hadAggro)
+                brain.returningHome = true;
+        }
+        else
+        {
+            // Cancel returning only if player is back in range and both are within leash
+            if (inAggroRange && playerFromHome <= cfg.leashRange && enemyFromHome <= leashExit)
+                brain.returningHome = false;
+        }
+
+        //verical checck
+        const float attackDur = animation.attackDuration;
+        const float effectiveDist = yAttackOk ? absDx : 9999.0f;
+  
+        if (brain.returningHome)
+        {
+            // Allow attacks while returning home (no chasing)
+            if (inAggroRange)
+            {
+                if (dx != 0.f)
+                    motion.facing = AEVec2{ (dx > 0.f) ? 1.f : -1.f, 0.f };
+
+           
+           
+                attack.Update(dt, effectiveDist, attackDur);
+
+                if (attack.IsAttacking())
+                {
+                    motion.velocity = AEVec2{ 0.f, 0.f };
+                    animation.nextState = SelectAnimState(motion, health, brain, attack, cfg);
+                    animation.play = true;
+                    return;
+                }
+            }
+            else
+            {
+                attack.Reset();
+            }
+
+            brain.chasing = false;
+
+            const float eps = 0.05f;
+            const float dh = brain.homePos.x - transform.position.x;
+            const float absDh = std::fabs(dh);
+
+            motion.velocity.y = 0.f;
+
+            if (absDh <= eps)
+            {
+                transform.position.x = brain.homePos.x;
+                motion.velocity.x = 0.f;
+                brain.returningHome = false;
+
+                brain.hadAggro = false;    
+                brain.idleWalkLeft = 0.f;
+                brain.idlePauseLeft = 0.2f;
+            }
+            else
+            {
+                const float dirX = (dh > 0.f) ? 1.f : -1.f;
+                motion.facing = AEVec2{ dirX, 0.f };
+                motion.velocity.x = dirX * cfg.moveSpeed;
+
+                AEVec2 displacement;
+                AEVec2Scale(&displacement, &motion.velocity, dt);
+
+                AEVec2 nextPos = transform.position;
+                AEVec2Add(&nextPos, &transform.position, &displacement);
+
+                if (dirX > 0.f && nextPos.x > brain.homePos.x) { nextPos.x = brain.homePos.x; motion.velocity.x = 0.f; }
+                if (dirX < 0.f && nextPos.x < brain.homePos.x) { nextPos.x = brain.homePos.x; motion.velocity.x = 0.f; }
+
+                if (!HasGroundAhead(map, transform, dirX) || HasWallAhead(map, transform, dirX))
+                {
+                    nextPos.x = transform.position.x;
+                    motion.velocity.x = 0.f;
+                }
+                transform.position = nextPos;
+            }
+
+            animation.nextState = SelectAnimState(motion, health, brain, attack, cfg);
+            animation.play = true;
+            animation.emitParticles = true;
+            return;
+        }
+
+        // Update attack component (needs attack anim duration)
+        attack.Update(dt, effectiveDist, attackDur);
+
+        // If attacking, stop movement
+        if (attack.IsAttacking())
+        {
+            motion.velocity.x = 0.f;
+            motion.velocity.y = 0.f;
+            brain.chasing = false;
+        }
+        else
+        {
+            if (inAggroRange)
+            {
+                brain.chasing = (absDx > desiredStopDist);
+
+                if (dx != 0.f)
+                    motion.facing = AEVec2{ (dx > 0.f) ? 1.f : -1.f, 0.f };
+
+                if (brain.chasing)
+                {
+                    const float dirX = (dx > 0.f) ? 1.f : -1.f;
+                    motion.velocity.x = dirX * cfg.moveSpeed;
+                }
+                else
+                {
+                    motion.velocity.x = 0.f;
+                }
+
+                motion.velocity.y = 0.f;
+
+                AEVec2 displacement;
+                AEVec2Scale(&displacement, &motion.velocity, dt);
+                AEVec2 nextPos = transform.position;
+                AEVec2Add(&nextPos, &transform.position, &displacement);
+
+                if (brain.chasing)
+                {
+                    const float dirX = (dx > 0.f) ? 1.f : -1.f;
+                    if (!HasGroundAhead(map, transform, dirX) || HasWallAhead(map, transform, dirX))
+                    {
+                        nextPos.x = transform.position.x;
+                        motion.velocity.x = 0.f;
+                        brain.chasing = false;
+                    }
+                    const float targetX = playerPos.x - dirX * desiredStopDist;
+
+                    if (dirX > 0.f && nextPos.x > targetX) { nextPos.x = targetX; motion.velocity.x = 0.f; }
+                    if (dirX < 0.f && nextPos.x < targetX) { nextPos.x = targetX; motion.velocity.x = 0.f; }
+                }
+
+                const float minX = brain.homePos.x - cfg.leashRange;
+                const float maxX = brain.homePos.x + cfg.leashRange;
+
+                if (nextPos.x < minX) { nextPos.x = minX; motion.velocity.x = 0.f; }
+                if (nextPos.x > maxX) { nextPos.x = maxX; motion.velocity.x = 0.f; }
+
+                transform.position = nextPos;
+
+            }
+            else
+            {
+                brain.chasing = false;
+                motion.velocity.y = 0.f;
+
+                const float minX = brain.homePos.x - cfg.leashRange;
+                const float maxX = brain.homePos.x + cfg.leashRange;
+
+                // Pause phase
+                if (brain.idlePauseLeft > 0.f)
+                {
+                    brain.idlePauseLeft -= dt;
+                    motion.velocity.x = 0.f;
+                }
+                else
+                {
+                    // Choose / refresh a walk segment
+                    if (brain.idleWalkLeft <= 0.f)
+                    {
+                        brain.idleWalkLeft = 1.2f;           // how long to walk before pausing (tune)
+                        brain.idlePauseLeft = 0.25f;         // pause after walk (tune)
+                        brain.idleDirX = -brain.idleDirX;          // simple back-and-forth
+                    }
+
+                    const float dirX = (brain.idleDirX >= 0.f) ? 1.f : -1.f;
+                    motion.facing = AEVec2{ dirX, 0.f };
+
+                    // slower than chase looks more natural
+                    motion.velocity.x = dirX * cfg.moveSpeed * 0.35f;
+
+                    AEVec2 displacement;
+                    AEVec2Scale(&displacement, &motion.velocity, dt);
+
+                    AEVec2 nextPos = transform.position;
+                    AEVec2Add(&nextPos, &transform.position, &displacement);
+
+                    // Don’t walk off ledges
+                    if (!HasGroundAhead(map, transform, dirX) || HasWallAhead(map, transform, dirX))
+                    {
+                        nextPos.x = transform.position.x;
+                        motion.velocity.x = 0.f;
+                        brain.idleDirX = -brain.idleDirX;
+                        motion.facing = AEVec2{ brain.idleDirX >= 0.f ? 1.f : -1.f, 0.f };
+                        brain.idleWalkLeft = 0.f;
+                        brain.idlePauseLeft = 0.35f;
+                    }
+
+                    // Clamp to leash range
+                    if (nextPos.x < minX)
+                    {
+                        nextPos.x = minX;
+                        motion.velocity.x = 0.f;
+                        brain.idleDirX = 1.f;
+                        brain.idleWalkLeft = 0.f;
+                        brain.idlePauseLeft = 0.35f;
+                    }
+                    else if (nextPos.x > maxX)
+                    {
+                        nextPos.x = maxX;
+                        motion.velocity.x = 0.f;
+                        brain.idleDirX = -1.f;
+                        brain.idleWalkLeft = 0.f;
+                        brain.idlePauseLeft = 0.35f;
+                    }
+
+                    transform.position = nextPos;
+                    brain.idleWalkLeft -= dt;
+                }
+            }
+        }
+  
+        animation.nextState = SelectAnimState(motion, health, brain, attack, cfg);
+        animation.play = true;
+        animation.emitParticles = true;
+    }
+}
+
+void EnemySystems::UpdateBrains(EnemyTable& table, const AEVec2& playerPos, MapGrid& map, float dt)
+{
+    PROFILE_SCOPE("EnemySystems::UpdateBrains");
+
+    table.ForEach<Transform, Motion, Health, EnemyBrain, EnemyAttack, EnemyConfig, EnemyAnimation>(
+        [&](Transform& transform, Motion& motion, Health& health, EnemyBrain& brain, EnemyAttack& attack,
+            const EnemyConfig& cfg, EnemyAnimation& animation)
+        {
+            animation.nextState = EnemyAnimation::KEEP_STATE;
+            animation.play = false;
+            animation.emitParticles = false;
+            transform.previousPosition = transform.position;
+
+            UpdateBrain(transform, motion, health, brain, attack, cfg, animation, playerPos, map, dt);
+        });
+}
+
+void EnemySystems::UpdateVisuals(EnemyTable& table)
+{
+    PROFILE_SCOPE("EnemySystems::UpdateVisuals");
+
+    table.ForEach<EnemyAnimation, Transform, Motion, Enemy*>(
+        [](const EnemyAnimation& animation, const Transform& transform, const Motion& motion, Enemy* enemy)
+        {
+            enemy->UpdateVisuals(animation, transform, motion);
+        });
+}
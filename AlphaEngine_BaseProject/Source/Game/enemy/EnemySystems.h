@@ -0,0 +1,19 @@
+#pragma once
+#include "AEEngine.h"
+#include "EnemyComponents.h"
+
+class MapGrid;
+
+/**
+ * @brief	Updates every regular enemy at once by looping through the EnemyTable columns,
+ *			instead of each Enemy updating itself.
+ *
+ *			UpdateBrains runs the AI and movement (guard / chase / return home / idle wander, hurt and death timers)
+ *			and only writes what the sprite should do into EnemyAnimation.
+ *			UpdateVisuals then applies it to every Enemy's sprite and particles.
+ */
+namespace EnemySystems
+{
+    void UpdateBrains(EnemyTable& table, const AEVec2& playerPos, MapGrid& map, float dt);
+    void UpdateVisuals(EnemyTable& table);
+}
@@ -190,6 +190,12 @@ namespace AEExtras
 		return v /= Dist(v);
 	}
 
+	// Same as AEVec2Lerp but allows const
+	inline AEVec2 Lerp(const AEVec2& a, const AEVec2& b, float t)
+	{
+		return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+	}
+
 	inline AEVec2 Abs(const AEVec2& v)
 	{
 		return { fabsf(v.x), fabsf(v.y) };
@@ -0,0 +1,218 @@
+#include "Animator.h"
+
+#include <iostream>
+
+#include "../Game/Time.h"
+
+std::vector<Animator::Sheet> Animator::sheets;
+
+std::vector<f32> Animator::timers;
+std::vector<Animator::State> Animator::states;
+std::vector<AEVec2> Animator::uvOffsets;
+std::vector<u32> Animator::sheetIndices;
+std::vector<Animator::Handle> Animator::handles;
+
+std::vector<u32> Animator::indices;
+std::vector<Animator::Handle> Animator::freeHandles;
+
+std::vector<Animator::AnimEndEvent> Animator::animEndEvents;
+
+Animator::Handle Animator::Create(const ResourceCache::SpriteSheet& sheet)
+{
+	// Find the sheet's timings, or add them
+	u32 sheetIndex = 0;
+	while (sheetIndex < sheets.size() && sheets[sheetIndex].sheet != &sheet)
+		++sheetIndex;
+
+	if (sheetIndex == sheets.size())
+	{
+		// Reuse a slot no animator uses
+		sheetIndex = 0;
+		while (sheetIndex < sheets.size() && sheets[sheetIndex].refCount > 0)
+			++sheetIndex;
+		if (sheetIndex == sheets.size())
+			sheets.emplace_back();
+
+		Sheet& newSheet = sheets[sheetIndex];
+		newSheet.sheet = &sheet;
+		newSheet.frameUVSize = sheet.frameUVSize;
+		newSheet.states.clear();
+		for (const SpriteMetadata::StateInfo& info : sheet.metadata.stateInfoRows)
+			newSheet.states.push_back(StateTiming{ info.timePerFrame, info.frameCount, info.ifLoop });
+	}
+	++sheets[sheetIndex].refCount;
+
+	Handle handle;
+	if (freeHandles.empty())
+	{
+		handle = static_cast<Handle>(indices.size());
+		indices.push_back(0);
+	}
+	else
+	{
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+
+	indices[handle] = static_cast<u32>(timers.size());
+	timers.push_back(0.f);
+	states.emplace_back();
+	uvOffsets.push_back(AEVec2{ 0.f, 0.f });
+	sheetIndices.push_back(sheetIndex);
+	handles.push_back(handle);
+
+	return handle;
+}
+
+void Animator::Destroy(Handle handle)
+{
+	const u32 index = GetIndex(handle);
+	const u32 last = static_cast<u32>(timers.size() - 1);
+
+	// Forget the sheet once nothing uses it. ResourceCache can free it, and a new sheet
+	// allocated at the same address mustn't pick up these timings
+	Sheet& sheet = sheets[sheetIndices[index]];
+	if (--sheet.refCount == 0)
+		sheet.sheet = nullptr;
+
+	// Swap with the last to keep the arrays packed
+	timers[index] = timers[last];
+	states[index] = states[last];
+	uvOffsets[index] = uvOffsets[last];
+	sheetIndices[index] = sheetIndices[last];
+	handles[index] = handles[last];
+	indices[handles[index]] = index;
+
+	timers.pop_back();
+	states.pop_back();
+	uvOffsets.pop_back();
+	sheetIndices.pop_back();
+	handles.pop_back();
+
+	freeHandles.push_back(handle);
+}
+
+void Animator::Play(Handle handle)
+{
+	State& state = states[GetIndex(handle)];
+	if (state.queuedSteps < UINT8_MAX)
+		++state.queuedSteps;
+}
+
+void Animator::SetState(Handle handle, int nextState, bool ifLock, bool notifyAnimEnd)
+{
+	const u32 index = GetIndex(handle);
+	State& state = states[index];
+
+	if (nextState == state.currState)
+		return;
+
+	if (nextState < 0 || nextState >= static_cast<int>(sheets[sheetIndices[index]].states.size()))
+	{
+		std::cout << "[ERROR] Invalid sprite state" << std::endl;
+		return;
+	}
+
+	state.nextState = nextState;
+
+	if (state.ifLockCurrent)
+		return;
+
+	state.ifLockCurrent = ifLock;
+	state.notifyAnimEnd = notifyAnimEnd;
+
+	timers[index] = 0.f;
+	state.currState = nextState;
+	state.frame = 0;
+
+	UpdateUVOffset(index);
+}
+
+int Animator::GetState(Handle handle)
+{
+	return states[GetIndex(handle)].currState;
+}
+
+void Animator::Restart(Handle handle, int state)
+{
+	const u32 index = GetIndex(handle);
+	if (state < 0 || state >= static_cast<int>(sheets[sheetIndices[index]].states.size()))
+	{
+		std::cout << "[ERROR] Invalid sprite state" << std::endl;
+		return;
+	}
+
+	states[index] = State{ state, state };
+	timers[index] = 0.f;
+
+	UpdateUVOffset(index);
+}
+
+AEVec2 Animator::GetUVOffset(Handle handle)
+{
+	return uvOffsets[GetIndex(handle)];
+}
+
+void Animator::Update()
+{
+	animEndEvents.clear();
+
+	const f32 dt = static_cast<f32>(Time::GetInstance().GetScaledDeltaTime());
+
+	const u32 count = static_cast<u32>(timers.size());
+	for (u32 i = 0; i < count; ++i)
+	{
+		for (u8 step = 0; step < states[i].queuedSteps; ++step)
+			Step(i, dt);
+
+		states[i].queuedSteps = 0;
+	}
+}
+
+void Animator::Step(u32 index, f32 dt)
+{
+	State& state = states[index];
+	f32& timer = timers[index];
+	const StateTiming& curr = sheets[sheetIndices[index]].states[state.currState];
+
+	if (timer >= curr.timePerFrame)
+	{
+		timer -= curr.timePerFrame;
+
+		const bool onLastFrame = state.frame == (curr.frameCount - 1);
+
+		// If should change state
+		if (state.currState != state.nextState &&
+			(!state.ifLockCurrent || onLastFrame))
+		{
+			timer = 0;
+			state.frame = 0;
+			state.currState = state.nextState;
+			state.ifLockCurrent = false;
+		}
+		// Else update current animation
+		// - if ifLoop, keep repeating
+		// - else, play until it's not the last frame
+		else if (curr.ifLoop || !onLastFrame)
+			state.frame = (state.frame + 1) % curr.frameCount;
+
+		UpdateUVOffset(index);
+
+		if (onLastFrame && state.notifyAnimEnd)
+			animEndEvents.push_back(AnimEndEvent{ handles[index], state.currState });
+	}
+
+	timer += dt;
+}
+
+void Animator::UpdateUVOffset(u32 index)
+{
+	const AEVec2& frameUVSize = sheets[sheetIndices[index]].frameUVSize;
+	uvOffsets[index].x = states[index].frame * frameUVSize.x;
+	uvOffsets[index].y = states[index].currState * frameUVSize.y;
+}
+
+u32 Animator::GetIndex(Handle handle)
+{
+	return indices[handle];
+}
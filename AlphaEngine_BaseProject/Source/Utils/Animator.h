@@ -0,0 +1,127 @@
+#pragma once
+#include <vector>
+
+#include "AEEngine.h"
+#include "ResourceCache.h"
+
+/**
+ * @brief	Animation state of every Sprite, stored in contiguous arrays and advanced together in Update.
+ *			Sprites only hold a Handle. Sprite::Update queues a step for the tick instead of advancing it straight away,
+ *			so the owner still decides when it animates (e.g. Enemy stops updating on the last death frame).
+ *
+ *			Instead of a callback per sprite, reaching the last frame of a state adds an AnimEndEvent
+ *			(if SetState asked for it). Events are valid until the next Update, so owners read them in their next tick.
+ */
+class Animator
+{
+public:
+	/**
+	 * @brief	Stable id of an animator. Stays the same when other animators are destroyed
+	 */
+	using Handle = u32;
+	static constexpr Handle INVALID_HANDLE = static_cast<Handle>(-1);
+
+	struct AnimEndEvent
+	{
+		Handle animator;
+		int state;		// State that reached its last frame
+	};
+
+	/**
+	 * @brief	Adds an animator starting at state 0, frame 0
+	 */
+	static Handle Create(const ResourceCache::SpriteSheet& sheet);
+	static void Destroy(Handle handle);
+
+	/**
+	 * @brief	Queues a step for this tick's Update
+	 */
+	static void Play(Handle handle);
+
+	/**
+	 * @brief	Same rules as the old Sprite::SetState:
+	 *			Ignored if it's already the current state. If the current state is locked, it only changes after the last frame.
+	 * @param ifLock			Lock the new state until its last frame
+	 * @param notifyAnimEnd		Add an AnimEndEvent every step the state is on its last frame
+	 */
+	static void SetState(Handle handle, int nextState, bool ifLock, bool notifyAnimEnd);
+	static int GetState(Handle handle);
+
+	/**
+	 * @brief	Plays the state from the first frame, ignoring the lock. For reusing a sprite
+	 */
+	static void Restart(Handle handle, int state);
+
+	/**
+	 * @return	UV offset of the current frame from the top left of the sheet
+	 */
+	static AEVec2 GetUVOffset(Handle handle);
+
+	/**
+	 * @brief	Advances every animator that was played this tick, in 1 pass. Call once per tick after FixedUpdate,
+	 *			so the step uses the fixed delta and each anim end event is only seen by 1 tick.
+	 */
+	static void Update();
+
+	/**
+	 * @return	Anim end events from the last Update
+	 */
+	static const std::vector<AnimEndEvent>& GetAnimEndEvents() { return animEndEvents; }
+
+	static size_t GetCount() { return timers.size(); }
+
+private:
+	/**
+	 * @brief	Per state info the step needs, copied from the sheet's metadata
+	 */
+	struct StateTiming
+	{
+		f32 timePerFrame;
+		int frameCount;
+		bool ifLoop;
+	};
+
+	struct State
+	{
+		int currState = 0;
+		int nextState = 0;
+		int frame = 0;
+		u8 queuedSteps = 0;		// Number of Play calls since the last Update
+		bool ifLockCurrent = false;
+		bool notifyAnimEnd = false;
+	};
+
+	/**
+	 * @brief	Shared by every animator using the same sheet
+	 */
+	struct Sheet
+	{
+		const ResourceCache::SpriteSheet* sheet = nullptr;
+		std::vector<StateTiming> states;
+		AEVec2 frameUVSize{ 1.f, 1.f };
+		int refCount = 0;
+	};
+
+	static void Step(u32 index, f32 dt);
+	static void UpdateUVOffset(u32 index);
+	static u32 GetIndex(Handle handle);
+
+	// === Sheets ===
+	static std::vector<Sheet> sheets;
+
+	// === Per animator, indexed by dense index ===
+	static std::vector<f32> timers;
+	static std::vector<State> states;
+	static std::vector<AEVec2> uvOffsets;
+	static std::vector<u32> sheetIndices;
+	static std::vector<Handle> handles;		// Dense index -> handle
+
+	// === Handle lookup ===
+	static std::vector<u32> indices;		// Handle -> dense index
+	static std::vector<Handle> freeHandles;
+
+	static std::vector<AnimEndEvent> animEndEvents;
+
+	// Disable creating an instance. Static class
+	Animator() = delete;
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "AEEngine.h"
+
+/**
+ * @brief	Archetype table: stores entities that all have the same components.
+ *			Each component type is its own contiguous array (column), so a system that loops through
+ *			a few components with ForEach only touches those arrays instead of every object.
+ *
+ *			Rows are referred to with an Entity, which stays the same when other rows are destroyed.
+ *			Destroying moves the last row into its place (same as Animator), so the row order isn't kept.
+ *
+ * @tparam Components	Component types. Each type can only be used once per table
+ *
+ * @warning	References to components are invalidated by Create / Destroy. Store the Entity instead.
+ */
+template <typename... Components>
+class ComponentTable
+{
+public:
+	/**
+	 * @brief	Refers to a row. Default constructed entities are invalid
+	 */
+	struct Entity
+	{
+		u32 index = static_cast<u32>(-1);
+		u32 generation = 0;
+
+		bool operator==(const Entity&) const = default;
+	};
+
+	/**
+	 * @brief	Adds a row with every component
+	 */
+	Entity Create(Components... components);
+	/**
+	 * @brief	Removes the row. Does nothing if the entity is already destroyed
+	 */
+	void Destroy(Entity entity);
+	bool IsAlive(Entity entity) const;
+	void Clear();
+	void Reserve(size_t count);
+
+	size_t GetCount() const { return rowEntities.size(); }
+
+	template <typename T>
+	T& Get(Entity entity) { return Column<T>()[slots[entity.index].row]; }
+	template <typename T>
+	const T& Get(Entity entity) const { return Column<T>()[slots[entity.index].row]; }
+
+	/**
+	 * @return	Every component of type T, indexed by row
+	 */
+	template <typename T>
+	std::vector<T>& Column() { return std::get<std::vector<T>>(columns); }
+	template <typename T>
+	const std::vector<T>& Column() const { return std::get<std::vector<T>>(columns); }
+
+	Entity GetEntity(size_t row) const { return rowEntities[row]; }
+
+	/**
+	 * @brief	Calls fn(T&...) for every row, in row order. e.g. table.ForEach<Transform, Motion>([](Transform& t, Motion& m) {...});
+	 * @warning	Don't Create / Destroy in fn
+	 */
+	template <typename... Ts, typename Fn>
+	void ForEach(Fn&& fn);
+
+private:
+	struct Slot
+	{
+		u32 row = 0;
+		u32 generation = 1;		// Odd when free, even when used
+	};
+
+	std::tuple<std::vector<Components>...> columns;
+	std::vector<Entity> rowEntities;	// Row -> entity
+
+	std::vector<Slot> slots;			// Entity index -> row
+	std::vector<u32> freeSlots;
+};
+
+template <typename... Components>
+inline typename ComponentTable<Components...>::Entity ComponentTable<Components...>::Create(Components... components)
+{
+	u32 index;
+	if (freeSlots.empty())
+	{
+		index = static_cast<u32>(slots.size());
+		slots.emplace_back();
+	}
+	else
+	{
+		index = freeSlots.back();
+		freeSlots.pop_back();
+	}
+
+	Slot& slot = slots[index];
+	++slot.generation;
+	slot.row = static_cast<u32>(rowEntities.size());
+
+	(Column<Components>().push_back(std::move(components)), ...);
+
+	const Entity entity{ index, slot.generation };
+	rowEntities.push_back(entity);
+	return entity;
+}
+
+template <typename... Components>
+inline void ComponentTable<Components...>::Destroy(Entity entity)
+{
+	if (!IsAlive(entity))
+		return;
+
+	Slot& slot = slots[entity.index];
+	const u32 row = slot.row;
+	const u32 lastRow = static_cast<u32>(rowEntities.size() - 1);
+
+	// Move the last row into the destroyed row
+	if (row != lastRow)
+	{
+		((Column<Components>()[row] = std::move(Column<Components>()[lastRow])), ...);
+		rowEntities[row] = rowEntities[lastRow];
+		slots[rowEntities[row].index].row = row;
+	}
+
+	(Column<Components>().pop_back(), ...);
+	rowEntities.pop_back();
+
+	++slot.generation;
+	freeSlots.push_back(entity.index);
+}
+
+template <typename... Components>
+inline bool ComponentTable<Components...>::IsAlive(Entity entity) const
+{
+	return entity.index < slots.size() && slots[entity.index].generation == entity.generation;
+}
+
+template <typename... Components>
+inline void ComponentTable<Components...>::Clear()
+{
+	while (!rowEntities.empty())
+		Destroy(rowEntities.back());
+}
+
+template <typename... Components>
+inline void ComponentTable<Components...>::Reserve(size_t count)
+{
+	(Column<Components>().reserve(count), ...);
+	rowEntities.reserve(count);
+	slots.reserve(count);
+}
+
+template <typename... Components>
+template <typename... Ts, typename Fn>
+inline void ComponentTable<Components...>::ForEach(Fn&& fn)
+{
+	const size_t count = rowEntities.size();
+	auto selected = std::tie(Column<Ts>()...);
+	for (size_t row = 0; row < count; ++row)
+		fn(std::get<std::vector<Ts>&>(selected)[row]...);
+}
@@ -0,0 +1,38 @@
+#include "DebugDraw.h"
+
+#include "QuickGraphics.h"
+
+std::vector<DebugDraw::Command> DebugDraw::commands;
+
+void DebugDraw::AddRect(const AEVec2& position, const AEVec2& scale, u32 color, AEGfxMeshDrawMode drawMode)
+{
+	commands.push_back(Command{ Command::Type::RECT, position, scale, 0.f, color, drawMode });
+}
+
+void DebugDraw::AddRay(const AEVec2& start, const AEVec2& end, float width, u32 color)
+{
+	commands.push_back(Command{ Command::Type::RAY, start, end, width, color, AE_GFX_MDM_TRIANGLES });
+}
+
+void DebugDraw::Flush()
+{
+	for (const Command& command : commands)
+	{
+		switch (command.type)
+		{
+		case Command::Type::RECT:
+			QuickGraphics::DrawRect(command.a, command.b, command.color, command.drawMode);
+			break;
+		case Command::Type::RAY:
+			QuickGraphics::DrawRay(command.a, command.b, command.width, command.color);
+			break;
+		}
+	}
+
+	Clear();
+}
+
+void DebugDraw::Clear()
+{
+	commands.clear();
+}
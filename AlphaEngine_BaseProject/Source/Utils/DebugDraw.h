@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+
+#include "AEEngine.h"
+
+/**
+ * @brief	Debug shapes (colliders, raycasts) recorded during update and drawn later.
+ *			Lets physics code record shapes without calling the renderer in the middle of its loops.
+ *			Drawn on top of the scene and cleared every frame by Editor::DrawDebugShapes.
+ */
+class DebugDraw
+{
+public:
+	struct Command
+	{
+		enum class Type : u8
+		{
+			RECT,
+			RAY,
+		};
+
+		Type type;
+		AEVec2 a;					// Rect: position. Ray: start
+		AEVec2 b;					// Rect: scale. Ray: end
+		float width;				// Ray only
+		u32 color;
+		AEGfxMeshDrawMode drawMode;	// Rect only
+	};
+
+	// Same parameters as QuickGraphics::DrawRect / DrawRay
+	static void AddRect(const AEVec2& position, const AEVec2& scale, u32 color = 0xFFFFFFFF, AEGfxMeshDrawMode drawMode = AE_GFX_MDM_TRIANGLES);
+	static void AddRay(const AEVec2& start, const AEVec2& end, float width = 0.1f, u32 color = 0xFFFFFFFF);
+
+	/**
+	 * @brief	Draws every command with QuickGraphics, then clears them
+	 */
+	static void Flush();
+	static void Clear();
+
+	static const std::vector<Command>& GetCommands() { return commands; }
+
+private:
+	static std::vector<Command> commands;
+
+	// Disable creating an instance. Static class
+	DebugDraw() = delete;
+};
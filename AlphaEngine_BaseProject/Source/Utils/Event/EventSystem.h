@@ -1,24 +1,46 @@
 #pragma once
 
-#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "InplaceFunction.h"
 
 using EventId = unsigned long;
 
+/**
+ * @brief	Every event type T has its own listener list, stored as 1 contiguous array that Trigger loops through in subscribe order.
+ *
+ *			Subscribing / unsubscribing / clearing during a Trigger is allowed (e.g. subscribing to another event in a listener).
+ *			Unsubscribed listeners are skipped, new listeners are only called from the next Trigger.
+ *
+ *			Queue is the deferred version of Trigger: the event is stored and only sent in FlushQueued,
+ *			which GSM calls once a frame after the scene's Update. Use it for events fired in the middle of
+ *			looping through objects (e.g. damage during collision checks).
+ */
 class EventSystem
 {
 public:
+	template<typename T>
+	using Callback = InplaceFunction<void(const T&)>;
+
 	/**
 	 * @brief			Subscribes a callback function to a specific event type
 	 * @tparam T		The unique event type used for identification and callback data
-	 * @param callback	Function executed when event T occurs. Receives T as data.
+	 * @param callback	Function executed when event T occurs. Receives T as data. Stored without allocating, see InplaceFunction
 	 * @return			Return a EventId which is used to unsubcribe. Store this!
 	 */
-	template<typename T>
-	static EventId Subscribe(std::function<void(const T&)> callback)
+	template<typename T, typename Fn>
+	static EventId Subscribe(Fn&& callback)
 	{
+		Listeners<T>& listeners = GetListeners<T>();
 		EventId id = nextId++;
-		auto& listeners = GetListeners<T>();
-		listeners.emplace(id, callback);
+
+		// Don't grow the array that's being looped through, add it after the Trigger
+		std::vector<Listener<T>>& target = listeners.triggerDepth > 0 ? listeners.pending : listeners.active;
+		target.push_back({ id, Callback<T>(std::forward<Fn>(callback)) });
 		return id;
 	}
 
@@ -30,41 +52,184 @@ public:
 	template<typename T>
 	static void Unsubscribe(EventId id)
 	{
-		GetListeners<T>().erase(id);
+		Listeners<T>& listeners = GetListeners<T>();
+
+		auto isId = [id](const Listener<T>& listener) { return listener.id == id; };
+		std::erase_if(listeners.pending, isId);
+
+		auto it = std::find_if(listeners.active.begin(), listeners.active.end(), isId);
+		if (it == listeners.active.end())
+			return;
+
+		if (listeners.triggerDepth > 0)
+		{
+			// Can't move the array while it's looped through (or destroy the callback, it might be the one running).
+			// Trigger skips it and removes it after
+			it->isRemoved = true;
+			listeners.hasRemoved = true;
+		}
+		else
+			listeners.active.erase(it);
 	}
 
 	/**
 	 * @brief		Invokes all registered callbacks for a specific event type
 	 * @tparam T	Event Type and data type that's passed into the event listeners
 	 * @param data	The event data to pass to the listeners
-	 * @warning		Doesn't support Subscribing/Unsubscribing during trigger
 	 */
 	template<typename T>
 	static void Trigger(const T& data)
 	{
-		auto& listeners = GetListeners<T>();
+		Listeners<T>& listeners = GetListeners<T>();
+
+		++listeners.triggerDepth;
+		// Index instead of iterators, nested Triggers of the same type might remove from the array
+		for (size_t i = 0; i < listeners.active.size(); ++i)
+		{
+			if (!listeners.active[i].isRemoved)
+				listeners.active[i].callback(data);
+		}
+		--listeners.triggerDepth;
+
+		if (listeners.triggerDepth == 0)
+			listeners.ApplyChanges();
+	}
+
+	/**
+	 * @brief		Stores the event and triggers it in the next FlushQueued
+	 * @tparam T	Event Type and data type that's passed into the event listeners. Copied into the queue
+	 * @param data	The event data to pass to the listeners
+	 */
+	template<typename T>
+	static void Queue(const T& data)
+	{
+		static bool isRegistered = false;
+		if (!isRegistered)
+		{
+			flushFunctions.push_back(&FlushQueue<T>);
+			isRegistered = true;
+		}
+
+		GetQueue<T>().push_back(data);
+	}
+
+	/**
+	 * @brief	Triggers every queued event, 1 event type at a time in the order the types were first queued.
+	 *			Events queued by the listeners are also sent before returning.
+	 */
+	static void FlushQueued()
+	{
+		constexpr int MAX_PASSES = 16;
+		for (int pass = 0; pass < MAX_PASSES; ++pass)
+		{
+			bool hasFlushed = false;
+			// Index, in case a listener queues a new event type
+			for (size_t i = 0; i < flushFunctions.size(); ++i)
+				hasFlushed |= flushFunctions[i]();
 
-		for (auto& [id, callback] : listeners)
-			callback(data);
+			if (!hasFlushed)
+				return;
+		}
+
+		std::cout << "EventSystem::FlushQueued - Events still queued after " << MAX_PASSES << " passes, listeners might be queueing each other\n";
 	}
 
 	/**
-	 * @brief		Removes all subscribers for a specific event type
-	 * @tparam T	The event identifier type to clear 
+	 * @brief		Removes all subscribers and queued events for a specific event type
+	 * @tparam T	The event identifier type to clear
 	 */
 	template<typename T>
 	static void Clear()
 	{
-		GetListeners<T>().clear();
+		Listeners<T>& listeners = GetListeners<T>();
+		listeners.pending.clear();
+		GetQueue<T>().clear();
+
+		if (listeners.triggerDepth > 0)
+		{
+			for (Listener<T>& listener : listeners.active)
+				listener.isRemoved = true;
+			listeners.hasRemoved = true;
+		}
+		else
+			listeners.active.clear();
 	}
 
 private:
 	template<typename T>
-	static std::unordered_map<EventId, std::function<void(const T&)>>& GetListeners()
+	struct Listener
+	{
+		EventId id;
+		Callback<T> callback;
+		bool isRemoved = false;	// Unsubscribed during a Trigger
+	};
+
+	template<typename T>
+	struct Listeners
+	{
+		std::vector<Listener<T>> active;
+		std::vector<Listener<T>> pending;	// Subscribed during a Trigger
+		int triggerDepth = 0;
+		bool hasRemoved = false;
+
+		/**
+		 * @brief	Applies the subscribes / unsubscribes from the last Trigger
+		 */
+		void ApplyChanges()
+		{
+			if (hasRemoved)
+			{
+				std::erase_if(active, [](const Listener<T>& listener) { return listener.isRemoved; });
+				hasRemoved = false;
+			}
+
+			if (!pending.empty())
+			{
+				std::move(pending.begin(), pending.end(), std::back_inserter(active));
+				pending.clear();
+			}
+		}
+	};
+
+	template<typename T>
+	static Listeners<T>& GetListeners()
 	{
-		static std::unordered_map<EventId, std::function<void(const T&)>> listeners;
+		static Listeners<T> listeners;
 		return listeners;
 	}
 
+	template<typename T>
+	static std::vector<T>& GetQueue()
+	{
+		static std::vector<T> queue;
+		return queue;
+	}
+
+	/**
+	 * @return	If any event was triggered
+	 */
+	template<typename T>
+	static bool FlushQueue()
+	{
+		std::vector<T>& queue = GetQueue<T>();
+		if (queue.empty())
+			return false;
+
+		// Swap out so listeners can queue more without invalidating the loop. Swapped back after to keep the capacity
+		std::vector<T> batch;
+		batch.swap(queue);
+		for (const T& data : batch)
+			Trigger(data);
+
+		if (queue.empty())
+		{
+			batch.clear();
+			queue.swap(batch);
+		}
+
+		return true;
+	}
+
 	inline static EventId nextId = 0;
+	inline static std::vector<bool(*)()> flushFunctions;
 };
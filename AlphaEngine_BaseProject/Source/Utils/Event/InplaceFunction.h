@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template<typename Signature, size_t CAPACITY = 32>
+class InplaceFunction;
+
+/**
+ * @brief	Like std::function, but the callable is always stored inside the object, never on the heap.
+ *			Callables bigger than CAPACITY don't compile, capture pointers / small values instead of containers.
+ *			Move only, so copying a listener list doesn't copy every capture.
+ *
+ * @tparam CAPACITY	Bytes for the callable. 32 fits a lambda capturing `this` and a few values
+ */
+template<typename R, typename... Args, size_t CAPACITY>
+class InplaceFunction<R(Args...), CAPACITY>
+{
+public:
+	InplaceFunction() = default;
+
+	template<typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, InplaceFunction>>>
+	InplaceFunction(Fn&& fn)
+	{
+		using Callable = std::decay_t<Fn>;
+		static_assert(sizeof(Callable) <= CAPACITY, "Callable is too big for InplaceFunction, capture less or raise CAPACITY");
+		static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over aligned");
+		static_assert(std::is_nothrow_move_constructible_v<Callable>, "Callable must be nothrow movable");
+
+		new (storage) Callable(std::forward<Fn>(fn));
+		ops = &OpsFor<Callable>::ops;
+	}
+
+	InplaceFunction(InplaceFunction&& other) noexcept
+	{
+		MoveFrom(other);
+	}
+
+	InplaceFunction& operator=(InplaceFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	InplaceFunction(const InplaceFunction&) = delete;
+	InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+	~InplaceFunction()
+	{
+		Reset();
+	}
+
+	R operator()(Args... args) const
+	{
+		return ops->invoke(storage, std::forward<Args>(args)...);
+	}
+
+	explicit operator bool() const { return ops != nullptr; }
+
+	/**
+	 * @brief	Destroys the callable, becomes empty
+	 */
+	void Reset()
+	{
+		if (!ops)
+			return;
+
+		ops->destroy(storage);
+		ops = nullptr;
+	}
+
+private:
+	struct Ops
+	{
+		R(*invoke)(void*, Args&&...);
+		void(*move)(void* dst, void* src);		// Move constructs dst from src and destroys src
+		void(*destroy)(void*);
+	};
+
+	template<typename Callable>
+	struct OpsFor
+	{
+		static R Invoke(void* p, Args&&... args) { return (*static_cast<Callable*>(p))(std::forward<Args>(args)...); }
+		static void Move(void* dst, void* src)
+		{
+			new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+			static_cast<Callable*>(src)->~Callable();
+		}
+		static void Destroy(void* p) { static_cast<Callable*>(p)->~Callable(); }
+
+		static constexpr Ops ops{ &Invoke, &Move, &Destroy };
+	};
+
+	void MoveFrom(InplaceFunction& other)
+	{
+		if (!other.ops)
+			return;
+
+		other.ops->move(storage, other.storage);
+		ops = other.ops;
+		other.ops = nullptr;
+	}
+
+	alignas(std::max_align_t) mutable std::byte storage[CAPACITY];
+	const Ops* ops = nullptr;
+};
@@ -0,0 +1,85 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+
+FrameArena::FrameResource FrameArena::frameResource;
+FrameArena::HeapResource FrameArena::heapResource;
+std::optional<std::pmr::monotonic_buffer_resource> FrameArena::arena;
+std::unique_ptr<std::byte[]> FrameArena::buffer;
+size_t FrameArena::capacity = 0;
+size_t FrameArena::peakBytes = 0;
+u32 FrameArena::overflowFrames = 0;
+
+FrameArena::Stats FrameArena::frameStats;
+FrameArena::Stats FrameArena::lastFrameStats;
+
+void FrameArena::Reset()
+{
+	lastFrameStats = frameStats;
+	frameStats = Stats{};
+
+	if (lastFrameStats.heapAllocations > 0)
+		++overflowFrames;
+
+	if (!arena || lastFrameStats.heapAllocations > 0)
+	{
+		// Grow to fit the biggest frame so far, with some room for alignment
+		size_t newCapacity = (std::max)(capacity, DEFAULT_CAPACITY);
+		while (newCapacity < peakBytes + peakBytes / 4)
+			newCapacity *= 2;
+
+		if (newCapacity != capacity || !buffer)
+		{
+			arena.reset();
+			buffer = std::make_unique<std::byte[]>(newCapacity);
+			capacity = newCapacity;
+		}
+	}
+
+	CreateArena();
+}
+
+std::pmr::memory_resource* FrameArena::GetResource()
+{
+	if (!arena)
+		Reset();
+
+	return &frameResource;
+}
+
+void FrameArena::Clear()
+{
+	arena.reset();
+	buffer.reset();
+	capacity = 0;
+	peakBytes = 0;
+	overflowFrames = 0;
+	frameStats = lastFrameStats = Stats{};
+}
+
+void FrameArena::CreateArena()
+{
+	// Recreated instead of release() so it starts from the start of the buffer again
+	arena.reset();
+	arena.emplace(buffer.get(), capacity, &heapResource);
+}
+
+void* FrameArena::FrameResource::do_allocate(size_t bytes, size_t alignment)
+{
+	++frameStats.allocations;
+	frameStats.bytes += bytes;
+	peakBytes = (std::max)(peakBytes, frameStats.bytes);
+
+	return arena->allocate(bytes, alignment);
+}
+
+void* FrameArena::HeapResource::do_allocate(size_t bytes, size_t alignment)
+{
+	++frameStats.heapAllocations;
+	return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::HeapResource::do_deallocate(void* p, size_t bytes, size_t alignment)
+{
+	std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "AEEngine.h"
+
+/**
+ * @brief	Bump allocator for data that only lives for 1 frame (temporary lists, debug text).
+ *			Everything allocated from it is freed at once in Reset, called by the GSM at the start of every frame.
+ *			Use it through std::pmr containers: FrameArena::Vector<T> / FrameArena::String.
+ *
+ *			If a frame uses more than the buffer, the rest comes from the heap (counted in Stats::heapAllocations)
+ *			and the buffer grows on the next Reset, so steady state frames don't touch the heap.
+ *
+ * @warning	Don't keep anything from it past the end of the frame (e.g. as a member).
+ */
+class FrameArena
+{
+public:
+	template <typename T>
+	using Vector = std::pmr::vector<T>;
+	using String = std::pmr::string;
+
+	struct Stats
+	{
+		u32 allocations = 0;		// Allocations made from the arena
+		u32 heapAllocations = 0;	// Allocations the buffer couldn't fit, should be 0 after the first few frames
+		size_t bytes = 0;			// Bytes requested from the arena
+	};
+
+	/**
+	 * @brief	Frees everything allocated this frame, grows the buffer if it overflowed
+	 */
+	static void Reset();
+
+	static std::pmr::memory_resource* GetResource();
+
+	/**
+	 * @return	Empty vector allocating from the arena
+	 */
+	template <typename T>
+	static Vector<T> MakeVector() { return Vector<T>(GetResource()); }
+
+	/**
+	 * @brief	printf into a string allocating from the arena
+	 */
+	template <typename... Args>
+	static String Format(const char* format, Args... args)
+	{
+		const int length = std::snprintf(nullptr, 0, format, args...);
+		String str(length > 0 ? static_cast<size_t>(length) : 0, '\0', GetResource());
+		if (length > 0)
+			std::snprintf(str.data(), str.size() + 1, format, args...);
+		return str;
+	}
+
+	/**
+	 * @return	Stats of the current frame so far
+	 */
+	static const Stats& GetFrameStats() { return frameStats; }
+	/**
+	 * @return	Stats of the previous frame, since the current one resets on Reset
+	 */
+	static const Stats& GetLastFrameStats() { return lastFrameStats; }
+	/**
+	 * @return	Number of frames that had to use the heap. Stops increasing once the buffer fits every frame
+	 */
+	static u32 GetOverflowFrameCount() { return overflowFrames; }
+	static size_t GetPeakBytes() { return peakBytes; }
+	static size_t GetCapacity() { return capacity; }
+
+	/**
+	 * @brief	Frees the buffer. Call before AlphaEngine exits.
+	 */
+	static void Clear();
+
+private:
+	/**
+	 * @brief	Counts what the game allocates from the arena
+	 */
+	class FrameResource : public std::pmr::memory_resource
+	{
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void*, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	/**
+	 * @brief	Where the arena gets memory when the buffer is full. Counts the heap allocations
+	 */
+	class HeapResource : public std::pmr::memory_resource
+	{
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	static void CreateArena();
+
+	static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+	static FrameResource frameResource;
+	static HeapResource heapResource;
+	static std::optional<std::pmr::monotonic_buffer_resource> arena;
+	static std::unique_ptr<std::byte[]> buffer;
+	static size_t capacity;
+	static size_t peakBytes;
+	static u32 overflowFrames;
+
+	static Stats frameStats;
+	static Stats lastFrameStats;
+
+	// Disable creating an instance. Static class
+	FrameArena() = delete;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+#include "AEEngine.h"
+
+/**
+ * @brief	Read only memory mapped file.
+ *			The OS pages the file in when it's read, no copy into a buffer.
+ *			Unmapped in the destructor.
+ */
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * @brief	Maps the whole file. Closes the previously opened file.
+	 * @return	True if the file was mapped
+	 */
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return data != nullptr; }
+	const u8* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+private:
+	const u8* data = nullptr;
+	size_t size = 0;
+
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
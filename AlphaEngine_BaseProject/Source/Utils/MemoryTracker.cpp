@@ -0,0 +1,240 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace
+{
+	constexpr int TAG_COUNT = static_cast<int>(MemoryTag::Count);
+
+	/**
+	 * @brief	Stored right before the memory returned to the caller
+	 */
+	struct Header
+	{
+		void* base;			// What malloc returned
+		size_t size;		// Size the caller asked for
+		MemoryTag tag;
+	};
+
+	struct TagCounters
+	{
+		std::atomic<s64> liveBytes;
+		std::atomic<s64> liveAllocations;
+		std::atomic<s64> peakBytes;
+		std::atomic<u64> totalAllocations;
+		std::atomic<u32> frameAllocations;
+		std::atomic<u32> lastFrameAllocations;
+		std::atomic<u32> peakFrameAllocations;
+	};
+
+	// Zero initialized before any constructor runs, so allocations from other static constructors are safe to count
+	TagCounters counters[TAG_COUNT];
+	std::atomic<s64> totalLiveBytes;
+	std::atomic<s64> totalPeakBytes;
+
+	thread_local MemoryTag currentTag = MemoryTag::Other;
+
+	template <typename T>
+	void UpdateMax(std::atomic<T>& max, T value)
+	{
+		T current = max.load(std::memory_order_relaxed);
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+			;
+	}
+}
+
+MemoryTracker::Scope::Scope(MemoryTag tag) : previous(currentTag)
+{
+	currentTag = tag;
+}
+
+MemoryTracker::Scope::~Scope()
+{
+	currentTag = previous;
+}
+
+void MemoryTracker::BeginFrame()
+{
+	for (TagCounters& tag : counters)
+	{
+		const u32 frameAllocations = tag.frameAllocations.exchange(0, std::memory_order_relaxed);
+		tag.lastFrameAllocations.store(frameAllocations, std::memory_order_relaxed);
+		UpdateMax(tag.peakFrameAllocations, frameAllocations);
+	}
+}
+
+MemoryTracker::TagStats MemoryTracker::GetStats(MemoryTag tag)
+{
+	const TagCounters& counter = counters[static_cast<int>(tag)];
+
+	TagStats stats;
+	stats.liveBytes = counter.liveBytes.load(std::memory_order_relaxed);
+	stats.liveAllocations = counter.liveAllocations.load(std::memory_order_relaxed);
+	stats.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+	stats.totalAllocations = counter.totalAllocations.load(std::memory_order_relaxed);
+	stats.lastFrameAllocations = counter.lastFrameAllocations.load(std::memory_order_relaxed);
+	stats.peakFrameAllocations = counter.peakFrameAllocations.load(std::memory_order_relaxed);
+	return stats;
+}
+
+MemoryTracker::TagStats MemoryTracker::GetTotalStats()
+{
+	TagStats total;
+	for (int i = 0; i < TAG_COUNT; ++i)
+	{
+		const TagStats stats = GetStats(static_cast<MemoryTag>(i));
+		total.liveAllocations += stats.liveAllocations;
+		total.totalAllocations += stats.totalAllocations;
+		total.lastFrameAllocations += stats.lastFrameAllocations;
+		total.peakFrameAllocations += stats.peakFrameAllocations;
+	}
+
+	// Tags peak at different times, so the total peak is tracked separately
+	total.liveBytes = totalLiveBytes.load(std::memory_order_relaxed);
+	total.peakBytes = totalPeakBytes.load(std::memory_order_relaxed);
+	return total;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+	switch (tag)
+	{
+	case MemoryTag::Other:		return "Other";
+	case MemoryTag::Player:		return "Player";
+	case MemoryTag::Enemies:	return "Enemies";
+	case MemoryTag::Particles:	return "Particles";
+	case MemoryTag::UI:			return "UI";
+	case MemoryTag::Audio:		return "Audio";
+	case MemoryTag::Editor:		return "Editor";
+	default:					return "Unknown";
+	}
+}
+
+void MemoryTracker::ResetPeaks()
+{
+	for (TagCounters& tag : counters)
+	{
+		tag.peakBytes.store(tag.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		tag.peakFrameAllocations.store(0, std::memory_order_relaxed);
+	}
+	totalPeakBytes.store(totalLiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void MemoryTracker::Dump(std::ostream& out)
+{
+	if (!IsEnabled())
+	{
+		out << "[Memory] Tracking is compiled out (MEMORY_TRACKER_ENABLED 0)\n";
+		return;
+	}
+
+	auto printRow = [&out](const char* name, const TagStats& stats)
+		{
+			out << "  " << std::left << std::setw(10) << name << std::right
+				<< std::setw(12) << stats.liveBytes / 1024.0
+				<< std::setw(12) << stats.peakBytes / 1024.0
+				<< std::setw(10) << stats.liveAllocations
+				<< std::setw(12) << stats.totalAllocations
+				<< std::setw(8) << stats.lastFrameAllocations
+				<< std::setw(8) << stats.peakFrameAllocations << "\n";
+		};
+
+	const std::ios::fmtflags flags = out.flags();
+	const std::streamsize precision = out.precision();
+	out << std::fixed << std::setprecision(1);
+
+	out << "[Memory]\n"
+		<< "  " << std::left << std::setw(10) << "tag" << std::right
+		<< std::setw(12) << "live KB" << std::setw(12) << "peak KB"
+		<< std::setw(10) << "live" << std::setw(12) << "allocs"
+		<< std::setw(8) << "frame" << std::setw(8) << "max" << "\n";
+
+	for (int i = 0; i < TAG_COUNT; ++i)
+		printRow(GetTagName(static_cast<MemoryTag>(i)), GetStats(static_cast<MemoryTag>(i)));
+	printRow("Total", GetTotalStats());
+
+	out.flags(flags);
+	out.precision(precision);
+}
+
+void* MemoryTracker::Allocate(size_t size, size_t alignment, bool isNoThrow)
+{
+	if (alignment < alignof(std::max_align_t))
+		alignment = alignof(std::max_align_t);
+
+	void* base = std::malloc(size + sizeof(Header) + alignment - 1);
+	if (!base)
+	{
+		if (isNoThrow)
+			return nullptr;
+		throw std::bad_alloc();
+	}
+
+	// Align the caller's memory, leaving space for the header in front
+	const uintptr_t address = (reinterpret_cast<uintptr_t>(base) + sizeof(Header) + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	void* ptr = reinterpret_cast<void*>(address);
+
+	const MemoryTag tag = currentTag;
+	new (reinterpret_cast<Header*>(ptr) - 1) Header{ base, size, tag };
+
+	const s64 bytes = static_cast<s64>(size);
+	TagCounters& counter = counters[static_cast<int>(tag)];
+	const s64 liveBytes = counter.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	counter.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	counter.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+	counter.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+	UpdateMax(counter.peakBytes, liveBytes);
+
+	UpdateMax(totalPeakBytes, totalLiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+	return ptr;
+}
+
+void MemoryTracker::Free(void* ptr)
+{
+	if (!ptr)
+		return;
+
+	const Header& header = *(reinterpret_cast<Header*>(ptr) - 1);
+
+	// Counted under the tag it was allocated with, wherever it's freed
+	const s64 bytes = static_cast<s64>(header.size);
+	TagCounters& counter = counters[static_cast<int>(header.tag)];
+	counter.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+	counter.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	totalLiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+
+	std::free(header.base);
+}
+
+#if MEMORY_TRACKER_ENABLED
+// ===== Global operator new / delete replacements =====
+// All forms are replaced so memory never goes to a delete that doesn't know about the header
+
+void* operator new(size_t size) { return MemoryTracker::Allocate(size, alignof(std::max_align_t), false); }
+void* operator new[](size_t size) { return MemoryTracker::Allocate(size, alignof(std::max_align_t), false); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return MemoryTracker::Allocate(size, alignof(std::max_align_t), true); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return MemoryTracker::Allocate(size, alignof(std::max_align_t), true); }
+void* operator new(size_t size, std::align_val_t alignment) { return MemoryTracker::Allocate(size, (size_t)alignment, false); }
+void* operator new[](size_t size, std::align_val_t alignment) { return MemoryTracker::Allocate(size, (size_t)alignment, false); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return MemoryTracker::Allocate(size, (size_t)alignment, true); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return MemoryTracker::Allocate(size, (size_t)alignment, true); }
+
+void operator delete(void* ptr) noexcept { MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr) noexcept { MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { MemoryTracker::Free(ptr); }
+#endif
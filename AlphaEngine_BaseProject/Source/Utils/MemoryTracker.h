@@ -0,0 +1,109 @@
+#pragma once
+#include <iostream>
+
+#include "AEEngine.h"
+
+// Set to 0 to use the default operator new / delete and compile out the scopes
+#ifndef MEMORY_TRACKER_ENABLED
+#define MEMORY_TRACKER_ENABLED 1
+#endif
+
+#define MEMORY_TRACKER_CONCAT_IMPL(a, b) a##b
+#define MEMORY_TRACKER_CONCAT(a, b) MEMORY_TRACKER_CONCAT_IMPL(a, b)
+
+#if MEMORY_TRACKER_ENABLED
+/**
+ * @brief	Counts every allocation in the rest of the current scope under the tag,
+ *			until a nested scope changes it. e.g. MEMORY_SCOPE(Player);
+ */
+#define MEMORY_SCOPE(tag) MemoryTracker::Scope MEMORY_TRACKER_CONCAT(memoryScope, __LINE__)(MemoryTag::tag)
+#else
+#define MEMORY_SCOPE(tag) ((void)0)
+#endif
+
+/**
+ * @brief	Subsystem an allocation is counted under
+ */
+enum class MemoryTag : u8
+{
+	Other,		// Not in any scope
+	Player,
+	Enemies,
+	Particles,
+	UI,
+	Audio,
+	Editor,		// Editor and level editor scene
+
+	Count
+};
+
+/**
+ * @brief	Counts the heap memory of every subsystem by replacing the global operator new / delete.
+ *			Each allocation stores its size and tag in a small header, so delete can take it off the right tag.
+ *			Allocations are tagged by the innermost MEMORY_SCOPE on the allocating thread.
+ *
+ *			The GSM prints how much memory every scene left behind after it's unloaded (leaks / things cached on purpose),
+ *			the editor's Debug menu and HeadlessBenchmark --memory print the full table.
+ *
+ * @note	Only counts operator new (containers, make_unique...). Memory from malloc or AlphaEngine isn't counted.
+ */
+class MemoryTracker
+{
+public:
+	struct TagStats
+	{
+		s64 liveBytes = 0;
+		s64 liveAllocations = 0;
+		s64 peakBytes = 0;				// Since the last ResetPeaks
+		u64 totalAllocations = 0;
+		u32 lastFrameAllocations = 0;	// Allocations in the last frame, see BeginFrame
+		u32 peakFrameAllocations = 0;	// Most allocations in 1 frame since the last ResetPeaks
+	};
+
+	/**
+	 * @brief	Sets the tag for the current thread. Use MEMORY_SCOPE instead of creating directly.
+	 */
+	class Scope
+	{
+	public:
+		explicit Scope(MemoryTag tag);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		MemoryTag previous;
+	};
+
+	/**
+	 * @brief	Ends the frame's allocation count. Called by the GSM at the start of every frame.
+	 */
+	static void BeginFrame();
+
+	static TagStats GetStats(MemoryTag tag);
+	/**
+	 * @return	Every tag added together
+	 */
+	static TagStats GetTotalStats();
+	static const char* GetTagName(MemoryTag tag);
+
+	/**
+	 * @brief	Sets the peaks to the current values, to find the peak of a scene / level
+	 */
+	static void ResetPeaks();
+
+	/**
+	 * @brief	Prints a table of every tag
+	 */
+	static void Dump(std::ostream& out = std::cout);
+
+	static constexpr bool IsEnabled() { return MEMORY_TRACKER_ENABLED; }
+
+	// Used by the operator new / delete replacements
+	static void* Allocate(size_t size, size_t alignment, bool isNoThrow);
+	static void Free(void* ptr);
+
+	// Disable creating an instance. Static class
+	MemoryTracker() = delete;
+};
@@ -1,151 +1,291 @@
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
-/**
- * @brief Abstract Object Pool class
- */
-class ObjectPoolItem
-{
-public:
-	size_t poolIndex = 0;
-	bool isActive = false;
-
-	ObjectPoolItem() = default;
-	ObjectPoolItem(ObjectPoolItem&&) = default;
-	ObjectPoolItem& operator=(ObjectPoolItem&&) = default;
-
-	// On instantiating pool
-	virtual void Init() = 0;
-
-	// On get from pool
-	virtual void OnGet() = 0;
-	// Called when release from pool (Set object to inactive but still in memory)
-	virtual void OnRelease() = 0;
-
-	virtual void Exit() = 0;
-};
+#include "AEEngine.h"
 
 /**
  * @brief	Object Pool with time complexity of:
  *			- Get:		O(1)
  *			- Release:	O(1)
- * 
- *			Need the object that is being pooled to inherit ObjectPoolItem
- * 
- * @warning	This will swap memory around when removing so shouldn't store pointers to the items. 
-			This also means insertation order isn't kept
+ *			- Find:		O(1)
+ *
+ *			Items are stored in fixed size chunks that are never moved, so references / pointers to an item
+ *			stay valid until it's released, even when the pool grows.
+ *			Get returns a Handle instead of a reference. Once the item is released, the slot's generation changes
+ *			and the handle stops finding it (instead of pointing to whatever reused the slot).
+ *
+ *			Live items are also listed in a dense array for looping through them (GetSize / At, or range for).
+ *			Releasing moves the last item of that list into its place, so the loop order isn't kept.
+ *
+ * @tparam T			Any type. Constructed in Get, destructed in Release. No need to inherit anything
+ * @tparam CHUNK_SIZE	Items per chunk. The pool grows by 1 chunk at a time
  */
-template<typename T>
-requires std::derived_from<T, ObjectPoolItem>
+template<typename T, size_t CHUNK_SIZE = 64>
 class ObjectPool
 {
+	static_assert(CHUNK_SIZE > 0 && (CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "CHUNK_SIZE must be a power of 2");
+
 public:
-	ObjectPool(int startSize);
+	/**
+	 * @brief	Refers to an item. Default constructed handles are invalid
+	 */
+	struct Handle
+	{
+		u32 index = static_cast<u32>(-1);
+		u32 generation = 0;
+
+		bool operator==(const Handle&) const = default;
+	};
+
+	/**
+	 * @param startSize	Number of items to allocate space for
+	 */
+	explicit ObjectPool(int startSize = 0);
 	~ObjectPool();
 
-	T& Get();
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	/**
+	 * @brief		Constructs an item in a free slot, adds a chunk if there's none
+	 * @param args	Passed to T's constructor
+	 * @return		Handle to the new item. Use Find to get the item
+	 */
+	template<typename... Args>
+	Handle Get(Args&&... args);
+
+	/**
+	 * @return	Item of the handle. nullptr if it has been released
+	 */
+	T* Find(Handle handle);
+	const T* Find(Handle handle) const;
+	bool IsValid(Handle handle) const;
+
+	/**
+	 * @brief	Destructs the item and frees the slot. Does nothing if the handle is already released
+	 * @return	If the item was released
+	 */
+	bool Release(Handle handle);
+
+	/**
+	 * @brief	Releases every item. Keeps the chunks
+	 */
+	void Clear();
+
+	/**
+	 * @return	Number of live items
+	 */
+	size_t GetSize() const;
+	/**
+	 * @return	Number of items that fit without adding a chunk
+	 */
+	size_t GetCapacity() const;
+
+	/**
+	 * @param i	Index in the live items, [0, GetSize())
+	 */
+	T& At(size_t i);
+	const T& At(size_t i) const;
+	Handle GetHandle(size_t i) const;
+
+	void DebugPrint() const;
 
 	/**
-	 * @brief		Swap the 
-	 * @param item	Item to remove
+	 * @brief	Loops through the live items. Don't Get / Release while looping with it,
+	 *			to release while looping, loop from the back with At / GetHandle
 	 */
-	void Release(T& item);
+	template<typename PoolType, typename ItemType>
+	class Iterator
+	{
+	public:
+		Iterator(PoolType* pool, size_t i) : pool(pool), i(i) {}
+		ItemType& operator*() const { return pool->At(i); }
+		ItemType* operator->() const { return &pool->At(i); }
+		Iterator& operator++() { ++i; return *this; }
+		bool operator!=(const Iterator& other) const { return i != other.i; }
 
-	size_t GetSize();
+	private:
+		PoolType* pool;
+		size_t i;
+	};
 
-	void DebugPrint();
+	Iterator<ObjectPool, T> begin() { return { this, 0 }; }
+	Iterator<ObjectPool, T> end() { return { this, dense.size() }; }
+	Iterator<const ObjectPool, const T> begin() const { return { this, 0 }; }
+	Iterator<const ObjectPool, const T> end() const { return { this, dense.size() }; }
 
-	// tmp - make private
-	std::vector<T> pool;
 private:
-	size_t size; 
+	struct Chunk
+	{
+		alignas(T) std::byte data[sizeof(T) * CHUNK_SIZE];
+	};
+
+	struct Slot
+	{
+		u32 generation = 1;		// Odd when free, even when used
+		u32 denseIndex = 0;		// Index in dense when used
+	};
+
+	void AddChunk();
+	T* GetItem(u32 index);
+	const T* GetItem(u32 index) const;
+
+	std::vector<std::unique_ptr<Chunk>> chunks;
+	std::vector<Slot> slots;
+	std::vector<u32> dense;			// Slot index of every live item
+	std::vector<u32> freeSlots;
 };
 
-template<typename T>
-requires std::derived_from<T, ObjectPoolItem>
-inline ObjectPool<T>::ObjectPool(int startSize) : pool(startSize)
+template<typename T, size_t CHUNK_SIZE>
+inline ObjectPool<T, CHUNK_SIZE>::ObjectPool(int startSize)
 {
-	for (size_t i = 0; i < pool.size(); i++)
-	{
-		ObjectPoolItem& item = pool[i];
-		item.Init();
-		item.poolIndex = i;
-		item.isActive = false;
-	}
+	while (GetCapacity() < static_cast<size_t>((std::max)(startSize, 0)))
+		AddChunk();
+}
 
-	size = 0;
+template<typename T, size_t CHUNK_SIZE>
+inline ObjectPool<T, CHUNK_SIZE>::~ObjectPool()
+{
+	Clear();
 }
 
-template<typename T>
-requires std::derived_from<T, ObjectPoolItem>
-inline ObjectPool<T>::~ObjectPool()
+template<typename T, size_t CHUNK_SIZE>
+template<typename... Args>
+inline typename ObjectPool<T, CHUNK_SIZE>::Handle ObjectPool<T, CHUNK_SIZE>::Get(Args&&... args)
 {
-	for (auto& item : pool)
-		item.Exit();
+	if (freeSlots.empty())
+		AddChunk();
+
+	const u32 index = freeSlots.back();
+	freeSlots.pop_back();
+
+	new (GetItem(index)) T(std::forward<Args>(args)...);
+
+	Slot& slot = slots[index];
+	++slot.generation;
+	slot.denseIndex = static_cast<u32>(dense.size());
+	dense.push_back(index);
+
+	return { index, slot.generation };
 }
 
-template<typename T>
-requires std::derived_from<T, ObjectPoolItem>
-inline T& ObjectPool<T>::Get()
+template<typename T, size_t CHUNK_SIZE>
+inline T* ObjectPool<T, CHUNK_SIZE>::Find(Handle handle)
 {
-	if (size == pool.size())
-	{
-		auto& item = pool.emplace_back();
-		item.isActive = true;
-		item.poolIndex = size++;
-		return item;
-	}
-	else
-	{
-		auto& item = pool[static_cast<int>(size++)];
-		item.isActive = true;
-		return item;
-	}
+	return IsValid(handle) ? GetItem(handle.index) : nullptr;
 }
 
-template<typename T>
-requires std::derived_from<T, ObjectPoolItem>
-inline void ObjectPool<T>::Release(T& item)
+template<typename T, size_t CHUNK_SIZE>
+inline const T* ObjectPool<T, CHUNK_SIZE>::Find(Handle handle) const
 {
-	// Now size points to the last item
-	--size;
+	return IsValid(handle) ? GetItem(handle.index) : nullptr;
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline bool ObjectPool<T, CHUNK_SIZE>::IsValid(Handle handle) const
+{
+	return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline bool ObjectPool<T, CHUNK_SIZE>::Release(Handle handle)
+{
+	if (!IsValid(handle))
+		return false;
 
-	// Release item
-	item.isActive = false;
-	item.OnRelease();
+	Slot& slot = slots[handle.index];
+	GetItem(handle.index)->~T();
+	++slot.generation;
 
-	// Swap the current item (inactive) with the last item (active)
-	// Then swap the poolIndex as the memory has been swapped
-	// NOTE: If itemIndex == size, it'll swap with itself. 
-	//		 Not handling it since need additional if statement and the pool is very big
-	size_t itemIndex = item.poolIndex;
-	std::swap(pool[itemIndex], pool[size]);
-	std::swap(pool[itemIndex].poolIndex, pool[size].poolIndex);
+	// Move the last live item into the released item's place in dense. The items themselves don't move
+	const u32 lastIndex = dense.back();
+	dense[slot.denseIndex] = lastIndex;
+	slots[lastIndex].denseIndex = slot.denseIndex;
+	dense.pop_back();
+
+	freeSlots.push_back(handle.index);
+	return true;
 }
 
-template<typename T>
-requires std::derived_from<T, ObjectPoolItem>
-inline size_t ObjectPool<T>::GetSize()
+template<typename T, size_t CHUNK_SIZE>
+inline void ObjectPool<T, CHUNK_SIZE>::Clear()
 {
-	return size;
+	while (!dense.empty())
+		Release(GetHandle(dense.size() - 1));
 }
 
-template<typename T>
-	requires std::derived_from<T, ObjectPoolItem>
-inline void ObjectPool<T>::DebugPrint()
+template<typename T, size_t CHUNK_SIZE>
+inline size_t ObjectPool<T, CHUNK_SIZE>::GetSize() const
 {
-	std::cout << "=== Object Pool ===\n";
+	return dense.size();
+}
 
-	for (auto& i : pool)
-	{
-		/*Particle* p = dynamic_cast<Particle*>(&i);
-		if (p) 
-			std::cout << i.isActive << " - " << (p->lifetime - AEGetTime(nullptr)) << "\n";
-		else*/
-			std::cout << i.poolIndex << " - " << i.isActive << "\n";
-	}
+template<typename T, size_t CHUNK_SIZE>
+inline size_t ObjectPool<T, CHUNK_SIZE>::GetCapacity() const
+{
+	return slots.size();
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline T& ObjectPool<T, CHUNK_SIZE>::At(size_t i)
+{
+	return *GetItem(dense[i]);
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline const T& ObjectPool<T, CHUNK_SIZE>::At(size_t i) const
+{
+	return *GetItem(dense[i]);
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline typename ObjectPool<T, CHUNK_SIZE>::Handle ObjectPool<T, CHUNK_SIZE>::GetHandle(size_t i) const
+{
+	const u32 index = dense[i];
+	return { index, slots[index].generation };
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline void ObjectPool<T, CHUNK_SIZE>::DebugPrint() const
+{
+	std::cout << "=== Object Pool ===\n"
+		<< "Live: " << GetSize() << " / " << GetCapacity() << " (" << chunks.size() << " chunks)\n";
+
+	for (size_t i = 0; i < slots.size(); i++)
+		std::cout << i << " - gen " << slots[i].generation << ((slots[i].generation & 1) ? " free" : " used") << "\n";
 
 	std::cout << "===================\n";
 }
+
+template<typename T, size_t CHUNK_SIZE>
+inline void ObjectPool<T, CHUNK_SIZE>::AddChunk()
+{
+	const u32 start = static_cast<u32>(slots.size());
+	chunks.push_back(std::unique_ptr<Chunk>(new Chunk));	// Not make_unique, it would zero the chunk
+	slots.resize(slots.size() + CHUNK_SIZE);
+	dense.reserve(slots.size());
+
+	// Pushed in reverse so the lowest index gets used first
+	freeSlots.reserve(slots.size());
+	for (u32 i = CHUNK_SIZE; i > 0; --i)
+		freeSlots.push_back(start + i - 1);
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline T* ObjectPool<T, CHUNK_SIZE>::GetItem(u32 index)
+{
+	return std::launder(reinterpret_cast<T*>(chunks[index / CHUNK_SIZE]->data) + index % CHUNK_SIZE);
+}
+
+template<typename T, size_t CHUNK_SIZE>
+inline const T* ObjectPool<T, CHUNK_SIZE>::GetItem(u32 index) const
+{
+	return std::launder(reinterpret_cast<const T*>(chunks[index / CHUNK_SIZE]->data) + index % CHUNK_SIZE);
+}
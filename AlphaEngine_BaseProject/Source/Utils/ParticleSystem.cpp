@@ -2,22 +2,104 @@
 #include <limits>
 
 #include "ParticleSystem.h"
-#include "MeshGenerator.h"
+#include "Renderer.h"
 #include "../Game/Camera.h"
 #include "../Utils/AEExtras.h"
 #include "../Game/Time.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 
-ParticleSystem::ParticleSystem(int initialSize, const EmitterSettings& emitter) : 
-	pool(initialSize),
+namespace
+{
+	// Update kernels, one per behavior.
+	// Plain loops over the arrays with no branches on the behavior so the compiler can vectorise them.
+	// __restrict: the arrays never overlap
+
+	void UpdateNormal(float* __restrict posX, float* __restrict posY,
+		const float* __restrict velX, const float* __restrict velY,
+		size_t count, float dt)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			posX[i] += velX[i] * dt;
+			posY[i] += velY[i] * dt;
+		}
+	}
+
+	void UpdateInward(float* __restrict posX, float* __restrict posY,
+		float* __restrict velX, float* __restrict velY,
+		const float* __restrict centerX, const float* __restrict centerY, const float* __restrict pull,
+		size_t count, float dt)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			float dirX = centerX[i] - posX[i];
+			float dirY = centerY[i] - posY[i];
+			const float len = sqrtf(dirX * dirX + dirY * dirY);
+			// Don't normalise when on the center. Select before dividing so the loop has no branches
+			const float invLen = 1.f / (len > 0.0001f ? len : 1.f);
+			dirX *= invLen;
+			dirY *= invLen;
+
+			velX[i] += dirX * pull[i] * dt;
+			velY[i] += dirY * pull[i] * dt;
+
+			posX[i] += velX[i] * dt;
+			posY[i] += velY[i] * dt;
+		}
+	}
+
+	void UpdateTornadoIn(float* __restrict posX, float* __restrict posY,
+		float* __restrict velX, float* __restrict velY,
+		const float* __restrict centerX, const float* __restrict centerY,
+		const float* __restrict pull, const float* __restrict swirl,
+		size_t count, float dt)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			// swirl tangent around center + inward pull
+			float toCX = centerX[i] - posX[i];
+			float toCY = centerY[i] - posY[i];
+			const float len = sqrtf(toCX * toCX + toCY * toCY);
+			const float invLen = 1.f / (len > 0.0001f ? len : 1.f);
+			toCX *= invLen;
+			toCY *= invLen;
+
+			// tangent (perpendicular) = { -toC.y, toC.x }
+			velX[i] += (toCX * pull[i] - toCY * swirl[i]) * dt;
+			velY[i] += (toCY * pull[i] + toCX * swirl[i]) * dt;
+
+			posX[i] += velX[i] * dt;
+			posY[i] += velY[i] * dt;
+		}
+	}
+
+	void UpdateGravity(float* __restrict posX, float* __restrict posY,
+		const float* __restrict velX, float* __restrict velY,
+		const float* __restrict pull,
+		size_t count, float dt)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			velY[i] -= pull[i] * dt; // reuse pull as gravity
+			posX[i] += velX[i] * dt;
+			posY[i] += velY[i] * dt;
+		}
+	}
+}
+
+ParticleSystem::ParticleSystem(int initialSize, const EmitterSettings& emitter) :
 	emitter(emitter)
 {
-	particleMesh = MeshGenerator::GetSquareMesh(1.f);
+	MEMORY_SCOPE(Particles);
+	// Most particles use the default emitter
+	groups[(int)emitter.behavior].Reserve(initialSize);
+
 	//SetSpawnRate(10000.f);
 }
 
 ParticleSystem::~ParticleSystem()
 {
-	AEGfxMeshFree(particleMesh);
 }
 
 void ParticleSystem::Init()
@@ -27,84 +109,135 @@ void ParticleSystem::Init()
 
 void ParticleSystem::Update()
 {
+	PROFILE_SCOPE("ParticleSystem::Update");
+	MEMORY_SCOPE(Particles);
 
-	
-	    
-			float currTime = static_cast<float>(Time::GetInstance().GetScaledElapsedTime());
-			while (currTime > lastSpawnTime)
-			{
-				lastSpawnTime += timeBetweenSpawn;
-				Particle& p = SpawnParticle();
-				p.Update(static_cast<float>(lastSpawnTime - currTime)); // Prebake
-			}
-
-			if (pool.GetSize() == 0)
-				return;
-
-			//std::cout << pool.GetSize() << " | " << timeBetweenSpawn << "\n";
+	float currTime = static_cast<float>(Time::GetInstance().GetScaledElapsedTime());
+	while (currTime > lastSpawnTime)
+	{
+		lastSpawnTime += timeBetweenSpawn;
+		SpawnParticle();
 
-			float dt = static_cast<float>(Time::GetInstance().GetScaledDeltaTime());
-			// todo - make custom iterator inside object pool instead?
-			// iterate from back. Use this weird syntax because size_t is unsigned
-			for (size_t i = pool.GetSize(); (i--) > 0;)
-			{
-				Particle& p = pool.pool[i];
-				p.Update(dt);
-				if (currTime > p.spawnTime + p.lifetime)
-					pool.Release(p);
-			}
-			
+		// Prebake
+		ParticleGroup& group = groups[(int)emitter.behavior];
+		UpdateGroup(emitter.behavior, group, group.Size() - 1, group.Size(), static_cast<float>(lastSpawnTime - currTime));
+	}
 
-	    
-		
-	
-	
+	float dt = static_cast<float>(Time::GetInstance().GetScaledDeltaTime());
+	for (int behavior = 0; behavior < (int)ParticleBehavior::Count; ++behavior)
+	{
+		ParticleGroup& group = groups[behavior];
+		if (group.Size() == 0)
+			continue;
+
+		UpdateGroup((ParticleBehavior)behavior, group, 0, group.Size(), dt);
+
+		// Remove expired particles.
+		// Most frames nothing expires, check with a loop that can be vectorised before removing
+		const float* spawnTime = group.spawnTime.data();
+		const float* lifetime = group.lifetime.data();
+		int expiredCount = 0;
+		for (size_t i = 0; i < group.Size(); ++i)
+			expiredCount += currTime > spawnTime[i] + lifetime[i];
+
+		if (expiredCount == 0)
+			continue;
+
+		// iterate from back. Use this weird syntax because size_t is unsigned
+		for (size_t i = group.Size(); (i--) > 0;)
+		{
+			if (currTime > group.spawnTime[i] + group.lifetime[i])
+				group.SwapRemove(i);
+		}
+	}
 }
 
 void ParticleSystem::Render()
 {
-	AEGfxTextureSet(nullptr, 0, 0);
-	AEGfxSetRenderMode(AE_GFX_RM_COLOR);
-	// todo - make custom iterator inside object pool instead?
-	for (size_t i = 0; i < pool.GetSize(); i++)
-		pool.pool[i].Render(particleMesh);
+	const float currTime = static_cast<float>(Time::GetInstance().GetScaledElapsedTime());
+	for (const ParticleGroup& group : groups)
+	{
+		for (size_t i = 0; i < group.Size(); i++)
+		{
+			AEMtx33 transform;
+
+			AEMtx33Scale(&transform, group.size[i], group.size[i]);
+			AEMtx33TransApply(
+				&transform,
+				&transform,
+				group.posX[i] - 0.5f,
+				group.posY[i] - 0.5f
+			);
+			// Camera scale. Scales translation too.
+			AEMtx33ScaleApply(&transform, &transform, Camera::scale, Camera::scale);
+
+			const float age = currTime - group.spawnTime[i];
+			const float t = (group.lifetime[i] > 0.f) ? (age / group.lifetime[i]) : 1.f;
+			const float fade = 1.f - AEClamp(t, 0.f, 1.f);
+
+			// Color only quad, tint and fade go in the vertex color
+			Renderer::SubmitQuad(nullptr, transform,
+				Renderer::ToColor(group.tintR[i], group.tintG[i], group.tintB[i], group.tintA[i] * fade));
+		}
+	}
 
-	AEGfxSetTransparency(1.f);
-	AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
+	// Drawn by the owner's Renderer::Flush, batched with the other particles / sprites
 }
 
 void ParticleSystem::ReleaseAll()
 {
-	// iterate from back. Use this weird syntax because size_t is unsigned
-	for (size_t i = pool.GetSize(); (i--) > 0;)
-		pool.Release(pool.pool[i]);
+	for (ParticleGroup& group : groups)
+		group.Clear();
 }
 
-Particle& ParticleSystem::SpawnParticle()
+void ParticleSystem::SpawnParticle()
 {
-	return SpawnParticle(emitter);
+	SpawnParticle(emitter);
 }
 
-Particle& ParticleSystem::SpawnParticle(const EmitterSettings& _emitter)
+void ParticleSystem::SpawnParticle(const EmitterSettings& _emitter)
 {
-	Particle& p = pool.Get();
-	p.spawnTime = static_cast<float>(Time::GetInstance().GetScaledElapsedTime());
-	p.position.x = AEExtras::RandomRange(_emitter.spawnPosRangeX);
-	p.position.y = AEExtras::RandomRange(_emitter.spawnPosRangeY);
-	p.lifetime = AEExtras::RandomRange(_emitter.lifetimeRange);
-	p.behavior = _emitter.behavior;
-	p.behaviorParams = _emitter.behaviorParams;
-	p.size = AEExtras::RandomRange(_emitter.sizeRange);
-
-	AEVec2FromAngle(&p.velocity, AEExtras::RandomRange(_emitter.angleRange));
-	AEVec2Scale(&p.velocity, &p.velocity, AEExtras::RandomRange(_emitter.speedRange));
-
-	p.tint = _emitter.tint;
-	return p;
+	ParticleGroup& group = groups[(int)_emitter.behavior];
+
+	// Same order of random calls as before, keeps runs with the same seed the same
+	group.spawnTime.push_back(static_cast<float>(Time::GetInstance().GetScaledElapsedTime()));
+	group.posX.push_back(AEExtras::RandomRange(_emitter.spawnPosRangeX));
+	group.posY.push_back(AEExtras::RandomRange(_emitter.spawnPosRangeY));
+	group.lifetime.push_back(AEExtras::RandomRange(_emitter.lifetimeRange));
+	group.size.push_back(AEExtras::RandomRange(_emitter.sizeRange));
+
+	AEVec2 velocity;
+	AEVec2FromAngle(&velocity, AEExtras::RandomRange(_emitter.angleRange));
+	AEVec2Scale(&velocity, &velocity, AEExtras::RandomRange(_emitter.speedRange));
+	group.velX.push_back(velocity.x);
+	group.velY.push_back(velocity.y);
+
+	group.tintR.push_back(_emitter.tint.r);
+	group.tintG.push_back(_emitter.tint.g);
+	group.tintB.push_back(_emitter.tint.b);
+	group.tintA.push_back(_emitter.tint.a);
+
+	const ParticleBehaviorParams& params = _emitter.behaviorParams;
+	switch (_emitter.behavior)
+	{
+	case ParticleBehavior::TornadoIn:
+		group.swirl.push_back(params.swirl);
+		[[fallthrough]];
+	case ParticleBehavior::Inward:
+		group.centerX.push_back(params.center.x);
+		group.centerY.push_back(params.center.y);
+		[[fallthrough]];
+	case ParticleBehavior::Gravity:
+		group.pull.push_back(params.pull);
+		break;
+	default:
+		break;
+	}
 }
 
 void ParticleSystem::SpawnParticleBurst(const EmitterSettings& _emitter, size_t spawnCount)
 {
+	MEMORY_SCOPE(Particles);
 	for (size_t i = 0; i < spawnCount; i++)
 		SpawnParticle(_emitter);
 }
@@ -129,97 +262,75 @@ void ParticleSystem::SetSpawnRate(float spawnRate)
 	if (lastSpawnTime - currTime > timeBetweenSpawn)
 		lastSpawnTime = currTime + timeBetweenSpawn;
 }
-void Particle::Update(float dt)
+
+size_t ParticleSystem::GetParticleCount() const
+{
+	size_t count = 0;
+	for (const ParticleGroup& group : groups)
+		count += group.Size();
+	return count;
+}
+
+void ParticleSystem::UpdateGroup(ParticleBehavior behavior, ParticleGroup& group, size_t begin, size_t end, float dt)
 {
+	const size_t count = end - begin;
+
 	switch (behavior)
 	{
 	case ParticleBehavior::normal:
-		position.x += velocity.x * dt;
-		position.y += velocity.y * dt;
+		UpdateNormal(&group.posX[begin], &group.posY[begin], &group.velX[begin], &group.velY[begin], count, dt);
 		break;
 
 	case ParticleBehavior::Inward:
-	{
-		AEVec2 dir{ behaviorParams.center.x - position.x,
-					behaviorParams.center.y - position.y };
-		float len = sqrtf(dir.x * dir.x + dir.y * dir.y);
-		if (len > 0.0001f) { dir.x /= len; dir.y /= len; }
-
-		velocity.x += dir.x * behaviorParams.pull * dt;
-		velocity.y += dir.y * behaviorParams.pull * dt;
-
-		position.x += velocity.x * dt;
-		position.y += velocity.y * dt;
+		UpdateInward(&group.posX[begin], &group.posY[begin], &group.velX[begin], &group.velY[begin],
+			&group.centerX[begin], &group.centerY[begin], &group.pull[begin], count, dt);
 		break;
-	}
 
 	case ParticleBehavior::TornadoIn:
-	{
-		// swirl tangent around center + inward pull
-		AEVec2 toC{ behaviorParams.center.x - position.x,
-					behaviorParams.center.y - position.y };
-		float len = sqrtf(toC.x * toC.x + toC.y * toC.y);
-		if (len > 0.0001f) { toC.x /= len; toC.y /= len; }
-
-		// tangent (perpendicular)
-		AEVec2 tan{ -toC.y, toC.x };
-
-		velocity.x += (toC.x * behaviorParams.pull + tan.x * behaviorParams.swirl) * dt;
-		velocity.y += (toC.y * behaviorParams.pull + tan.y * behaviorParams.swirl) * dt;
-
-		position.x += velocity.x * dt;
-		position.y += velocity.y * dt;
+		UpdateTornadoIn(&group.posX[begin], &group.posY[begin], &group.velX[begin], &group.velY[begin],
+			&group.centerX[begin], &group.centerY[begin], &group.pull[begin], &group.swirl[begin], count, dt);
 		break;
-	}
 
 	case ParticleBehavior::Gravity:
-		velocity.y -= behaviorParams.pull * dt; // reuse pull as gravity
-		position.x += velocity.x * dt;
-		position.y += velocity.y * dt;
+		UpdateGravity(&group.posX[begin], &group.posY[begin], &group.velX[begin], &group.velY[begin],
+			&group.pull[begin], count, dt);
 		break;
-	}
-}
-
-void Particle::Render(AEGfxVertexList* mesh)
-{
-	AEMtx33 transform;
-
-	AEMtx33Scale(&transform, size, size);
-	AEMtx33TransApply(
-		&transform,
-		&transform,
-		position.x - 0.5f,
-		position.y - 0.5f
-	);
-	// Camera scale. Scales translation too.
-	AEMtx33ScaleApply(&transform, &transform, Camera::scale, Camera::scale);
-	AEGfxSetTransform(transform.m);
 
-	const float age = static_cast<float>(Time::GetInstance().GetScaledElapsedTime()) - spawnTime;
-	const float t = (lifetime > 0.f) ? (age / lifetime) : 1.f;
-	const float fade = 1.f - AEClamp(t, 0.f, 1.f);
-
-	AEGfxSetColorToMultiply(tint.r, tint.g, tint.b, 1.f);
-	AEGfxSetTransparency(tint.a * fade);
-
-	//AEGfxSetTransparency(1.f - (static_cast<float>(Time::GetInstance().GetScaledElapsedTime()) - spawnTime) / lifetime);
-	AEGfxMeshDraw(mesh, AE_GFX_MDM_TRIANGLES);
-
-	AEGfxSetColorToMultiply(1.f, 1.f, 1.f, 1.f);
+	default:
+		break;
+	}
 }
 
-void Particle::Init()
+template <typename Fn>
+void ParticleSystem::ParticleGroup::ForEachArray(Fn&& fn)
 {
+	for (std::vector<float>* array : {
+		&posX, &posY, &velX, &velY, &spawnTime, &lifetime, &size,
+		&tintR, &tintG, &tintB, &tintA,
+		&centerX, &centerY, &pull, &swirl })
+	{
+		fn(*array);
+	}
 }
 
-void Particle::OnGet()
+void ParticleSystem::ParticleGroup::Reserve(size_t count)
 {
+	ForEachArray([count](std::vector<float>& array) { array.reserve(count); });
 }
 
-void Particle::OnRelease()
+void ParticleSystem::ParticleGroup::SwapRemove(size_t index)
 {
+	ForEachArray([index](std::vector<float>& array) {
+		// Unused behavior params are empty
+		if (array.empty())
+			return;
+
+		array[index] = array.back();
+		array.pop_back();
+	});
 }
 
-void Particle::Exit()
+void ParticleSystem::ParticleGroup::Clear()
 {
+	ForEachArray([](std::vector<float>& array) { array.clear(); });
 }
@@ -1,5 +1,6 @@
 #pragma once
-#include "ObjectPool.h"
+#include <vector>
+
 #include "AEEngine.h"
 
 struct Color4
@@ -13,6 +14,8 @@ enum class ParticleBehavior : unsigned char
 	Inward,
 	TornadoIn,
 	Gravity,
+
+	Count
 };
 
 
@@ -25,29 +28,6 @@ struct ParticleBehaviorParams
 };
 
 
-struct Particle : public ObjectPoolItem
-{
-	AEVec2 position = { 0.f, 0.f };
-	AEVec2 velocity = { 0.f, 0.f };
-	float spawnTime = -1.f;
-	float lifetime = -1.f;
-	float size = 0.1f;
-	Color4 tint;
-	ParticleBehavior behavior = ParticleBehavior::normal;
-	ParticleBehaviorParams behaviorParams;
-
-	virtual void Update(float dt);
-	virtual void Render(AEGfxVertexList* mesh);
-	virtual void Init() override;
-	virtual void OnGet() override;
-	virtual void OnRelease() override;
-	virtual void Exit() override;
-};
-
-
-
-
-
 class ParticleSystem
 {
 public:
@@ -74,16 +54,22 @@ public:
 
 	};
 
+	/**
+	 * @param initialSize	Number of particles to reserve memory for
+	 */
 	ParticleSystem(int initialSize, const EmitterSettings& emitter);
 	~ParticleSystem();
 
 	void Init();
 	void Update();
+	/**
+	 * @brief	Submits the particles to the Renderer. Drawn at the next Renderer::Flush
+	 */
 	void Render();
 	void ReleaseAll();
 
-	Particle& SpawnParticle();
-	Particle& SpawnParticle(const EmitterSettings& _emitter);
+	void SpawnParticle();
+	void SpawnParticle(const EmitterSettings& _emitter);
 
 	/**
 	 * @brief				Spawn a burst of particles
@@ -100,10 +86,43 @@ public:
 
 	void SetSpawnRate(float spawnRate);
 
+	// Number of live particles
+	size_t GetParticleCount() const;
+
 	EmitterSettings emitter;
 private:
+	/**
+	 * @brief	Particles with the same behavior, each field in its own array (structure of arrays)
+	 *			so the update loops go through contiguous floats and can be vectorised.
+	 *			Removing swaps the last particle in, so the order isn't kept.
+	 */
+	struct ParticleGroup
+	{
+		std::vector<float> posX, posY;
+		std::vector<float> velX, velY;
+		std::vector<float> spawnTime, lifetime;
+		std::vector<float> size;
+		std::vector<float> tintR, tintG, tintB, tintA;
+
+		// Behavior params, only filled if the behavior uses them (empty otherwise)
+		std::vector<float> centerX, centerY;	// Inward, TornadoIn
+		std::vector<float> pull;				// Inward, TornadoIn, Gravity
+		std::vector<float> swirl;				// TornadoIn
+
+		size_t Size() const { return posX.size(); }
+		void Reserve(size_t count);
+		void SwapRemove(size_t index);
+		void Clear();
+
+		// Calls fn(std::vector<float>&) for every array
+		template <typename Fn>
+		void ForEachArray(Fn&& fn);
+	};
+
+	// Updates particles [begin, end) of the group
+	static void UpdateGroup(ParticleBehavior behavior, ParticleGroup& group, size_t begin, size_t end, float dt);
+
 	float timeBetweenSpawn = 0.f;
-	ObjectPool<Particle> pool;
-	AEGfxVertexList* particleMesh = nullptr;
+	ParticleGroup groups[(int)ParticleBehavior::Count];
 	double lastSpawnTime = 0.f;
 };
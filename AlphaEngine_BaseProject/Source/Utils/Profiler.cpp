@@ -0,0 +1,105 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+void Profiler::SetRecording(bool isRecording)
+{
+	if (isRecording && !recording)
+	{
+		Clear();
+		// Allocate up front so recording doesn't allocate mid frame
+		events.reserve(capacity);
+	}
+
+	recording = isRecording;
+}
+
+void Profiler::SetCapacity(size_t newCapacity)
+{
+	capacity = (std::max)(newCapacity, (size_t)1);
+	Clear();
+}
+
+void Profiler::Clear()
+{
+	events.clear();
+	events.shrink_to_fit();
+	next = 0;
+	dropped = 0;
+}
+
+size_t Profiler::GetEventCount()
+{
+	return events.size();
+}
+
+std::vector<Profiler::Event> Profiler::GetEvents()
+{
+	// Buffer hasn't wrapped around yet, already in order
+	if (events.size() < capacity)
+		return events;
+
+	std::vector<Event> ordered;
+	ordered.reserve(events.size());
+	ordered.insert(ordered.end(), events.begin() + next, events.end());
+	ordered.insert(ordered.end(), events.begin(), events.begin() + next);
+	return ordered;
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path)
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		std::cout << "[Profiler] Failed to open " << path << "\n";
+		return false;
+	}
+
+	const std::vector<Event> ordered = GetEvents();
+
+	// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+	// "X" = complete event, ts and dur are in microseconds
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	file << std::fixed << std::setprecision(3);
+	for (size_t i = 0; i < ordered.size(); ++i)
+	{
+		const Event& e = ordered[i];
+		file << "{\"name\":\"" << e.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+			 << ",\"ts\":" << (double)e.start / 1000.0
+			 << ",\"dur\":" << (double)e.duration / 1000.0
+			 << ",\"args\":{\"depth\":" << e.depth << "}}"
+			 << (i + 1 < ordered.size() ? ",\n" : "\n");
+	}
+	file << "]}\n";
+
+	if (!file)
+	{
+		std::cout << "[Profiler] Failed to write " << path << "\n";
+		return false;
+	}
+
+	std::cout << "[Profiler] Wrote " << ordered.size() << " events to " << path;
+	if (dropped > 0)
+		std::cout << " (" << dropped << " oldest events dropped)";
+	std::cout << "\n";
+	return true;
+}
+
+void Profiler::Record(const char* name, s64 start, s64 duration, u32 eventDepth)
+{
+	const Event e{ name, start, duration, eventDepth };
+
+	if (events.size() < capacity)
+	{
+		events.push_back(e);
+		next = events.size() % capacity;
+		return;
+	}
+
+	events[next] = e;
+	next = (next + 1) % capacity;
+	++dropped;
+}
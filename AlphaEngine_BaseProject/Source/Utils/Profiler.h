@@ -0,0 +1,132 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "AEEngine.h"
+
+// Set to 0 to compile out all the profiler scopes
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+
+#if PROFILER_ENABLED
+/**
+ * @brief	Times the rest of the current scope. name must be a string literal.
+ *			e.g. PROFILE_SCOPE("MapGrid::Raycast");
+ */
+#define PROFILE_SCOPE(name) Profiler::Scope PROFILER_CONCAT(profilerScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+/**
+ * @brief	Records how long each PROFILE_SCOPE takes into a ring buffer.
+ *			Only records when recording is on (Debug menu in the editor / HeadlessSim --trace),
+ *			otherwise a scope is just a bool check.
+ *			The buffer can be exported for chrome://tracing or https://ui.perfetto.dev
+ *
+ * @note	Main thread only.
+ */
+class Profiler
+{
+public:
+	struct Event
+	{
+		const char* name;	// Not copied, must outlive the profiler (string literal)
+		s64 start;			// Nanoseconds since the profiler started
+		s64 duration;		// Nanoseconds
+		u32 depth;			// Number of parent scopes
+	};
+
+	/**
+	 * @brief	Times from constructor to destructor. Use PROFILE_SCOPE instead of creating directly.
+	 */
+	class Scope
+	{
+	public:
+		explicit Scope(const char* name) : name(name)
+		{
+			if (recording)
+			{
+				start = Now();
+				++depth;
+			}
+		}
+
+		~Scope()
+		{
+			if (start >= 0)
+			{
+				--depth;
+				Record(name, start, Now() - start, depth);
+			}
+		}
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		const char* name;
+		s64 start = -1;	// -1 if not recording when the scope started
+	};
+
+	/**
+	 * @brief	Starts / stops recording. Starting clears the events from the last recording.
+	 */
+	static void SetRecording(bool isRecording);
+	static bool IsRecording() { return recording; }
+
+	/**
+	 * @brief	Max number of events kept. Oldest events are overwritten when full.
+	 *			Clears the recorded events.
+	 */
+	static void SetCapacity(size_t capacity);
+
+	static void Clear();
+
+	/**
+	 * @brief	Number of events in the buffer
+	 */
+	static size_t GetEventCount();
+
+	/**
+	 * @brief	Number of events overwritten since the last clear
+	 */
+	static size_t GetDroppedCount() { return dropped; }
+
+	/**
+	 * @brief	Copies the recorded events, oldest first
+	 */
+	static std::vector<Event> GetEvents();
+
+	/**
+	 * @brief	Writes the recorded events in the Chrome trace event format
+	 * @param	path	File to write to
+	 * @return	True if the file was written
+	 */
+	static bool ExportChromeTrace(const std::string& path);
+
+private:
+	static s64 Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+	}
+
+	static void Record(const char* name, s64 start, s64 duration, u32 eventDepth);
+
+	inline static bool recording = false;
+	inline static u32 depth = 0;
+	inline static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+	inline static std::vector<Event> events;
+	inline static size_t capacity = 1 << 16;
+	inline static size_t next = 0;		// Index to write the next event to
+	inline static size_t dropped = 0;
+
+	// Disable creating an instance. Static class
+	Profiler() = delete;
+};
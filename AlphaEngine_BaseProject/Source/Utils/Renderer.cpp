@@ -0,0 +1,278 @@
+#include "Renderer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Profiler.h"
+
+std::vector<Renderer::DrawCommand> Renderer::commands;
+std::vector<Renderer::DrawCommand> Renderer::sortedCommands;
+std::vector<u32> Renderer::groupOfCommand;
+std::vector<Renderer::Group> Renderer::groups;
+
+Renderer::AEBackend Renderer::aeBackend;
+Renderer::Backend* Renderer::backend = &Renderer::aeBackend;
+
+Renderer::Stats Renderer::frameStats;
+Renderer::Stats Renderer::totalStats;
+
+void Renderer::Submit(const DrawCommand& command)
+{
+	commands.push_back(command);
+}
+
+void Renderer::SubmitQuad(AEGfxTexture* texture, const AEMtx33& transform, u32 color)
+{
+	DrawCommand command;
+	command.texture = texture;
+	command.transform = transform;
+	command.color = color;
+	commands.push_back(command);
+}
+
+void Renderer::Flush()
+{
+	if (commands.empty())
+		return;
+
+	PROFILE_SCOPE("Renderer::Flush");
+
+	const std::chrono::steady_clock::time_point sortStart = std::chrono::steady_clock::now();
+
+	// Counting sort by texture / blend mode.
+	// Groups are drawn in the order they're made, and commands keep their order within a group.
+	// A command can only join a group drawn after every group with a different texture / blend mode
+	// that it overlaps, otherwise it would end up below a quad that was submitted before it.
+	// If there's no such group, it starts a new one
+	groups.clear();
+	groupOfCommand.resize(commands.size());
+	for (size_t i = 0; i < commands.size(); ++i)
+	{
+		const DrawCommand& command = commands[i];
+
+		// Bounding box of the unit quad after the transform
+		const AEMtx33& m = command.transform;
+		const f32 halfWidth = 0.5f * (fabsf(m.m[0][0]) + fabsf(m.m[0][1]));
+		const f32 halfHeight = 0.5f * (fabsf(m.m[1][0]) + fabsf(m.m[1][1]));
+		const f32 minX = m.m[0][2] - halfWidth, maxX = m.m[0][2] + halfWidth;
+		const f32 minY = m.m[1][2] - halfHeight, maxY = m.m[1][2] + halfHeight;
+
+		// Few groups per flush so a linear search is fine
+		u32 firstAllowed = 0;
+		for (u32 g = 0; g < groups.size(); ++g)
+		{
+			const Group& group = groups[g];
+			if (group.texture == command.texture && group.blendMode == command.blendMode)
+				continue;
+			// Touching edges (e.g. tiles next to each other) don't count
+			if (minX < group.maxX && group.minX < maxX && minY < group.maxY && group.minY < maxY)
+				firstAllowed = g + 1;
+		}
+
+		u32 groupIndex = (u32)groups.size();
+		for (u32 g = firstAllowed; g < groups.size(); ++g)
+		{
+			if (groups[g].texture == command.texture && groups[g].blendMode == command.blendMode)
+			{
+				groupIndex = g;
+				break;
+			}
+		}
+
+		if (groupIndex == groups.size())
+			groups.push_back(Group{ command.texture, command.blendMode, 0, 0, minX, minY, maxX, maxY });
+
+		Group& group = groups[groupIndex];
+		group.minX = (std::min)(group.minX, minX);
+		group.minY = (std::min)(group.minY, minY);
+		group.maxX = (std::max)(group.maxX, maxX);
+		group.maxY = (std::max)(group.maxY, maxY);
+
+		groupOfCommand[i] = groupIndex;
+		++group.count;
+	}
+
+	// Prefix sum to get where each group starts, then place the commands
+	u32 start = 0;
+	for (Group& group : groups)
+	{
+		group.start = start;
+		start += group.count;
+		group.count = 0;
+	}
+
+	sortedCommands.resize(commands.size());
+	for (size_t i = 0; i < commands.size(); ++i)
+	{
+		Group& group = groups[groupOfCommand[i]];
+		sortedCommands[group.start + group.count++] = commands[i];
+	}
+
+	const f64 sortSeconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - sortStart).count();
+
+	for (const Group& group : groups)
+		backend->SubmitBatch(Batch{ group.texture, group.blendMode, &sortedCommands[group.start], group.count });
+
+	for (Stats* stats : { &frameStats, &totalStats })
+	{
+		stats->commands += commands.size();
+		stats->batches += groups.size();
+		++stats->flushes;
+		stats->sortSeconds += sortSeconds;
+	}
+
+	commands.clear();
+}
+
+void Renderer::BeginFrame()
+{
+	frameStats = {};
+}
+
+void Renderer::SetBackend(Backend* _backend)
+{
+	backend = _backend ? _backend : &aeBackend;
+}
+
+void Renderer::Free()
+{
+	aeBackend.Free();
+	commands.clear();
+	sortedCommands.clear();
+}
+
+void Renderer::ResetStats()
+{
+	frameStats = {};
+	totalStats = {};
+}
+
+u32 Renderer::ToColor(f32 r, f32 g, f32 b, f32 a)
+{
+	auto toByte = [](f32 value) {
+		return (u32)(AEClamp(value, 0.f, 1.f) * 255.f + 0.5f);
+	};
+	return (toByte(a) << 24) | (toByte(r) << 16) | (toByte(g) << 8) | toByte(b);
+}
+
+void Renderer::AEBackend::SubmitBatch(const Batch& batch)
+{
+	AEGfxSetRenderMode(batch.texture ? AE_GFX_RM_TEXTURE : AE_GFX_RM_COLOR);
+	AEGfxSetBlendMode(batch.blendMode);
+	AEGfxSetColorToAdd(0.f, 0.f, 0.f, 0.f);
+
+	if (batch.count <= MAX_QUAD_BY_QUAD_COUNT)
+		DrawQuads(batch);
+	else
+		DrawMergedMesh(batch);
+
+	// Back to the defaults the rest of the game expects
+	AEGfxSetRenderMode(AE_GFX_RM_TEXTURE);
+	AEGfxSetBlendMode(AE_GFX_BM_BLEND);
+	AEGfxSetColorToMultiply(1.f, 1.f, 1.f, 1.f);
+	AEGfxSetTransparency(1.f);
+}
+
+void Renderer::AEBackend::Free()
+{
+	for (QuadMesh& quadMesh : quadMeshes)
+		AEGfxMeshFree(quadMesh.mesh);
+	quadMeshes.clear();
+}
+
+void Renderer::AEBackend::DrawQuads(const Batch& batch)
+{
+	for (u32 i = 0; i < batch.count; ++i)
+	{
+		const DrawCommand& command = batch.commands[i];
+
+		// Same as the tint in the vertex color of a merged mesh
+		AEGfxSetColorToMultiply(
+			((command.color >> 16) & 0xFF) / 255.f,
+			((command.color >> 8) & 0xFF) / 255.f,
+			(command.color & 0xFF) / 255.f,
+			1.f);
+		AEGfxSetTransparency((command.color >> 24) / 255.f);
+
+		AEGfxTextureSet(batch.texture, command.u0, command.v0);
+		AEMtx33 transform = command.transform;
+		AEGfxSetTransform(transform.m);
+		AEGfxMeshDraw(GetQuadMesh(command.u1 - command.u0, command.v1 - command.v0), AE_GFX_MDM_TRIANGLES);
+	}
+}
+
+void Renderer::AEBackend::DrawMergedMesh(const Batch& batch)
+{
+	// Transforms are baked into the vertices
+	AEGfxMeshStart();
+	for (u32 i = 0; i < batch.count; ++i)
+	{
+		const DrawCommand& command = batch.commands[i];
+		const AEMtx33& m = command.transform;
+
+		// Corners of the unit quad
+		auto transformX = [&m](f32 x, f32 y) { return m.m[0][0] * x + m.m[0][1] * y + m.m[0][2]; };
+		auto transformY = [&m](f32 x, f32 y) { return m.m[1][0] * x + m.m[1][1] * y + m.m[1][2]; };
+		const f32 leftBottomX = transformX(-0.5f, -0.5f), leftBottomY = transformY(-0.5f, -0.5f);
+		const f32 rightBottomX = transformX(0.5f, -0.5f), rightBottomY = transformY(0.5f, -0.5f);
+		const f32 leftTopX = transformX(-0.5f, 0.5f), leftTopY = transformY(-0.5f, 0.5f);
+		const f32 rightTopX = transformX(0.5f, 0.5f), rightTopY = transformY(0.5f, 0.5f);
+
+		// Same layout as MeshGenerator::GetRectMesh
+		AEGfxTriAdd(
+			leftBottomX, leftBottomY, command.color, command.u0, command.v1,
+			rightBottomX, rightBottomY, command.color, command.u1, command.v1,
+			leftTopX, leftTopY, command.color, command.u0, command.v0
+		);
+		AEGfxTriAdd(
+			rightBottomX, rightBottomY, command.color, command.u1, command.v1,
+			rightTopX, rightTopY, command.color, command.u1, command.v0,
+			leftTopX, leftTopY, command.color, command.u0, command.v0
+		);
+	}
+	AEGfxVertexList* mesh = AEGfxMeshEnd();
+
+	AEMtx33 identity;
+	AEMtx33Identity(&identity);
+	AEGfxSetTransform(identity.m);
+
+	AEGfxTextureSet(batch.texture, 0.f, 0.f);
+	AEGfxSetColorToMultiply(1.f, 1.f, 1.f, 1.f);
+	AEGfxSetTransparency(1.f);
+
+	AEGfxMeshDraw(mesh, AE_GFX_MDM_TRIANGLES);
+	AEGfxMeshFree(mesh);
+}
+
+AEGfxVertexList* Renderer::AEBackend::GetQuadMesh(f32 uvWidth, f32 uvHeight)
+{
+	// Only a few different UV sizes (full texture, atlas frames), so a linear search is fine
+	for (const QuadMesh& quadMesh : quadMeshes)
+	{
+		if (quadMesh.uvWidth == uvWidth && quadMesh.uvHeight == uvHeight)
+			return quadMesh.mesh;
+	}
+
+	// Same layout as MeshGenerator::GetRectMesh
+	AEGfxMeshStart();
+	AEGfxTriAdd(
+		-0.5f, -0.5f, 0xFFFFFFFF, 0.f, uvHeight,
+		0.5f, -0.5f, 0xFFFFFFFF, uvWidth, uvHeight,
+		-0.5f, 0.5f, 0xFFFFFFFF, 0.f, 0.f
+	);
+	AEGfxTriAdd(
+		0.5f, -0.5f, 0xFFFFFFFF, uvWidth, uvHeight,
+		0.5f, 0.5f, 0xFFFFFFFF, uvWidth, 0.f,
+		-0.5f, 0.5f, 0xFFFFFFFF, 0.f, 0.f
+	);
+	AEGfxVertexList* mesh = AEGfxMeshEnd();
+
+	quadMeshes.push_back(QuadMesh{ uvWidth, uvHeight, mesh });
+	return mesh;
+}
+
+void Renderer::RecordingBackend::SubmitBatch(const Batch& batch)
+{
+	batches.push_back(RecordedBatch{ batch.texture, batch.blendMode, batch.count });
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <vector>
+
+#include "AEEngine.h"
+
+/**
+ * @brief	Batched quad renderer.
+ *			Instead of AEGfxSetTransform + AEGfxMeshDraw for every quad, Submit() records a draw command.
+ *			Flush() sorts the commands by texture / blend mode and sends each group to the backend
+ *			as 1 batch. The default backend merges a big batch into 1 mesh, so 1 draw call per batch.
+ *
+ *			Sorting only happens within a Flush(), so call Flush() at the end of anything that has to be
+ *			drawn on top of / below something else (e.g. end of MapGrid::Render).
+ *			Commands with the same texture and blend mode keep their order, and a quad is never moved
+ *			below an earlier quad with a different texture / blend mode that it overlaps.
+ *
+ *			Backends can be swapped (SetBackend) to count batches without drawing, e.g. in the headless build.
+ *
+ * @note	The tint is stored as the vertex color, same as the color passed to AEGfxTriAdd.
+ */
+class Renderer
+{
+public:
+	struct DrawCommand
+	{
+		AEGfxTexture* texture = nullptr;	// nullptr: color only (AE_GFX_RM_COLOR)
+		AEMtx33 transform;					// Unit quad (-0.5 to 0.5) to screen, same as what is passed to AEGfxSetTransform
+		u32 color = 0xFFFFFFFF;				// ARGB tint. Alpha includes transparency
+		f32 u0 = 0.f, v0 = 0.f;				// Top left UV
+		f32 u1 = 1.f, v1 = 1.f;				// Bottom right UV
+		AEGfxBlendMode blendMode = AE_GFX_BM_BLEND;
+	};
+
+	// Commands with the same texture and blend mode, drawn together
+	struct Batch
+	{
+		AEGfxTexture* texture;
+		AEGfxBlendMode blendMode;
+		const DrawCommand* commands;
+		u32 count;
+	};
+
+	class Backend
+	{
+	public:
+		virtual ~Backend() = default;
+		virtual void SubmitBatch(const Batch& batch) = 0;
+	};
+
+	/**
+	 * @brief	Default backend. Draws the batch with AlphaEngine.
+	 *			AlphaEngine can't update a mesh, so merging means building and freeing a mesh every time.
+	 *			That only pays off for big batches (e.g. particles). Small batches draw each quad with a
+	 *			cached unit quad mesh instead, like Sprite used to.
+	 */
+	class AEBackend : public Backend
+	{
+	public:
+		// Batches with up to this many quads are drawn quad by quad
+		static constexpr u32 MAX_QUAD_BY_QUAD_COUNT = 4;
+
+		void SubmitBatch(const Batch& batch) override;
+
+		/**
+		 * @brief	Frees the cached quad meshes
+		 */
+		void Free();
+
+	private:
+		// Unit quad with UVs from (0, 0) to (uvWidth, uvHeight). Moved with the texture offset
+		struct QuadMesh
+		{
+			f32 uvWidth;
+			f32 uvHeight;
+			AEGfxVertexList* mesh;
+		};
+
+		void DrawQuads(const Batch& batch);
+		void DrawMergedMesh(const Batch& batch);
+		AEGfxVertexList* GetQuadMesh(f32 uvWidth, f32 uvHeight);
+
+		std::vector<QuadMesh> quadMeshes;
+	};
+
+	/**
+	 * @brief	Doesn't draw anything, only keeps the batches submitted since Clear().
+	 *			For measuring batch counts / sort cost without a GPU.
+	 */
+	class RecordingBackend : public Backend
+	{
+	public:
+		struct RecordedBatch
+		{
+			AEGfxTexture* texture;
+			AEGfxBlendMode blendMode;
+			u32 count;
+		};
+
+		void SubmitBatch(const Batch& batch) override;
+		void Clear() { batches.clear(); }
+		const std::vector<RecordedBatch>& GetBatches() const { return batches; }
+
+	private:
+		std::vector<RecordedBatch> batches;
+	};
+
+	struct Stats
+	{
+		u64 commands = 0;
+		u64 batches = 0;	// Same as draw calls with AEBackend
+		u64 flushes = 0;
+		f64 sortSeconds = 0.0;
+	};
+
+	static void Submit(const DrawCommand& command);
+
+	/**
+	 * @brief	Submits a texture quad. Same as AEGfxTextureSet(texture, 0, 0) + AEGfxSetTransform + AEGfxMeshDraw(unit quad)
+	 */
+	static void SubmitQuad(AEGfxTexture* texture, const AEMtx33& transform, u32 color = 0xFFFFFFFF);
+
+	/**
+	 * @brief	Sorts and draws everything submitted since the last flush
+	 */
+	static void Flush();
+
+	/**
+	 * @brief	Resets the frame stats. Call at the start of the frame
+	 */
+	static void BeginFrame();
+
+	/**
+	 * @param	backend	nullptr to use the AEBackend. Not owned
+	 */
+	static void SetBackend(Backend* backend);
+
+	/**
+	 * @brief	Frees the meshes cached by the AEBackend. Call before AESysExit
+	 */
+	static void Free();
+
+	static const Stats& GetFrameStats() { return frameStats; }
+	static const Stats& GetTotalStats() { return totalStats; }
+	static void ResetStats();
+
+	// Converts a color in [0, 1] to ARGB
+	static u32 ToColor(f32 r, f32 g, f32 b, f32 a);
+
+private:
+	// Commands with the same texture and blend mode, in sortedCommands[start, start + count)
+	struct Group
+	{
+		AEGfxTexture* texture;
+		AEGfxBlendMode blendMode;
+		u32 start;
+		u32 count;
+		f32 minX, minY, maxX, maxY;	// Bounding box of the commands in the group
+	};
+
+	static std::vector<DrawCommand> commands;		// In submit order
+	static std::vector<DrawCommand> sortedCommands;	// Grouped by texture / blend mode
+	static std::vector<u32> groupOfCommand;			// Index into groups for each command
+	static std::vector<Group> groups;
+
+	static AEBackend aeBackend;
+	static Backend* backend;
+
+	static Stats frameStats;
+	static Stats totalStats;
+
+	// Disable creating an instance. Static class
+	Renderer() = delete;
+};
@@ -0,0 +1,154 @@
+#include "ResourceCache.h"
+
+#include <iostream>
+
+#include "TextureAtlas.h"
+
+std::unordered_map<std::string, ResourceCache::TextureEntry> ResourceCache::textures;
+std::unordered_map<AEGfxTexture*, std::string> ResourceCache::texturePaths;
+std::unordered_map<std::string, std::unique_ptr<ResourceCache::SpriteSheet>> ResourceCache::spriteSheets;
+
+ResourceCache::Stats ResourceCache::textureStats;
+ResourceCache::Stats ResourceCache::spriteSheetStats;
+
+AEGfxTexture* ResourceCache::AcquireTexture(const std::string& file)
+{
+	auto it = textures.find(file);
+	if (it != textures.end())
+	{
+		++textureStats.hits;
+		++it->second.refCount;
+		return it->second.texture;
+	}
+
+	++textureStats.misses;
+	AEGfxTexture* texture = AEGfxTextureLoad(file.c_str());
+	if (!texture)
+	{
+		std::cout << "[ResourceCache] Failed to load texture: " << file << "\n";
+		return nullptr;
+	}
+
+	textures.emplace(file, TextureEntry{ texture, 1 });
+	texturePaths.emplace(texture, file);
+	return texture;
+}
+
+void ResourceCache::ReleaseTexture(AEGfxTexture* texture)
+{
+	if (!texture)
+		return;
+
+	auto pathIt = texturePaths.find(texture);
+	if (pathIt == texturePaths.end())
+	{
+		std::cout << "[ResourceCache] Releasing texture that isn't from the cache\n";
+		return;
+	}
+
+	TextureEntry& entry = textures.at(pathIt->second);
+	if (entry.refCount > 0)
+		--entry.refCount;
+}
+
+ResourceCache::SpriteSheet& ResourceCache::AcquireSpriteSheet(const std::string& file)
+{
+	auto it = spriteSheets.find(file);
+	if (it != spriteSheets.end())
+	{
+		++spriteSheetStats.hits;
+		++it->second->refCount;
+		return *it->second;
+	}
+
+	++spriteSheetStats.misses;
+	auto sheet = std::make_unique<SpriteSheet>(file);
+
+	// Texture is shared with the other textures, the sheet might be packed in an atlas
+	const TextureAtlas::Region region = TextureAtlas::Acquire(file);
+	sheet->texture = region.texture;
+	sheet->uvOrigin = AEVec2{ region.u0, region.v0 };
+	sheet->frameUVSize = AEVec2{ region.GetUVWidth() / sheet->metadata.cols, region.GetUVHeight() / sheet->metadata.rows };
+	sheet->refCount = 1;
+
+	if (!sheet->texture)
+		std::cout << "[ResourceCache] Failed to load sprite sheet: " << file << "\n";
+
+	return *spriteSheets.emplace(file, std::move(sheet)).first->second;
+}
+
+void ResourceCache::ReleaseSpriteSheet(SpriteSheet& sheet)
+{
+	if (sheet.refCount > 0)
+		--sheet.refCount;
+}
+
+void ResourceCache::FreeUnused()
+{
+	// Sheets first, they hold a reference to their texture
+	for (auto it = spriteSheets.begin(); it != spriteSheets.end();)
+	{
+		if (it->second->refCount > 0)
+		{
+			++it;
+			continue;
+		}
+
+		FreeSpriteSheet(*it->second);
+		it = spriteSheets.erase(it);
+		++spriteSheetStats.freed;
+	}
+
+	for (auto it = textures.begin(); it != textures.end();)
+	{
+		if (it->second.refCount > 0)
+		{
+			++it;
+			continue;
+		}
+
+		AEGfxTextureUnload(it->second.texture);
+		texturePaths.erase(it->second.texture);
+		it = textures.erase(it);
+		++textureStats.freed;
+	}
+}
+
+void ResourceCache::Clear()
+{
+	// Sheets first, they hold a reference to their texture
+	for (auto& [path, sheet] : spriteSheets)
+	{
+		if (sheet->refCount > 0)
+			std::cout << "[ResourceCache] Sprite sheet still in use when cleared: " << path << "\n";
+
+		FreeSpriteSheet(*sheet);
+		++spriteSheetStats.freed;
+	}
+	spriteSheets.clear();
+
+	for (auto& [path, entry] : textures)
+	{
+		if (entry.refCount > 0)
+			std::cout << "[ResourceCache] Texture still in use when cleared: " << path << "\n";
+
+		AEGfxTextureUnload(entry.texture);
+		++textureStats.freed;
+	}
+	textures.clear();
+	texturePaths.clear();
+}
+
+void ResourceCache::ResetStats()
+{
+	textureStats = {};
+	spriteSheetStats = {};
+}
+
+void ResourceCache::FreeSpriteSheet(SpriteSheet& sheet)
+{
+	if (sheet.texture)
+		ResourceCache::ReleaseTexture(sheet.texture);
+
+	sheet.texture = nullptr;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "AEEngine.h"
+#include "SpriteMetadata.h"
+
+/**
+ * @brief	Loads textures / sprite sheets once and shares them by path.
+ *			Each Acquire adds a reference and must be matched with a Release.
+ *			Unreferenced resources stay loaded so spawning the same sprite again is just a lookup,
+ *			they're only freed in FreeUnused (called by the GSM when changing scenes).
+ */
+class ResourceCache
+{
+public:
+	/**
+	 * @brief	Everything a Sprite needs that's the same for every instance of a file
+	 */
+	struct SpriteSheet
+	{
+		SpriteMetadata metadata;
+		AEGfxTexture* texture = nullptr;
+		AEVec2 uvOrigin{ 0.f, 0.f };		// Top left of the sheet in the texture, not 0 if it's packed in an atlas
+		AEVec2 frameUVSize{ 1.f, 1.f };		// UV size of 1 frame
+		int refCount = 0;
+
+		explicit SpriteSheet(const std::string& file) : metadata(file) {}
+	};
+
+	struct Stats
+	{
+		u32 hits = 0;			// Acquire found the resource loaded
+		u32 misses = 0;			// Acquire loaded the resource
+		u32 freed = 0;			// Resources freed by FreeUnused / Clear
+	};
+
+	/**
+	 * @brief	Gets a texture, loading it if it isn't loaded.
+	 * @return	Same as AEGfxTextureLoad, null if it failed to load
+	 */
+	static AEGfxTexture* AcquireTexture(const std::string& file);
+	static void ReleaseTexture(AEGfxTexture* texture);
+
+	/**
+	 * @brief	Gets the texture and parsed .meta file of a sprite sheet, loading it if it isn't loaded.
+	 *			Reference is valid until the sheet is released and freed.
+	 */
+	static SpriteSheet& AcquireSpriteSheet(const std::string& file);
+	static void ReleaseSpriteSheet(SpriteSheet& sheet);
+
+	/**
+	 * @brief	Frees everything that isn't referenced
+	 */
+	static void FreeUnused();
+
+	/**
+	 * @brief	Frees everything. Call before AlphaEngine exits.
+	 */
+	static void Clear();
+
+	static const Stats& GetTextureStats() { return textureStats; }
+	static const Stats& GetSpriteSheetStats() { return spriteSheetStats; }
+	static void ResetStats();
+
+	static size_t GetTextureCount() { return textures.size(); }
+	static size_t GetSpriteSheetCount() { return spriteSheets.size(); }
+
+private:
+	struct TextureEntry
+	{
+		AEGfxTexture* texture = nullptr;
+		int refCount = 0;
+	};
+
+	static void FreeSpriteSheet(SpriteSheet& sheet);
+
+	static std::unordered_map<std::string, TextureEntry> textures;
+	// Look up by texture when releasing
+	static std::unordered_map<AEGfxTexture*, std::string> texturePaths;
+	// unique_ptr so references stay valid when the map rehashes
+	static std::unordered_map<std::string, std::unique_ptr<SpriteSheet>> spriteSheets;
+
+	static Stats textureStats;
+	static Stats spriteSheetStats;
+
+	// Disable creating an instance. Static class
+	ResourceCache() = delete;
+};
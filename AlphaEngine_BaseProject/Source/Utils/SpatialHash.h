@@ -0,0 +1,210 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "AEEngine.h"
+#include "PhysicsUtils.h"
+
+/**
+ * @brief	Broadphase for moving objects. Uniform grid of square cells (aligned to MapGrid cells),
+ *			hashed into a fixed number of buckets so the world size doesn't matter.
+ *
+ *			Usage every frame (or whenever the objects move):
+ *			1. Clear()
+ *			2. Insert() each object with its box
+ *			3. Build()
+ *			4. QueryBox() / QueryRadius()
+ *
+ *			Queries only test the objects in the cells the query covers,
+ *			so the cost depends on how many objects are nearby instead of the total count.
+ *			Results are given in insertion order, same as looping over the objects directly.
+ *
+ * @tparam	T	Stored per object, passed to the query callback. Keep it small (pointer / index)
+ * @note	Queries can't be nested on the same SpatialHash (shares the scratch buffers)
+ */
+template <typename T>
+class SpatialHash
+{
+public:
+	/**
+	 * @param	cellSize	Size of a cell in world units (1 = 1 MapGrid tile)
+	 * @param	bucketCount	Rounded up to a power of 2
+	 */
+	explicit SpatialHash(float cellSize = 2.f, u32 bucketCount = 256) :
+		cellSize(cellSize),
+		invCellSize(1.f / cellSize)
+	{
+		u32 count = 1;
+		while (count < bucketCount)
+			count <<= 1;
+		bucketMask = count - 1;
+		bucketStart.assign((size_t)count + 1, 0);
+	}
+
+	void Clear()
+	{
+		items.clear();
+		isBuilt = false;
+	}
+
+	/**
+	 * @param	position	Center of the box
+	 * @param	size		Full width / height
+	 */
+	void Insert(const T& value, const AEVec2& position, const AEVec2& size)
+	{
+		items.push_back(Item{ value, position, size });
+		isBuilt = false;
+	}
+
+	/**
+	 * @brief	Sorts the inserted objects into the buckets. Call after inserting, before querying.
+	 */
+	void Build()
+	{
+		std::fill(bucketStart.begin(), bucketStart.end(), 0);
+
+		// Count how many objects go in each bucket
+		for (const Item& item : items)
+		{
+			ForEachBucket(item.position, item.size, [this](u32 bucket) {
+				++bucketStart[bucket + 1];
+			});
+		}
+
+		// Prefix sum, bucketStart[b] = first index of bucket b in bucketItems
+		for (size_t i = 1; i < bucketStart.size(); ++i)
+			bucketStart[i] += bucketStart[i - 1];
+
+		bucketItems.resize(bucketStart.back());
+		fillCursor.assign(bucketStart.begin(), bucketStart.end() - 1);
+		for (u32 i = 0; i < (u32)items.size(); ++i)
+		{
+			ForEachBucket(items[i].position, items[i].size, [this, i](u32 bucket) {
+				bucketItems[fillCursor[bucket]++] = i;
+			});
+		}
+
+		queryStamp.assign(items.size(), 0);
+		currentStamp = 0;
+		isBuilt = true;
+	}
+
+	/**
+	 * @brief	Calls fn(T& value) for every object overlapping the box
+	 */
+	template <typename Fn>
+	void QueryBox(const AEVec2& position, const AEVec2& size, Fn&& fn)
+	{
+		GatherCandidates(position, size);
+		for (u32 i : candidates)
+		{
+			if (PhysicsUtils::AABB(position, size, items[i].position, items[i].size))
+				fn(items[i].value);
+		}
+	}
+
+	/**
+	 * @brief	Calls fn(T& value) for every object whose box overlaps the circle
+	 */
+	template <typename Fn>
+	void QueryRadius(const AEVec2& center, float radius, Fn&& fn)
+	{
+		GatherCandidates(center, { radius * 2.f, radius * 2.f });
+		for (u32 i : candidates)
+		{
+			const Item& item = items[i];
+
+			// Closest point on the box to the center
+			const float closestX = AEClamp(center.x, item.position.x - item.size.x * 0.5f, item.position.x + item.size.x * 0.5f);
+			const float closestY = AEClamp(center.y, item.position.y - item.size.y * 0.5f, item.position.y + item.size.y * 0.5f);
+			const float dx = center.x - closestX, dy = center.y - closestY;
+			if (dx * dx + dy * dy <= radius * radius)
+				fn(items[i].value);
+		}
+	}
+
+	size_t Size() const { return items.size(); }
+	bool IsBuilt() const { return isBuilt; }
+	float GetCellSize() const { return cellSize; }
+
+private:
+	struct Item
+	{
+		T value;
+		AEVec2 position;
+		AEVec2 size;
+	};
+
+	int ToCell(float v) const { return (int)std::floor(v * invCellSize); }
+
+	u32 HashCell(int x, int y) const
+	{
+		return ((u32)x * 73856093u ^ (u32)y * 19349663u) & bucketMask;
+	}
+
+	template <typename Fn>
+	void ForEachBucket(const AEVec2& position, const AEVec2& size, Fn&& fn) const
+	{
+		const int minX = ToCell(position.x - size.x * 0.5f), maxX = ToCell(position.x + size.x * 0.5f);
+		const int minY = ToCell(position.y - size.y * 0.5f), maxY = ToCell(position.y + size.y * 0.5f);
+
+		// Covers more cells than there are buckets, every bucket once is enough
+		if ((s64)(maxX - minX + 1) * (s64)(maxY - minY + 1) > (s64)bucketMask)
+		{
+			for (u32 bucket = 0; bucket <= bucketMask; ++bucket)
+				fn(bucket);
+			return;
+		}
+
+		for (int y = minY; y <= maxY; ++y)
+			for (int x = minX; x <= maxX; ++x)
+				fn(HashCell(x, y));
+	}
+
+	// Fills candidates with the unique objects in the buckets the box covers, sorted by insertion order
+	void GatherCandidates(const AEVec2& position, const AEVec2& size)
+	{
+		candidates.clear();
+		if (!isBuilt)
+			Build();
+
+		// New stamp instead of clearing queryStamp every query
+		if (++currentStamp == 0)
+		{
+			std::fill(queryStamp.begin(), queryStamp.end(), 0);
+			currentStamp = 1;
+		}
+
+		ForEachBucket(position, size, [this](u32 bucket) {
+			for (u32 j = bucketStart[bucket]; j < bucketStart[bucket + 1]; ++j)
+			{
+				const u32 i = bucketItems[j];
+				if (queryStamp[i] == currentStamp)
+					continue;
+
+				queryStamp[i] = currentStamp;
+				candidates.push_back(i);
+			}
+		});
+
+		std::sort(candidates.begin(), candidates.end());
+	}
+
+	float cellSize;
+	float invCellSize;
+	u32 bucketMask;
+
+	std::vector<Item> items;
+	std::vector<u32> bucketStart;	// bucketCount + 1, range of each bucket in bucketItems
+	std::vector<u32> bucketItems;	// Item indices, grouped by bucket
+	std::vector<u32> fillCursor;	// Only used in Build
+
+	// Query scratch
+	std::vector<u32> queryStamp;
+	std::vector<u32> candidates;
+	u32 currentStamp = 0;
+
+	bool isBuilt = false;
+};
@@ -1,105 +1,50 @@
-#include <iostream>
-
 #include "Sprite.h"
-#include "MeshGenerator.h"
-#include "../Game/Time.h"
+
+#include "Renderer.h"
 
 Sprite::Sprite(std::string file) 
-	: uvOffset(0.f, 0.f), metadata(file)
+	: sheet(ResourceCache::AcquireSpriteSheet(file)), metadata(sheet.metadata), animator(Animator::Create(sheet))
 {
-	uvWidth = 1.f / metadata.cols;
-	uvHeight = 1.f / metadata.rows;
-
-	ifLockCurrent = false;
-	animTimer = 0.f;
-	currStateIndex = nextStateIndex = 0;
-	frameIndex = 0;
-
-	mesh = MeshGenerator::GetRectMesh(1.f, 1.f, uvWidth, uvHeight);
-	texture = AEGfxTextureLoad(file.c_str());
 }
 
 Sprite::~Sprite()
 {
-	AEGfxMeshFree(mesh);
-	AEGfxTextureUnload(texture);
+	Animator::Destroy(animator);
+	ResourceCache::ReleaseSpriteSheet(sheet);
 }
 
 void Sprite::Update()
 {
-	const auto& currState = metadata.stateInfoRows[currStateIndex];
-	if (animTimer >= currState.timePerFrame)
-	{
-		animTimer -= currState.timePerFrame;
-
-		bool onLastFrame = frameIndex == (currState.frameCount - 1);
-
-		// If should change state
-		if (currStateIndex != nextStateIndex && 
-			(!ifLockCurrent || onLastFrame))
-		{
-			animTimer = 0;
-			frameIndex = 0;
-			currStateIndex = nextStateIndex;
-			ifLockCurrent = false;
-		}
-		// Else update current animation
-		// - if ifLoop, keep repeating
-		// - else, play until it's not the last frame
-		else if (currState.ifLoop || frameIndex != currState.frameCount - 1)
-			frameIndex = (frameIndex + 1) % currState.frameCount;
-		
-		uvOffset.x = frameIndex * uvWidth;
-		uvOffset.y = currStateIndex * uvHeight;
-
-		if (onLastFrame && onAnimEnd)
-		{
-			onAnimEnd(currStateIndex);
-		}
-	}
-
-	animTimer += static_cast<float>(Time::GetInstance().GetScaledDeltaTime());
+	Animator::Play(animator);
 }
 
-void Sprite::Render()
+void Sprite::Render(const AEMtx33& transform, u32 color, AEGfxBlendMode blendMode)
 {
-	AEGfxTextureSet(texture, uvOffset.x, uvOffset.y);
-	AEGfxMeshDraw(mesh, AE_GFX_MDM_TRIANGLES);
-	//AEGfxMeshDraw(mesh, AE_GFX_MDM_LINES_STRIP);
-	//AEGfxTextureSet(nullptr, 0, 0); // Reset
+	const AEVec2 uvOffset = Animator::GetUVOffset(animator);
+
+	Renderer::DrawCommand command;
+	command.texture = sheet.texture;
+	command.transform = transform;
+	command.color = color;
+	command.u0 = sheet.uvOrigin.x + uvOffset.x;
+	command.v0 = sheet.uvOrigin.y + uvOffset.y;
+	command.u1 = command.u0 + sheet.frameUVSize.x;
+	command.v1 = command.v0 + sheet.frameUVSize.y;
+	command.blendMode = blendMode;
+	Renderer::Submit(command);
 }
 
 int Sprite::GetState() const
 {
-	return currStateIndex;
+	return Animator::GetState(animator);
 }
 
-void Sprite::SetState(int nextState, bool ifLock, std::function<void(int)> _onAnimEnd)
+void Sprite::Restart(int state)
 {
-	if (nextState == currStateIndex)
-		return;
-
-	if (nextState < 0 || nextState > metadata.rows)
-	{
-		std::cout << "[ERROR] Invalid sprite state" << std::endl;
-		return;
-	}
-
-	this->nextStateIndex = nextState;
-	
-	if (ifLockCurrent)
-		return;
-
-	//std::cout << "Set state: " << nextState << "\n";
-	
-	this->ifLockCurrent = ifLock;
-
-	this->onAnimEnd = _onAnimEnd;
-
-	animTimer = 0;
-	currStateIndex = nextState;
-	frameIndex = 0;
+	Animator::Restart(animator, state);
+}
 
-	uvOffset.x = frameIndex * uvWidth;
-	uvOffset.y = currStateIndex * uvHeight;
+void Sprite::SetState(int nextState, bool ifLock, bool notifyAnimEnd)
+{
+	Animator::SetState(animator, nextState, ifLock, notifyAnimEnd);
 }
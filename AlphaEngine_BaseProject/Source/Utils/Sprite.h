@@ -2,62 +2,52 @@
 
 #include "AEEngine.h"
 #include <string>
-#include <functional>
 #include "SpriteMetadata.h"
+#include "ResourceCache.h"
+#include "Animator.h"
 
 class Sprite
 {
+	/**
+	 * @brief	Texture and metadata shared with every Sprite using the same file.
+	 *			Declared first as metadata references it.
+	 */
+	ResourceCache::SpriteSheet& sheet;
+
 public:
 	Sprite(std::string file);
 	~Sprite();
 
+	Sprite(const Sprite&) = delete;
+	Sprite& operator=(const Sprite&) = delete;
+
 	/**
-	 * @brief Update sprite animation
+	 * @brief	Plays the animation this tick. The step itself is done in Animator::Update with every other sprite.
+	 *			Not calling it pauses the animation.
 	 */
 	void Update();
 
 	/**
-	 * @brief	Sets the Texture and Draw.
-	 * @warning DOES NOT set the transform. Only sets the texture and Draw. 
-	 *			Set the transform before calling this
+	 * @brief	Submits the current frame to the Renderer. Drawn at the next Renderer::Flush,
+	 *			batched with the other sprites of the same sheet.
+	 * @param transform		Unit quad to screen, same as what used to be passed to AEGfxSetTransform
+	 * @param color			ARGB tint. Alpha is the transparency
 	 */
-	void Render();
+	void Render(const AEMtx33& transform, u32 color = 0xFFFFFFFF, AEGfxBlendMode blendMode = AE_GFX_BM_BLEND);
 
 	int GetState() const;
-	void SetState(int nextState, bool ifLock = false, std::function<void(int)> _onAnimEnd = {});
-	const SpriteMetadata metadata;
-private:
-
-	// === Data derived from metadata ===
-	float uvWidth, uvHeight;
-
-	// === Runtime data that will change ===
-	float animTimer;
 	/**
-	 * @brief Current state the animation is in. Row index in spritesheet
+	 * @param ifLock			Lock the new state until its last frame
+	 * @param notifyAnimEnd		Add an Animator::AnimEndEvent for this sprite every step the state is on its last frame.
+	 *							Read them with IsAnimEndEvent in the next update
 	 */
-	int currStateIndex;
+	void SetState(int nextState, bool ifLock = false, bool notifyAnimEnd = false);
 	/**
-	 * @brief Next state the animation is in. Row index in spritesheet
+	 * @brief	Plays the state from the first frame, even if the current state is locked. For reusing a sprite
 	 */
-	int nextStateIndex;
-
-	/**
-	 * @brief Current frame the animation is in. Column index in spritesheet
-	 */
-	int frameIndex;
-
-	/**
-	 * @brief Lock current frame until it finishes
-	 */
-	bool ifLockCurrent;
-	
-	AEVec2 uvOffset; // Current uv offset
-
-	std::function<void(int)> onAnimEnd;
-
-	// === Mesh data ===
-	AEGfxVertexList* mesh;
-	AEGfxTexture* texture;
+	void Restart(int state = 0);
+	bool IsAnimEndEvent(const Animator::AnimEndEvent& animEndEvent) const { return animEndEvent.animator == animator; }
+	const SpriteMetadata& metadata;
+private:
+	Animator::Handle animator;
 };
-
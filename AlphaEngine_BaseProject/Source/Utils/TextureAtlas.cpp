@@ -0,0 +1,87 @@
+#include "TextureAtlas.h"
+
+#include <filesystem>
+#include <iostream>
+
+#include "FileHelper.h"
+#include "ResourceCache.h"
+
+std::unordered_map<std::string, TextureAtlas::Entry> TextureAtlas::entries;
+bool TextureAtlas::isLoaded = false;
+
+TextureAtlas::Region TextureAtlas::Acquire(const std::string& file)
+{
+	if (!isLoaded)
+		LoadLookupTables();
+
+	Region region;
+	auto it = entries.find(file);
+	if (it == entries.end())
+	{
+		region.texture = ResourceCache::AcquireTexture(file);
+		return region;
+	}
+
+	const Entry& entry = it->second;
+	region.texture = ResourceCache::AcquireTexture(entry.texture);
+	region.u0 = entry.u0;
+	region.v0 = entry.v0;
+	region.u1 = entry.u1;
+	region.v1 = entry.v1;
+	return region;
+}
+
+void TextureAtlas::Release(const Region& region)
+{
+	ResourceCache::ReleaseTexture(region.texture);
+}
+
+bool TextureAtlas::IsPacked(const std::string& file)
+{
+	if (!isLoaded)
+		LoadLookupTables();
+
+	return entries.find(file) != entries.end();
+}
+
+void TextureAtlas::LoadLookupTables(const std::string& folder)
+{
+	namespace fs = std::filesystem;
+
+	isLoaded = true;
+	entries.clear();
+
+	std::error_code error;
+	for (const fs::directory_entry& entry : fs::directory_iterator(folder, error))
+	{
+		const std::string name = entry.path().filename().string();
+		if (entry.is_regular_file() && name.ends_with(".uv.json"))
+			LoadLookupTable(entry.path().generic_string());
+	}
+}
+
+void TextureAtlas::LoadLookupTable(const std::string& file)
+{
+	rapidjson::Document document;
+	if (!FileHelper::TryReadJsonFile(file, document) || !document.IsObject() ||
+		!document.HasMember("texture") || !document.HasMember("regions"))
+	{
+		std::cout << "[TextureAtlas] Invalid lookup table: " << file << "\n";
+		return;
+	}
+
+	// Use the separate textures if the atlas wasn't built
+	const std::string texture = document["texture"].GetString();
+	std::error_code error;
+	if (!std::filesystem::exists(texture, error))
+		return;
+
+	for (const auto& region : document["regions"].GetArray())
+	{
+		entries[region["name"].GetString()] = Entry{
+			texture,
+			region["u0"].GetFloat(), region["v0"].GetFloat(),
+			region["u1"].GetFloat(), region["v1"].GetFloat()
+		};
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+
+#include "AEEngine.h"
+
+/**
+ * @brief	Looks up textures packed into atlases by the AtlasBuilder tool.
+ *			Acquire by the original file path, e.g. "Assets/Tmp/spikes.png". If the file is packed,
+ *			the region is the atlas texture + the UVs of the image in it. If not (or the atlas wasn't built),
+ *			it's the file's own texture with the full UVs, so callers don't need to care which one it is.
+ *
+ *			Lookup tables (Assets/Atlases/<name>.uv.json) are read on the first Acquire.
+ *			Textures are shared through ResourceCache.
+ */
+class TextureAtlas
+{
+public:
+	struct Region
+	{
+		AEGfxTexture* texture = nullptr;
+		f32 u0 = 0.f, v0 = 0.f;	// Top left UV
+		f32 u1 = 1.f, v1 = 1.f;	// Bottom right UV
+
+		f32 GetUVWidth() const { return u1 - u0; }
+		f32 GetUVHeight() const { return v1 - v0; }
+	};
+
+	/**
+	 * @brief	Gets the region of an image, loading the texture if it isn't loaded.
+	 *			Must be matched with a Release.
+	 * @return	Region with a null texture if it failed to load
+	 */
+	static Region Acquire(const std::string& file);
+	static void Release(const Region& region);
+
+	/**
+	 * @return	If the file is in one of the atlases
+	 */
+	static bool IsPacked(const std::string& file);
+
+	/**
+	 * @brief	Reads every lookup table in the folder. Tables whose atlas texture is missing are skipped
+	 */
+	static void LoadLookupTables(const std::string& folder = "Assets/Atlases");
+
+private:
+	struct Entry
+	{
+		std::string texture;	// Atlas texture path
+		f32 u0, v0, u1, v1;
+	};
+
+	static void LoadLookupTable(const std::string& file);
+
+	// Original file path -> where it is in the atlas
+	static std::unordered_map<std::string, Entry> entries;
+	static bool isLoaded;
+
+	// Disable creating an instance. Static class
+	TextureAtlas() = delete;
+};